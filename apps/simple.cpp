@@ -1,9 +1,12 @@
+#include "AutoSimulator.hpp"
 #include "CircuitSimulator.hpp"
 #include "GroverSimulator.hpp"
 #include "HybridSchrodingerFeynmanSimulator.hpp"
 #include "ShorFastSimulator.hpp"
 #include "ShorSimulator.hpp"
 #include "Simulator.hpp"
+#include "StateVectorSimulator.hpp"
+#include "StreamingSimulator.hpp"
 #include "algorithms/Entanglement.hpp"
 #include "algorithms/Grover.hpp"
 #include "algorithms/QFT.hpp"
@@ -12,10 +15,13 @@
 #include "nlohmann/json.hpp"
 
 #include <chrono>
+#include <complex>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 namespace nl = nlohmann;
 
@@ -33,14 +39,32 @@ int main(int argc, char** argv) {
         ("dump_complex", "dump edge weights in final state DD to file", cxxopts::value<std::string>())
         ("verbose", "Causes some simulators to print additional information to STDERR")
         ("simulate_file", "simulate a quantum circuit given by file (detection by the file extension)", cxxopts::value<std::string>())
+        ("auto", "simulate the file given by simulate_file with the engine that is predicted to be fastest")
+        ("stream_chunk", "simulate the OpenQASM file given by simulate_file while parsing it in chunks of this many statements (0 = parse the whole circuit first)", cxxopts::value<std::size_t>()->default_value("0"))
         ("simulate_file_hybrid", "simulate a quantum circuit given by file (detection by the file extension) using the hybrid Schrodinger-Feynman simulator", cxxopts::value<std::string>())
         ("hybrid_mode", "mode used for hybrid Schrodinger-Feynman simulation (*amplitude*, dd)", cxxopts::value<std::string>())
-        ("nthreads", "#threads used for hybrid simulation", cxxopts::value<unsigned int>()->default_value("2"))
+        ("simulate_file_dense", "simulate a quantum circuit given by file (detection by the file extension) using the dense state vector simulator", cxxopts::value<std::string>())
+        ("nthreads", "#threads used for hybrid and dense simulation", cxxopts::value<unsigned int>()->default_value("2"))
+        ("initial_state", "start from this product state given by one of 0, 1, +, -, r, l per qubit (qubit n-1 first)", cxxopts::value<std::string>())
+        ("initial_amplitudes", "start from the state given by a file with one amplitude ('real imag') per line", cxxopts::value<std::string>())
         ("simulate_qft", "simulate Quantum Fourier Transform for given number of qubits", cxxopts::value<unsigned int>())
         ("simulate_ghz", "simulate state preparation of GHZ state for given number of qubits", cxxopts::value<unsigned int>())
         ("step_fidelity", "target fidelity for each approximation run (>=1 = disable approximation)", cxxopts::value<double>()->default_value("1.0"))
         ("steps", "number of approximation steps", cxxopts::value<unsigned int>()->default_value("1"))
+        ("deadline", "approximate the state whenever the simulation is projected to take longer than this many seconds (0 = no deadline)", cxxopts::value<double>()->default_value("0"))
         ("approx_when", "approximation method ('fidelity' (default) or 'memory'", cxxopts::value<std::string>()->default_value("fidelity"))
+        ("gc_mode", "when to collect garbage ('default', 'every', 'dead_ratio', 'memory' or 'measurements')", cxxopts::value<std::string>()->default_value("default"))
+        ("gc_every", "number of operations between garbage collections (for gc_mode 'every')", cxxopts::value<std::size_t>()->default_value("1"))
+        ("gc_threshold", "fraction of dead nodes (for gc_mode 'dead_ratio') or growth of the memory in MiB since the last collection (for gc_mode 'memory') that triggers a garbage collection", cxxopts::value<double>()->default_value("0.5"))
+        ("lightcone", "remove all operations outside the backward lightcone of the measured qubits before simulation")
+        ("eliminate_idle_qubits", "simulate only the qubits that are acted upon by the circuit")
+        ("factorize", "keep unentangled groups of qubits in separate DDs")
+        ("reorder_qubits", "simulate with a qubit order derived from the interaction graph of the circuit")
+        ("dense_ratio", "continue on a dense state vector once the DD has more than this fraction of 2^n nodes (0 = never)", cxxopts::value<double>()->default_value("0"))
+        ("stabilizer_prefix", "simulate the leading Clifford gates with a stabilizer tableau")
+        ("sifting_growth", "sift the levels of the state DD whenever it grows by this factor (0 = disable dynamic reordering)", cxxopts::value<double>()->default_value("0"))
+        ("block_length", "apply runs of identical blocks of up to this many gates as powers of the block (0 = disable)", cxxopts::value<std::size_t>()->default_value("0"))
+        ("reversible_section", "apply sections of at least this many consecutive X/SWAP gates as one permutation (0 = disable)", cxxopts::value<std::size_t>()->default_value("0"))
         ("approx_state", "do excessive approximation runs at the end of the simulation to see how the quantum state behaves")
         ("simulate_grover", "simulate Grover's search for given number of qubits with random oracle", cxxopts::value<unsigned int>())
         ("simulate_grover_emulated", "simulate Grover's search for given number of qubits with random oracle and emulation", cxxopts::value<unsigned int>())
@@ -75,6 +99,10 @@ int main(int argc, char** argv) {
         throw std::runtime_error("Unknown approximation method '" + vm["approx_when"].as<std::string>() + "'.");
     }
 
+    GarbageCollectionInfo::CollectWhen gc_when{};
+    std::istringstream(vm["gc_mode"].as<std::string>()) >> gc_when;
+    const GarbageCollectionInfo gc_info(gc_when, vm["gc_every"].as<std::size_t>(), vm["gc_threshold"].as<double>());
+
     std::unique_ptr<qc::QuantumComputation> quantumComputation;
     std::unique_ptr<Simulator>              ddsim{nullptr};
     ApproximationInfo                       approx_info(step_fidelity, approx_steps, approx_when);
@@ -82,8 +110,15 @@ int main(int argc, char** argv) {
 
     if (vm.count("simulate_file")) {
         const std::string fname = vm["simulate_file"].as<std::string>();
-        quantumComputation      = std::make_unique<qc::QuantumComputation>(fname);
-        ddsim                   = std::make_unique<CircuitSimulator>(std::move(quantumComputation), approx_info, seed);
+        if (vm["stream_chunk"].as<std::size_t>() > 0) {
+            ddsim = std::make_unique<StreamingSimulator>(OperationStream::fromQasm(fname), seed, vm["stream_chunk"].as<std::size_t>());
+        } else if (vm.count("auto")) {
+            quantumComputation = std::make_unique<qc::QuantumComputation>(fname);
+            ddsim              = std::make_unique<AutoSimulator>(std::move(quantumComputation), seed, nthreads);
+        } else {
+            quantumComputation = std::make_unique<qc::QuantumComputation>(fname);
+            ddsim              = std::make_unique<CircuitSimulator>(std::move(quantumComputation), approx_info, seed);
+        }
     } else if (vm.count("simulate_file_hybrid")) {
         const std::string fname = vm["simulate_file_hybrid"].as<std::string>();
         quantumComputation      = std::make_unique<qc::QuantumComputation>(fname);
@@ -100,6 +135,10 @@ int main(int argc, char** argv) {
         } else {
             ddsim = std::make_unique<HybridSchrodingerFeynmanSimulator>(std::move(quantumComputation), mode, nthreads);
         }
+    } else if (vm.count("simulate_file_dense")) {
+        const std::string fname = vm["simulate_file_dense"].as<std::string>();
+        quantumComputation      = std::make_unique<qc::QuantumComputation>(fname);
+        ddsim                   = std::make_unique<StateVectorSimulator>(std::move(quantumComputation), seed, nthreads);
     } else if (vm.count("simulate_qft")) {
         const unsigned int n_qubits = vm["simulate_qft"].as<unsigned int>();
         quantumComputation          = std::make_unique<qc::QFT>(n_qubits);
@@ -140,6 +179,71 @@ int main(int argc, char** argv) {
         std::exit(1);
     }
 
+    if (auto* autoSim = dynamic_cast<AutoSimulator*>(ddsim.get())) {
+        // the remaining options are chosen by the automatic simulator
+        if (auto* circuitSim = dynamic_cast<CircuitSimulator*>(&autoSim->getEngine())) {
+            circuitSim->setGarbageCollectionInfo(gc_info);
+        }
+    }
+
+    if (auto* streamingSim = dynamic_cast<StreamingSimulator*>(ddsim.get())) {
+        streamingSim->setGarbageCollectionInfo(gc_info);
+    }
+
+    if (auto* hybridSim = dynamic_cast<HybridSchrodingerFeynmanSimulator*>(ddsim.get())) {
+        // the slices are simulated on their own, hence only the qubit order carries over from the circuit simulator
+        const bool unsupported = vm.count("lightcone") > 0 || vm.count("eliminate_idle_qubits") > 0 || vm.count("factorize") > 0 || vm.count("stabilizer_prefix") > 0 ||
+                                 vm["dense_ratio"].as<double>() > 0 || vm["sifting_growth"].as<double>() > 0 || vm["block_length"].as<std::size_t>() > 0 ||
+                                 vm["reversible_section"].as<std::size_t>() > 0 || vm["deadline"].as<double>() > 0;
+        if (unsupported) {
+            std::cerr << "The hybrid simulator only supports the option reorder_qubits of the circuit simulator.\n";
+            std::exit(1);
+        }
+        hybridSim->setQubitReordering(vm.count("reorder_qubits") > 0);
+    } else if (auto* circuitSim = dynamic_cast<CircuitSimulator*>(ddsim.get())) {
+        circuitSim->setGarbageCollectionInfo(gc_info);
+        if (vm.count("lightcone")) {
+            circuitSim->pruneToLightcone();
+        }
+        circuitSim->setIdleQubitElimination(vm.count("eliminate_idle_qubits") > 0);
+        circuitSim->setFactorization(vm.count("factorize") > 0);
+        circuitSim->setQubitReordering(vm.count("reorder_qubits") > 0);
+        circuitSim->setDenseSwitch(vm["dense_ratio"].as<double>());
+        circuitSim->setStabilizerPrefix(vm.count("stabilizer_prefix") > 0);
+        if (vm["sifting_growth"].as<double>() > 0) {
+            circuitSim->enableDynamicReordering(vm["sifting_growth"].as<double>());
+        }
+        if (vm["block_length"].as<std::size_t>() > 0) {
+            circuitSim->enableBlockExponentiation(vm["block_length"].as<std::size_t>());
+        }
+        circuitSim->setPermutationEmulation(vm["reversible_section"].as<std::size_t>());
+        if (vm["deadline"].as<double>() > 0) {
+            circuitSim->setDeadline(vm["deadline"].as<double>());
+        }
+    }
+
+    if (vm.count("initial_state")) {
+        ddsim->setInitialState(InitialState::fromBasisString(vm["initial_state"].as<std::string>()));
+    } else if (vm.count("initial_amplitudes")) {
+        std::ifstream ifs(vm["initial_amplitudes"].as<std::string>());
+        if (!ifs.good()) {
+            std::cerr << "Could not open amplitude file " << vm["initial_amplitudes"].as<std::string>() << "\n";
+            std::exit(1);
+        }
+        std::vector<std::complex<dd::fp>> amplitudes{};
+        std::string                       line;
+        while (std::getline(ifs, line)) {
+            std::istringstream iss(line);
+            dd::fp             real = 0;
+            dd::fp             imag = 0;
+            if (iss >> real) {
+                iss >> imag;
+                amplitudes.emplace_back(real, imag);
+            }
+        }
+        ddsim->setInitialState(InitialState::fromAmplitudes(std::move(amplitudes)));
+    }
+
     if (ddsim->getNumberOfQubits() > 100) {
         std::clog << "[WARNING] Quantum computation contains quite a few qubits. You're jumping into the deep end.\n";
     }
@@ -0,0 +1,80 @@
+#ifndef DDSIM_ADJOINTSIMULATOR_HPP
+#define DDSIM_ADJOINTSIMULATOR_HPP
+
+#include "CircuitSimulator.hpp"
+#include "QuantumComputation.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Computes the gradient of the expectation value <psi|H|psi> of a weighted sum H of Pauli strings with respect to the
+ * parameters of all RX, RY, RZ, phase, U2 and U3 gates (with any controls) by adjoint differentiation.
+ *
+ * After one forward pass, the final state |psi> and |phi> = H|psi> are propagated backwards through the inverse gates.
+ * The derivative for a gate U(theta) is 2 Re <phi|dU/dtheta|psi'>, where |psi'> is the state before the gate, so that all
+ * gradients cost about three simulations instead of two simulations per parameter (as for the parameter-shift rule).
+ * The circuit may only consist of standard operations and barriers; the options of CircuitSimulator are not used.
+ */
+class AdjointSimulator: public CircuitSimulator {
+public:
+    explicit AdjointSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_):
+        CircuitSimulator(std::move(qc_)) {}
+
+    AdjointSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_, const unsigned long long seed):
+        CircuitSimulator(std::move(qc_), seed) {}
+
+    /// derivative of the expectation value with respect to each parameter of the parameterized operations (in circuit
+    /// order, and in the order of Operation::getParameter for U2 and U3); the final state of the forward pass remains the
+    /// state of the simulator
+    std::vector<dd::fp> gradient(const std::vector<PauliTerm>& observable);
+
+    /// sets the parameters of the parameterized operations (in the order of the gradient), e.g., between the steps of an
+    /// optimizer
+    void setParameters(const std::vector<dd::fp>& values);
+
+    /// indices of the parameterized operations in the circuit, once per parameter (the operations the entries of the
+    /// gradient refer to)
+    [[nodiscard]] std::vector<std::size_t> getParameterizedOperations() const;
+
+    /// expectation value of the observable of the last gradient
+    [[nodiscard]] dd::fp getExpectationValue() const { return expectation; }
+
+    std::map<std::string, std::string> AdditionalStatistics() override {
+        auto statistics             = CircuitSimulator::AdditionalStatistics();
+        statistics["parameters"]    = std::to_string(parameters);
+        statistics["gradient_time"] = std::to_string(gradient_time);
+        return statistics;
+    }
+
+    [[nodiscard]] std::string getName() const override { return "adjoint_" + qc->getName(); };
+
+    static bool isParameterized(const qc::Operation& op) { return countParameters(op) > 0; }
+
+    /// number of parameters the gradient contains for the operation (1 for RX, RY, RZ and phase, 2 for U2, 3 for U3)
+    static std::size_t countParameters(const qc::Operation& op);
+
+private:
+    dd::fp      expectation{0.};
+    std::size_t parameters{0};
+    double      gradient_time{0.};
+    /// the (reference counted) final state of the last forward pass
+    qc::VectorDD final_state{};
+
+    /// derivative of the (single-target) gate matrix of a parameterized operation with respect to its given parameter
+    static dd::GateMatrix derivative(const qc::Operation& op, std::size_t parameter);
+
+    /// Re <phi|dU/dtheta|psi> for the given parameter theta of the parameterized operation U
+    dd::fp derivativeOverlap(const qc::Operation& op, std::size_t parameter, const qc::VectorDD& phi, const qc::VectorDD& psi);
+
+    /// returns the (reference counted) state H|psi>
+    qc::VectorDD applyObservable(const std::vector<PauliTerm>& observable, const qc::VectorDD& psi);
+
+    /// multiplies the reference counted state with the matrix, releases it and returns the reference counted result
+    qc::VectorDD apply(const qc::MatrixDD& m, const qc::VectorDD& state);
+};
+
+#endif //DDSIM_ADJOINTSIMULATOR_HPP
@@ -0,0 +1,79 @@
+#ifndef DDSIM_AUTOSIMULATOR_HPP
+#define DDSIM_AUTOSIMULATOR_HPP
+
+#include "EngineSelector.hpp"
+#include "QuantumComputation.hpp"
+#include "Simulator.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * Simulator dispatching to the engine EngineSelector predicts to be fastest for the circuit.
+ *
+ * The engine is created on construction (so that it can be configured via getEngine) and its final state is taken
+ * over after each simulation, i.e., the state can be accessed through this simulator. The hybrid simulator keeps the
+ * state as amplitude vector, which is only available if no shots were sampled from it. The hybrid and the path simulator
+ * sample all qubits, so their results are mapped onto the classical bits of the final measurements.
+ */
+class AutoSimulator: public Simulator {
+public:
+    explicit AutoSimulator(std::unique_ptr<qc::QuantumComputation>&& qc):
+        nthreads(2) {
+        initialize(std::move(qc));
+    }
+
+    AutoSimulator(std::unique_ptr<qc::QuantumComputation>&& qc, unsigned long long seed, std::size_t nthreads = 2):
+        Simulator(seed), nthreads(nthreads) {
+        initialize(std::move(qc));
+    }
+
+    std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
+
+    /// switches to the cheapest other engine if the hybrid or the path simulator was selected, which only start from |0...0>
+    void setInitialState(const InitialState& state) override;
+
+    /// replaces the predicted engine (which discards the configuration of the previous engine)
+    void setEngine(EngineSelector::Engine engine_);
+
+    std::map<std::string, std::string> AdditionalStatistics() override {
+        auto statistics = engine->AdditionalStatistics();
+        for (const auto& [stat, value]: EngineSelector::toStatistics(features, prediction)) {
+            statistics[stat] = value;
+        }
+        return statistics;
+    };
+
+    [[nodiscard]] Simulator&                        getEngine() { return *engine; }
+    [[nodiscard]] const EngineSelector::Features&   getFeatures() const { return features; }
+    [[nodiscard]] const EngineSelector::Prediction& getPrediction() const { return prediction; }
+
+    [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return engine->getNumberOfQubits(); };
+
+    [[nodiscard]] std::size_t getNumberOfOps() const override { return engine->getNumberOfOps(); };
+
+    [[nodiscard]] std::string getName() const override { return engine->getName(); };
+
+protected:
+    std::size_t nthreads;
+    /// the circuit each engine is created from
+    std::unique_ptr<qc::QuantumComputation> circuit{};
+    EngineSelector::Features                features{};
+    EngineSelector::Prediction              prediction{};
+    std::unique_ptr<Simulator>              engine{};
+    /// whether the package of the engine has been taken over
+    bool holds_engine_state{false};
+    /// measured qubit -> classical bit of the final measurements (for the engines sampling all qubits)
+    std::map<unsigned int, unsigned int> measurement_map{};
+
+    void initialize(std::unique_ptr<qc::QuantumComputation>&& qc);
+
+    /// creates the engine of the prediction from a copy of the circuit
+    void createEngine(const EngineSelector::Prediction& prediction_);
+
+    [[nodiscard]] std::map<std::string, std::size_t> toClassicalBits(const std::map<std::string, std::size_t>& results) const;
+};
+
+#endif //DDSIM_AUTOSIMULATOR_HPP
@@ -0,0 +1,130 @@
+#ifndef DDSIM_BATCHSIMULATOR_HPP
+#define DDSIM_BATCHSIMULATOR_HPP
+
+#include "InitialState.hpp"
+#include "QuantumComputation.hpp"
+#include "Simulator.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Simulates one circuit for a batch of initial states (e.g., the inputs of process tomography or of the verification of
+ * a reversible circuit) in a single package.
+ *
+ * All states are advanced gate by gate, so that each gate DD is built once and the compute table entries are shared
+ * between the inputs. If the unitary of the circuit is expected to be small (at most max_unitary_qubits qubits or only
+ * classical reversible gates), it is instead built once and applied to every input. Its construction is aborted as soon
+ * as it exceeds max_unitary_nodes nodes. The circuit may only contain gates and final measurements.
+ */
+class BatchSimulator: public Simulator {
+public:
+    enum class Mode {
+        Auto,
+        GateByGate,
+        Unitary
+    };
+
+    explicit BatchSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_):
+        qc(std::move(qc_)) {
+        dd->resize(qc->getNqubits());
+    }
+
+    BatchSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_, const unsigned long long seed):
+        Simulator(seed), qc(std::move(qc_)) {
+        dd->resize(qc->getNqubits());
+    }
+
+    BatchSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_, const std::vector<InitialState>& inputs_, const unsigned long long seed):
+        Simulator(seed), qc(std::move(qc_)) {
+        dd->resize(qc->getNqubits());
+        for (const auto& input: inputs_) {
+            addInput(input);
+        }
+    }
+
+    /// samples the given number of shots from the final state of every input and returns the counts of all inputs combined
+    std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
+
+    /// simulates all inputs and returns the counts of each input (nothing is sampled for 0 shots)
+    std::vector<std::map<std::string, std::size_t>> SimulateBatch(unsigned int shots);
+
+    void addInput(const InitialState& input) {
+        if (!input.isZeroState() && input.getNqubits() != qc->getNqubits()) {
+            throw std::runtime_error("The input state has " + std::to_string(input.getNqubits()) + " qubits, but the circuit has " + std::to_string(qc->getNqubits()) + ".");
+        }
+        inputs.push_back(input);
+    }
+
+    void setMode(const Mode mode_) { mode = mode_; }
+
+    void setUnitaryLimits(const dd::QubitCount max_qubits, const std::size_t max_nodes) {
+        max_unitary_qubits = max_qubits;
+        max_unitary_nodes  = max_nodes;
+    }
+
+    /// makes the final state of the given input the state of the simulator (e.g., for getVectorComplex or MeasureAll)
+    void selectInput(std::size_t input);
+
+    /// amplitude of the basis state (given with qubit n-1 first, like the measurement results) in the final state of the input
+    [[nodiscard]] std::complex<dd::fp> getAmplitude(std::size_t input, const std::string& basis_state) const;
+
+    [[nodiscard]] std::size_t getNumberOfInputs() const { return inputs.size(); }
+
+    /// whether the last simulation applied the unitary of the circuit
+    [[nodiscard]] bool usedUnitary() const { return used_unitary; }
+
+    std::map<std::string, std::string> AdditionalStatistics() override {
+        std::map<std::string, std::string> statistics{
+                {"inputs", std::to_string(inputs.size())},
+                {"batch_mode", used_unitary ? "unitary" : "gate_by_gate"},
+        };
+        if (unitary_ops > 0) {
+            statistics["unitary_construction_ops"] = std::to_string(unitary_ops);
+        }
+        if (used_unitary) {
+            statistics["unitary_nodes"]     = std::to_string(unitary_nodes);
+            statistics["construction_time"] = std::to_string(construction_time);
+        }
+        return statistics;
+    };
+
+    [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return qc->getNqubits(); };
+
+    [[nodiscard]] std::size_t getNumberOfOps() const override { return qc->getNops(); };
+
+    [[nodiscard]] std::string getName() const override { return "batch_" + qc->getName(); };
+
+protected:
+    std::unique_ptr<qc::QuantumComputation> qc;
+    std::vector<InitialState>               inputs{};
+    /// final state of each input
+    std::vector<dd::Package::vEdge> states{};
+
+    Mode           mode{Mode::Auto};
+    dd::QubitCount max_unitary_qubits{10};
+    std::size_t    max_unitary_nodes{1U << 16U};
+
+    bool        used_unitary{false};
+    std::size_t unitary_nodes{0};
+    double      construction_time{0.};
+    /// number of gates multiplied into the unitary (before its construction completed or was aborted)
+    std::size_t unitary_ops{0};
+    /// the (reference counted) unitary of the last simulation if it was used
+    qc::MatrixDD unitary{};
+
+    /// builds the unitary of the circuit and takes over its package unless it exceeds the node limit (in Auto mode)
+    bool constructUnitary();
+
+    void releaseStates();
+
+    /// the measured qubit of each classical bit (empty if the circuit has no measurements)
+    [[nodiscard]] std::map<std::size_t, dd::Qubit> measuredQubits() const;
+};
+
+#endif //DDSIM_BATCHSIMULATOR_HPP
@@ -1,13 +1,28 @@
 #ifndef DDSIM_CIRCUITSIMULATOR_HPP
 #define DDSIM_CIRCUITSIMULATOR_HPP
 
+#include "DeadlineController.hpp"
+#include "DynamicReordering.hpp"
+#include "EmulatedOperations.hpp"
+#include "ExecutionPlan.hpp"
+#include "FactorizedState.hpp"
+#include "GarbageCollectionPolicy.hpp"
+#include "GateApplicator.hpp"
+#include "LightconePass.hpp"
+#include "PermutationEmulator.hpp"
+#include "PrefixCache.hpp"
+#include "RegisterCompaction.hpp"
 #include "QuantumComputation.hpp"
+#include "QubitOrdering.hpp"
+#include "RepeatedBlocks.hpp"
 #include "Simulator.hpp"
+#include "StabilizerTableau.hpp"
 
 #include <cstddef>
 #include <istream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -68,17 +83,189 @@ public:
         dd->resize(qc->getNqubits());
     }
 
+    CircuitSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_, const InitialState& initial_state_, const unsigned long long seed):
+        Simulator(seed),
+        qc(std::move(qc_)), approx_info(ApproximationInfo(1.0, 1, ApproximationInfo::FidelityDriven)) {
+        dd->resize(qc->getNqubits());
+        CircuitSimulator::setInitialState(initial_state_);
+    }
+
     std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
 
+    /// idle qubit elimination, the stabilizer prefix, factorization and the prefix cache are not used with initial
+    /// states other than |0...0>
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState() && state.getNqubits() != qc->getNqubits()) {
+            throw std::runtime_error("The initial state has " + std::to_string(state.getNqubits()) + " qubits, but the circuit has " + std::to_string(qc->getNqubits()) + ".");
+        }
+        initial_state = state;
+    }
+
     std::map<std::string, std::string> AdditionalStatistics() override {
-        return {
+        std::map<std::string, std::string> statistics{
                 {"step_fidelity", std::to_string(approx_info.step_fidelity)},
                 {"approximation_runs", std::to_string(approximation_runs)},
-                {"final_fidelity", std::to_string(final_fidelity)},
+                {"final_fidelity", std::to_string(final_fidelity * deadline_fidelity)},
                 {"single_shots", std::to_string(single_shots)},
+                {"gc_calls", std::to_string(gc_policy.getCalls())},
+                {"gc_runs", std::to_string(gc_policy.getRuns())},
+                {"gc_time", std::to_string(gc_policy.getTime())},
         };
+        if (!post_selection.empty()) {
+            statistics["postselection_probability"] = std::to_string(getPostSelectionProbability());
+        }
+        if (!qubit_levels.empty()) {
+            statistics["arrangement_cost"] = std::to_string(QubitOrdering::arrangementCost(QubitOrdering::interactionWeights(*qc), qubit_levels));
+        }
+        if (sifting) {
+            statistics["sifting_runs"]           = std::to_string(sifting->getRuns());
+            statistics["level_swaps"]            = std::to_string(sifting->getSwaps());
+            statistics["sifted_gate_cache_hits"] = std::to_string(sifted_gates.getCacheHits());
+        }
+        if (dense_ratio > 0) {
+            statistics["dense_switches"] = std::to_string(dense_switches);
+        }
+        if (stabilizer_prefix) {
+            statistics["clifford_prefix_ops"] = std::to_string(clifford_prefix);
+        }
+        if (repeated_blocks) {
+            statistics["repeated_block_runs"] = std::to_string(repeated_blocks->getAppliedRuns());
+            statistics["block_squarings"]     = std::to_string(repeated_blocks->getSquarings());
+        }
+        if (!emulations.empty()) {
+            statistics["emulated_operations"]  = std::to_string(emulated_ops);
+            statistics["emulation_cache_hits"] = std::to_string(emulator.getCacheHits());
+        }
+        if (min_reversible_gates > 0) {
+            statistics["reversible_sections"]          = std::to_string(emulated_sections);
+            statistics["rejected_reversible_sections"] = std::to_string(rejected_sections);
+        }
+        if (factorize) {
+            statistics["largest_component"]          = std::to_string(largest_component);
+            statistics["factorized_gate_cache_hits"] = std::to_string(factorized_gates.getCacheHits());
+        }
+        if (compaction) {
+            statistics["idle_qubits"] = std::to_string(compaction->getNidle());
+        }
+        if (lightcone_removed_ops) {
+            statistics["lightcone_removed_ops"] = std::to_string(*lightcone_removed_ops);
+        }
+        if (deadline) {
+            statistics["deadline"]                      = std::to_string(deadline->getDeadline());
+            statistics["deadline_forced_approximation"] = deadline->forcedApproximation() ? "true" : "false";
+            statistics["deadline_approximations"]       = std::to_string(deadline->getApproximations());
+            statistics["deadline_mean_fidelity"]        = std::to_string(deadline_shots == 0 ? 1.L : deadline_fidelity_sum / static_cast<long double>(deadline_shots));
+        }
+        if (prefix_cache) {
+            statistics["prefix_cache_hits"]       = std::to_string(prefix_cache->getHits());
+            statistics["prefix_cache_reused_ops"] = std::to_string(prefix_cache->getReusedOps());
+        }
+        return statistics;
     };
 
+    /// removes all operations outside the backward lightcone of the measurements (see LightconePass) from the circuit
+    std::size_t pruneToLightcone() {
+        const auto removed    = LightconePass::apply(*qc);
+        lightcone_removed_ops = lightcone_removed_ops.value_or(0) + removed;
+        return removed;
+    }
+
+    /// simulate only the qubits that are acted upon and re-insert the idle ones (in |0>) into the final state
+    void setIdleQubitElimination(bool enable) { eliminate_idle_qubits = enable; }
+
+    /// simulate with a qubit order derived from the interaction graph of the circuit (see QubitOrdering); all results
+    /// are reported with respect to the original qubit order
+    void setQubitReordering(bool enable) { reorder_qubits = enable; }
+
+    /// sift the levels of the state DD whenever its size exceeds growth_factor times its size after the last sifting (see
+    /// DynamicReordering); not used together with factorization, idle qubit elimination or the prefix cache
+    void enableDynamicReordering(double growth_factor) { sifting = std::make_unique<DynamicReordering>(dd, growth_factor); }
+
+    void disableDynamicReordering() { sifting.reset(); }
+
+    /// continue a shot on a dense state vector once the DD has more than node_ratio * 2^n nodes (only for circuits with at
+    /// most max_qubits qubits); not used together with approximation, sifting, factorization, idle qubit elimination or the
+    /// prefix cache, and a ratio of 0 disables the switch
+    void setDenseSwitch(dd::fp node_ratio, dd::QubitCount max_qubits = 28) {
+        dense_ratio      = node_ratio;
+        max_dense_qubits = max_qubits;
+    }
+
+    /// simulate the maximal prefix of Clifford gates with a stabilizer tableau and continue with DDs from the resulting
+    /// state, which agrees with the gate-by-gate simulation up to a global phase; not used together with factorization or
+    /// the prefix cache
+    void setStabilizerPrefix(bool enable) { stabilizer_prefix = enable; }
+
+    /// apply runs of at least RepeatedBlocks::MIN_REPETITIONS identical consecutive blocks of up to max_block_length gates
+    /// as powers of the block operator computed by repeated squaring (as long as they have at most max_nodes nodes); not
+    /// used together with approximation, sifting, the dense switch, factorization or the prefix cache
+    void enableBlockExponentiation(std::size_t max_block_length, std::size_t max_nodes = 1U << 14U) {
+        repeated_blocks = std::make_unique<RepeatedBlocks>(dd, max_block_length, max_nodes);
+    }
+
+    /// must be called before resetting the package
+    void disableBlockExponentiation() { repeated_blocks.reset(); }
+
+    /// the operations first_op, ..., first_op + nops - 1 of the circuit (which must be unconditional gates) implement the
+    /// given operation, which is then applied at once as the DD built by EmulatedOperations; annotations are ignored (and
+    /// the gates simulated) with approximation, qubit reordering, idle qubit elimination, sifting or factorization
+    void addEmulation(std::size_t first_op, std::size_t nops, const EmulatedOperation& operation) { emulations.insert_or_assign(first_op, std::pair{nops, operation}); }
+
+    void clearEmulations() { emulations.clear(); }
+
+    /// apply sections of at least min_gates consecutive (unconditional) X and SWAP gates with any controls at once as a
+    /// permutation of the basis states (see PermutationEmulator); not used together with approximation, sifting or
+    /// factorization (or after switching to the dense state), and 0 disables the emulation. Sections for which the state
+    /// has more than max_slices slices are simulated gate by gate
+    void setPermutationEmulation(std::size_t min_gates, std::size_t max_slices = PermutationEmulator::DEFAULT_MAX_SLICES) {
+        min_reversible_gates = min_gates;
+        permutation_emulator.setMaxSlices(max_slices);
+    }
+
+    /// keep the state as a product of independent components that are only merged once a gate entangles them;
+    /// approximating simulations and simulations using the prefix cache always use a single DD
+    void setFactorization(bool enable) { factorize = enable; }
+
+    /// keeps the states after (unitary) circuit prefixes across Simulate calls, so that subsequent simulations of circuits
+    /// sharing a prefix (see setCircuit) resume from the deepest cached state; approximating simulations do not use the cache
+    void enablePrefixCache(std::size_t max_nodes, std::size_t checkpoint_interval = 0) {
+        prefix_cache = std::make_unique<PrefixCache>(dd, max_nodes, checkpoint_interval);
+    }
+
+    /// must be called before resetting the package
+    void disablePrefixCache() { prefix_cache.reset(); }
+
+    /// approximate the state whenever the simulation is projected to take longer than the given number of seconds, with
+    /// step fidelities of at least min_step_fidelity (see DeadlineController); the lowest fidelity achieved by a shot of the
+    /// last simulation is included in final_fidelity and the mean over its shots is reported as deadline_mean_fidelity.
+    /// Not applied to the dense or factorized state or together with the prefix cache
+    void setDeadline(double seconds, dd::fp min_step_fidelity = 0.9) { deadline.emplace(seconds, min_step_fidelity); }
+
+    void clearDeadline() { deadline.reset(); }
+
+    /// replaces the simulated circuit (keeping the package and the prefix cache, but dropping the emulation annotations)
+    void setCircuit(std::unique_ptr<qc::QuantumComputation>&& qc_) {
+        emulations.clear();
+        if (qc_->getNqubits() != qc->getNqubits()) {
+            if (prefix_cache) {
+                prefix_cache->clear();
+            }
+            dd->resize(qc_->getNqubits());
+        }
+        qc = std::move(qc_);
+    }
+
+    /// measurements writing to the given classical bits are post-selected onto the given values instead of being sampled
+    void setPostSelection(const std::map<std::size_t, bool>& values) { post_selection = values; }
+
+    /// probability of the post-selected outcomes in the last simulation (averaged over its shots, since earlier
+    /// measurements may influence it)
+    [[nodiscard]] dd::fp getPostSelectionProbability() const {
+        return postselection_shots == 0 ? 1. : postselection_probability_sum / static_cast<dd::fp>(postselection_shots);
+    }
+
+    void setGarbageCollectionInfo(const GarbageCollectionInfo& gc_info) { gc_policy = GarbageCollectionPolicy(gc_info); }
+
     [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return qc->getNqubits(); };
 
     [[nodiscard]] std::size_t getNumberOfOps() const override { return qc->getNops(); };
@@ -88,12 +275,89 @@ public:
 protected:
     std::unique_ptr<qc::QuantumComputation> qc;
     std::size_t                             single_shots{0};
+    GateApplicator                          applicator{dd};
+    GarbageCollectionPolicy                 gc_policy{};
 
     const ApproximationInfo approx_info;
     std::size_t             approximation_runs{0};
     long double             final_fidelity{1.0L};
 
-    std::map<std::size_t, bool> single_shot(bool ignore_nonunitaries);
+    std::optional<std::size_t> lightcone_removed_ops{};
+
+    std::optional<DeadlineController> deadline{};
+    /// instructions simulated in the previous shots of the current simulation
+    std::size_t deadline_ops{0};
+    /// lowest and summed fidelity achieved by the shots of the current simulation
+    long double deadline_fidelity{1.0L};
+    long double deadline_fidelity_sum{0.0L};
+    std::size_t deadline_shots{0};
+
+    bool                   reorder_qubits{false};
+    std::vector<dd::Qubit> static_levels{};
+
+    std::unique_ptr<DynamicReordering> sifting{};
+    /// current level of each qubit of the simulated circuit (empty if the levels are not changed during the simulation)
+    std::vector<dd::Qubit> simulated_levels{};
+    /// gates without a single-target matrix, built for the levels they were applied at (the register is treated as a
+    /// single component whose qubits are ordered by their levels)
+    FactorizedState::GateCache sifted_gates{dd};
+
+    dd::fp         dense_ratio{0};
+    dd::QubitCount max_dense_qubits{0};
+    /// node count of the DD that triggers the switch to the dense state (0 if disabled for the current simulation)
+    dd::fp      dense_threshold{0};
+    std::size_t dense_switches{0};
+    /// live vector nodes outside of the state at its last size check in the current shot (the check is only repeated
+    /// once the active node count exceeds the threshold by them)
+    std::size_t dense_other_nodes{0};
+
+    bool               stabilizer_prefix{false};
+    std::size_t        clifford_prefix{0};
+    dd::Package::vEdge clifford_state{};
+
+    std::unique_ptr<RepeatedBlocks> repeated_blocks{};
+
+    /// annotated operations of the circuit (first operation -> number of operations and emulated operation)
+    std::map<std::size_t, std::pair<std::size_t, EmulatedOperation>> emulations{};
+    /// the same for the instructions of the current plan
+    std::map<std::size_t, std::pair<std::size_t, EmulatedOperation>> emulated_instructions{};
+    EmulatedOperations                                                emulator{dd};
+    std::size_t                                                       emulated_ops{0};
+
+    std::size_t         min_reversible_gates{0};
+    PermutationEmulator permutation_emulator{dd};
+    /// classical reversible sections of the current plan (first instruction -> number of instructions and netlist)
+    std::map<std::size_t, std::pair<std::size_t, PermutationEmulator::Netlist>> reversible_sections{};
+    std::size_t                                                                  emulated_sections{0};
+    /// sections simulated gate by gate, since the state had more slices than the budget of the emulator
+    std::size_t rejected_sections{0};
+
+    bool                           factorize{false};
+    std::optional<FactorizedState> factorized_state{};
+    FactorizedState::GateCache     factorized_gates{dd};
+    std::size_t                    largest_component{0};
+
+    bool                              eliminate_idle_qubits{false};
+    std::optional<RegisterCompaction> compaction{};
+
+    std::unique_ptr<PrefixCache> prefix_cache{};
+    std::vector<std::size_t>     prefix_hashes{};
+
+    std::map<std::size_t, bool> post_selection{};
+    /// accumulated over the shots of the current simulation
+    dd::fp      postselection_probability_sum{0.};
+    std::size_t postselection_shots{0};
+
+    /// the idle qubits removed by the compaction are only re-inserted if the state is kept after the shot
+    ExecutionPlan::ClassicalBits single_shot(const ExecutionPlan& plan, bool ignore_nonunitaries, bool keep_state = true);
+
+    /// returns the probability of the post-selected part of the measurement
+    dd::fp measure(const ExecutionPlan::Instruction& instruction, ExecutionPlan::ClassicalBits& classic_values, bool post_select_only);
+
+    /// applies a gate of the plan to the root edge, respecting the current levels of the qubits
+    void applyGate(const ExecutionPlan::Instruction& instruction);
+
+    [[nodiscard]] std::vector<dd::Qubit> toSimulatedLevels(const std::vector<dd::Qubit>& qubits) const;
 };
 
 #endif //DDSIM_CIRCUITSIMULATOR_HPP
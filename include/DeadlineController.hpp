@@ -0,0 +1,60 @@
+#ifndef DDSIM_DEADLINECONTROLLER_HPP
+#define DDSIM_DEADLINECONTROLLER_HPP
+
+#include "dd/Package.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * Keeps a simulation within a time budget by approximating the state whenever it falls behind schedule.
+ *
+ * The remaining time is projected from the time per operation observed since the last check. As long as the projection
+ * exceeds the deadline, every check requests an approximation with twice the infidelity of the previous one (starting
+ * at INITIAL_INFIDELITY and bounded by 1 - min_step_fidelity) and the checks become more frequent. Once the simulation
+ * is on schedule again, the infidelity and the frequency are relaxed again. The deadline is not a hard limit, since
+ * every operation is still applied.
+ */
+class DeadlineController {
+public:
+    static constexpr dd::fp INITIAL_INFIDELITY = 0.01;
+    /// number of checks per simulation while on schedule
+    static constexpr std::size_t CHECKS = 100;
+
+    explicit DeadlineController(double seconds, dd::fp min_step_fidelity = 0.9):
+        deadline(seconds), min_step_fidelity(min_step_fidelity) {
+        if (seconds <= 0 || min_step_fidelity <= 0 || min_step_fidelity >= 1) {
+            throw std::runtime_error("The deadline must be positive and the minimal step fidelity in (0, 1).");
+        }
+    }
+
+    /// starts the clock for a simulation of the given number of operations (and resets the number of approximations)
+    void start(std::size_t total_ops);
+
+    /// returns the fidelity the state should be approximated with after the given number of operations (1 if the
+    /// simulation is on schedule or no check is due)
+    dd::fp check(std::size_t done_ops);
+
+    [[nodiscard]] double      getDeadline() const { return deadline; }
+    [[nodiscard]] std::size_t getApproximations() const { return approximations; }
+    [[nodiscard]] bool        forcedApproximation() const { return approximations > 0; }
+
+private:
+    double deadline;
+    dd::fp min_step_fidelity;
+
+    std::size_t                           total{0};
+    std::chrono::steady_clock::time_point start_time{};
+
+    std::size_t last_ops{0};
+    double      last_time{0.};
+    std::size_t interval{1};
+    std::size_t max_interval{1};
+    std::size_t next_check{0};
+    dd::fp      infidelity{0.};
+
+    std::size_t approximations{0};
+};
+
+#endif //DDSIM_DEADLINECONTROLLER_HPP
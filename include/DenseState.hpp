@@ -0,0 +1,122 @@
+#ifndef DDSIM_DENSESTATE_HPP
+#define DDSIM_DENSESTATE_HPP
+
+#include "dd/Package.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace tf {
+    class Executor;
+}
+
+/// allocator for storage aligned to the width of the vector registers
+template<class T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template<class U>
+    explicit AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment})); }
+    void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+    friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) { return true; }
+    friend bool operator!=(const AlignedAllocator&, const AlignedAllocator&) { return false; }
+};
+
+/**
+ * State vector stored as a dense array of amplitudes, where bit l of the index refers to level l.
+ *
+ * Used once a state has become too unstructured to be represented compactly by a DD. The amplitudes are stored in an
+ * aligned array and single-target gates are applied with AVX2/AVX-512 kernels (if available) to contiguous runs of
+ * amplitudes, optionally distributed over the workers of an executor.
+ */
+class DenseState {
+public:
+    using Amplitudes = std::vector<std::complex<dd::fp>, AlignedAllocator<std::complex<dd::fp>>>;
+    /// row-major 4x4 matrix, where bit 0 of the row and column index refers to the first target
+    using TwoTargetMatrix = std::array<std::complex<dd::fp>, 16>;
+
+    /// states with fewer amplitudes are not worth distributing over several threads
+    static constexpr std::size_t PARALLEL_THRESHOLD = 1ULL << 14;
+
+    /// the all-zero state
+    explicit DenseState(dd::QubitCount nqubits);
+
+    /// the state represented by the vector DD
+    DenseState(const dd::Package::vEdge& e, dd::QubitCount nqubits);
+
+    /// the state given by its amplitudes (whose number has to be a power of two)
+    explicit DenseState(const std::vector<std::complex<dd::fp>>& values);
+
+    void applyGate(const dd::GateMatrix& matrix, dd::Qubit target, const dd::Controls& controls);
+
+    void applyTwoTargetGate(const TwoTargetMatrix& matrix, dd::Qubit target0, dd::Qubit target1, const dd::Controls& controls);
+
+    /// extracts the matrix acting on the targets (with all controls satisfied) from the matrix DD of a two-target gate
+    static TwoTargetMatrix getTwoTargetMatrix(const dd::Package::mEdge& m, dd::Qubit target0, dd::Qubit target1, const dd::Controls& controls);
+
+    /// applies an arbitrary operation given as matrix DD
+    void applyMatrix(const dd::Package::mEdge& m);
+
+    /// samples the given qubits jointly and collapses the state onto the outcome (returned in the order of the qubits)
+    std::vector<bool> measure(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+
+    void reset(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+
+    /// projects the state onto the given outcome, renormalizes it and returns the probability of that outcome
+    dd::fp postSelect(const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes);
+
+    /// samples all qubits (in the format of dd::Package::measureAll, i.e., with the highest level first)
+    std::string measureAll(bool collapse, std::mt19937_64& generator);
+
+    std::map<std::string, std::size_t> sample(std::size_t shots, std::mt19937_64& generator) const;
+
+    [[nodiscard]] const Amplitudes& getAmplitudes() const { return amplitudes; }
+
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+
+    /// gates are applied in parallel by the workers of the executor (nullptr for sequential execution)
+    void setExecutor(tf::Executor* exec) { executor = exec; }
+
+    /// name of the vector extension used by the gate kernels
+    [[nodiscard]] static std::string getSimdExtension();
+
+private:
+    dd::QubitCount nqubits;
+    Amplitudes     amplitudes;
+    tf::Executor*  executor = nullptr;
+
+    /// applies the matrix to the pairs (a[j], a[j + stride]) for 0 <= j < length
+    static void applyRun(std::complex<dd::fp>* a, std::size_t stride, std::size_t length, const std::array<std::complex<dd::fp>, 4>& m);
+
+    /// executes apply(begin, end) for the ranges of [0, count), distributed over the workers of the executor if worthwhile
+    void forRanges(std::size_t count, const std::function<void(std::size_t, std::size_t)>& apply) const;
+
+    [[nodiscard]] dd::fp probabilityOfOne(std::size_t mask) const;
+
+    /// keeps the amplitudes (i & mask) == value, scaled by factor, and sets all others to zero
+    void project(std::size_t mask, std::size_t value, dd::fp factor);
+
+    [[nodiscard]] std::string toLevelString(std::size_t index) const;
+
+    void fill(const dd::Package::vEdge& e, std::complex<dd::fp> weight, std::size_t offset);
+
+    void multiply(const dd::Package::mEdge& m, std::complex<dd::fp> weight, std::size_t in, std::size_t out, Amplitudes& result) const;
+};
+
+#endif //DDSIM_DENSESTATE_HPP
@@ -0,0 +1,106 @@
+#ifndef DDSIM_DIAGONALCOST_HPP
+#define DDSIM_DIAGONALCOST_HPP
+
+#include "DenseState.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Classical cost function f(x) = offset + sum_i a_i x_i + sum_{i<j} b_ij x_i x_j of the measured bits x_q (e.g., the
+ * objective of a QUBO or an Ising model in QAOA), whose expectation and CVaR are computed exactly from a state.
+ *
+ * The probability of an outcome is the product of the squared magnitudes of the edge weights along its path, so the
+ * expectation is accumulated level by level in a single memoized traversal of the vector DD: each node keeps the
+ * probability mass below it, the cost of the levels below and, per lower level, the mass of the outcomes setting it to 1
+ * (which the quadratic terms of higher levels are weighted with). The CVaR is taken over the outcomes enumerated in order
+ * of decreasing probability by a best-first search over the DD.
+ */
+class DiagonalCost {
+public:
+    using Couplings = std::map<std::pair<dd::Qubit, dd::Qubit>, dd::fp>;
+
+    struct CVaR {
+        /// mean cost of the lowest-cost outcomes with a total probability of alpha (relative to the covered probability)
+        dd::fp value;
+        /// total probability of the enumerated outcomes (1 up to rounding if the value is exact)
+        dd::fp      covered_probability;
+        std::size_t outcomes;
+    };
+
+    explicit DiagonalCost(dd::QubitCount nqubits, dd::fp offset = 0.):
+        nqubits(nqubits), offset(offset), linear(nqubits, 0.) {}
+
+    /// f(z) = offset + sum_i h_i z_i + sum_{i,j} J_ij z_i z_j with the spins z_q = 1 - 2 x_q
+    static DiagonalCost fromIsing(dd::QubitCount nqubits, const std::vector<dd::fp>& h, const Couplings& J, dd::fp offset = 0.);
+
+    /// f(x) = offset + sum_{i,j} Q_ij x_i x_j (the diagonal entries are the linear terms)
+    static DiagonalCost fromQubo(dd::QubitCount nqubits, const Couplings& Q, dd::fp offset = 0.);
+
+    void addLinear(dd::Qubit qubit, dd::fp coefficient);
+    /// adds a linear term if both qubits are the same
+    void addQuadratic(dd::Qubit first, dd::Qubit second, dd::fp coefficient);
+
+    /// cost of a measurement result (qubit n-1 first)
+    [[nodiscard]] dd::fp evaluate(const std::string& outcome) const;
+
+    /// levels[q] is the level representing qubit q (level q if levels is empty)
+    [[nodiscard]] dd::fp expectation(const dd::Package::vEdge& state, const std::vector<dd::Qubit>& levels = {}) const;
+    /// the same for amplitudes indexed by level
+    [[nodiscard]] dd::fp expectation(const DenseState::Amplitudes& amplitudes, const std::vector<dd::Qubit>& levels = {}) const;
+
+    /// CVaR_alpha over the most probable outcomes until they cover 1 - tolerance of the probability or max_outcomes are reached
+    [[nodiscard]] CVaR cvar(const dd::Package::vEdge& state, dd::fp alpha, const std::vector<dd::Qubit>& levels = {}, std::size_t max_outcomes = DEFAULT_MAX_OUTCOMES, dd::fp tolerance = 1e-9) const;
+    [[nodiscard]] CVaR cvar(const DenseState::Amplitudes& amplitudes, dd::fp alpha, const std::vector<dd::Qubit>& levels = {}) const;
+
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+
+    static constexpr std::size_t DEFAULT_MAX_OUTCOMES = 1U << 16U;
+
+private:
+    dd::QubitCount      nqubits;
+    dd::fp              offset;
+    std::vector<dd::fp> linear;
+    /// (i, j) with i < j -> coefficient
+    Couplings quadratic{};
+
+    /// sums of the outcomes below a node weighted with their probabilities
+    struct NodeSums {
+        dd::fp mass{0.};
+        dd::fp cost{0.};
+        /// mass of the outcomes with level k set to 1 per lower level k
+        std::vector<dd::fp> ones{};
+    };
+
+    /// the terms by level: linear coefficient and quadratic terms with lower levels
+    struct LevelTerms {
+        dd::fp                                      linear{0.};
+        std::vector<std::pair<std::size_t, dd::fp>> couplings{};
+    };
+
+    [[nodiscard]] std::vector<LevelTerms> byLevel(const std::vector<dd::Qubit>& levels) const;
+
+    static const NodeSums& accumulate(dd::Package::vNode* node, dd::Qubit level, const std::vector<LevelTerms>& terms, std::unordered_map<dd::Package::vNode*, NodeSums>& sums);
+    static dd::fp          maxProbability(dd::Package::vNode* node, dd::Qubit level, std::unordered_map<dd::Package::vNode*, dd::fp>& maxima);
+
+    /// outcome (qubit n-1 first) of the basis state given by its level bits
+    [[nodiscard]] std::string toOutcome(const std::vector<bool>& level_bits, const std::vector<dd::Qubit>& levels) const;
+
+    void checkQubit(dd::Qubit qubit) const;
+
+    /// CVaR_alpha of the given (probability, cost) pairs
+    [[nodiscard]] static CVaR tail(std::vector<std::pair<dd::fp, dd::fp>>& outcomes, dd::fp alpha);
+
+    [[nodiscard]] static dd::fp probability(const dd::Complex& c) {
+        const auto r = dd::CTEntry::val(c.r);
+        const auto i = dd::CTEntry::val(c.i);
+        return r * r + i * i;
+    }
+};
+
+#endif //DDSIM_DIAGONALCOST_HPP
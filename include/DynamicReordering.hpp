@@ -0,0 +1,56 @@
+#ifndef DDSIM_DYNAMICREORDERING_HPP
+#define DDSIM_DYNAMICREORDERING_HPP
+
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Dynamic variable reordering (sifting) of vector DDs.
+ *
+ * Whenever the size of the state grows beyond growth_factor times its size after the last reordering, every
+ * variable is moved through all levels by swapping adjacent levels and is then placed at the level that
+ * yielded the smallest DD (Rudell's sifting). The given levels (the level of each qubit) are kept up to date.
+ *
+ * As in Rudell's implementation, the size is the number of active nodes of the unique table, which the reference
+ * counting keeps up to date. Hence, neither the check after an operation nor a swap traverses the DD. Other reference
+ * counted vector DDs only add an offset.
+ */
+class DynamicReordering {
+public:
+    DynamicReordering(std::unique_ptr<dd::Package>& dd, double growth_factor):
+        dd(dd), growth_factor(growth_factor) {}
+
+    /// sifts the (reference counted) root if it has grown too much since the last reordering
+    void afterOperation(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels);
+
+    void sift(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels);
+
+    /// swaps the given level with the one above it (the returned edge is not reference counted)
+    [[nodiscard]] static dd::Package::vEdge swapLevels(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, dd::Qubit level);
+
+    [[nodiscard]] std::size_t getRuns() const { return runs; }
+    [[nodiscard]] std::size_t getSwaps() const { return swaps; }
+
+private:
+    using SwapCache = std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>;
+
+    std::unique_ptr<dd::Package>& dd;
+    double                        growth_factor;
+    std::size_t                   baseline = 0;
+    std::size_t                   runs     = 0;
+    std::size_t                   swaps    = 0;
+
+    [[nodiscard]] std::size_t activeNodes() const { return dd->vUniqueTable.getActiveNodeCount(); }
+
+    /// swaps the levels in place and updates the reference counts and the levels of the qubits (returns the new size)
+    std::size_t swap(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels, dd::Qubit level);
+
+    static dd::Package::vEdge swapNode(std::unique_ptr<dd::Package>& dd, dd::Package::vNode* p, dd::Qubit level, SwapCache& cache);
+    static dd::Package::vEdge scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, const dd::Complex& w);
+};
+
+#endif //DDSIM_DYNAMICREORDERING_HPP
@@ -0,0 +1,117 @@
+#ifndef DDSIM_EMULATEDOPERATIONS_HPP
+#define DDSIM_EMULATEDOPERATIONS_HPP
+
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// high-level operation applied by EmulatedOperations (registers are given least significant qubit first)
+struct EmulatedOperation {
+    enum class Kind {
+        QFT,            ///< quantum Fourier transform of the register (including the final swaps)
+        InverseQFT,     ///< inverse of QFT
+        AddConstant,    ///< |x> -> |x + constant mod 2^r>
+        AddRegister,    ///< |x>|y> -> |x>|x + y mod 2^r> for the register x and the equally sized register other
+        MultiplyModulo, ///< |x> -> |constant * x mod modulus> for x < modulus (identity otherwise)
+        LessThan        ///< |x>|t> -> |x>|t XOR (x < constant)> for the register x and the single target qubit other
+    };
+
+    Kind                   kind;
+    std::vector<dd::Qubit> qubits;
+    std::vector<dd::Qubit> other{};
+    unsigned long long     constant{0};
+    unsigned long long     modulus{0};
+    dd::Controls           controls{};
+};
+
+/**
+ * Library of high-level operations that are applied as a single matrix DD built directly from their definition instead
+ * of from a gate-level decomposition.
+ *
+ * The additions and the comparison are built level by level like a ripple-carry circuit: the DD nodes of a level are
+ * distinguished by the values of the carries (or borrows) that connect the register qubits above and below it, which
+ * gives a constant number of nodes per register qubit if the significance of the qubits follows the variable order. The
+ * modular multiplication has no such chain and is built from the table of all register values. The QFT is assembled
+ * once from its gates; its DD is dense in the register, hence it only pays off for small registers applied repeatedly.
+ * Both are limited to MAX_PERMUTATION_QUBITS register qubits. The DDs are cached (and pinned in the package) until
+ * clear().
+ */
+class EmulatedOperations {
+public:
+    /// the modular multiplication is built from the table of all register values, the QFT is dense in the register
+    static constexpr std::size_t MAX_PERMUTATION_QUBITS = 24;
+
+    explicit EmulatedOperations(std::unique_ptr<dd::Package>& dd):
+        dd(dd) {}
+
+    ~EmulatedOperations() { clear(); }
+
+    EmulatedOperations(const EmulatedOperations&) = delete;
+    EmulatedOperations& operator=(const EmulatedOperations&) = delete;
+
+    /// the DD of the operation on n qubits (built on first use)
+    dd::Package::mEdge get(dd::QubitCount n, const EmulatedOperation& operation);
+
+    /// applies the operation to the state
+    void apply(const EmulatedOperation& operation, dd::Package::vEdge& state, dd::QubitCount n);
+
+    /// releases the cached DDs
+    void clear();
+
+    [[nodiscard]] std::size_t getCacheSize() const { return cache.size(); }
+    [[nodiscard]] std::size_t getCacheHits() const { return hits; }
+
+private:
+    std::unique_ptr<dd::Package>&             dd;
+    std::map<std::string, dd::Package::mEdge> cache{};
+    std::size_t                               hits{0};
+
+    /// (register value, image) of all basis states of a register
+    using Mapping = std::vector<std::pair<unsigned long long, unsigned long long>>;
+
+    /// values of the carry wires that connect the qubits of an arithmetic permutation
+    using Assignment = std::map<std::size_t, bool>;
+
+    /// constraint of an arithmetic permutation on the output and input bit of a qubit and on the carry wires it reads
+    struct Cell {
+        dd::Qubit                                                      qubit;
+        std::vector<std::size_t>                                       wires;
+        std::function<bool(bool out, bool in, const Assignment& wire)> allows;
+    };
+
+    struct CarryChain {
+        std::vector<std::optional<Cell>>                                        cell_of_level;
+        std::vector<dd::Qubit>                                                  last_level; // of each wire, below which it is not read anymore
+        std::map<std::pair<dd::Qubit, std::set<Assignment>>, dd::Package::mEdge> built{};
+    };
+
+    [[nodiscard]] static std::string key(dd::QubitCount n, const EmulatedOperation& operation);
+
+    dd::Package::mEdge build(dd::QubitCount n, const EmulatedOperation& operation);
+
+    dd::Package::mEdge qft(dd::QubitCount n, const std::vector<dd::Qubit>& qubits, const dd::Controls& controls);
+
+    /// the permutation |x> -> |f(x)> of the basis states of the register, applied only if all controls are satisfied
+    dd::Package::mEdge permutation(dd::QubitCount n, std::vector<dd::Qubit> qubits, const dd::Controls& controls, const std::function<unsigned long long(unsigned long long)>& f);
+
+    dd::Package::mEdge buildPermutation(dd::Qubit level, const std::vector<int>& bit_of_level, const Mapping& mapping);
+
+    /// bit k of the addition of r bits, where the carry into bit k is wire k - 1 and the bit of the addend is given by the wires
+    static Cell adderCell(dd::Qubit qubit, std::size_t k, std::size_t r, std::vector<std::size_t> wires, const std::function<bool(const Assignment&)>& addend);
+
+    /// the permutation whose matrix entries are those that satisfy all cells for some values of the wires (qubits without a cell are left alone), applied only if all controls are satisfied
+    dd::Package::mEdge carryPermutation(dd::QubitCount n, std::vector<Cell> cells, std::size_t wires, const dd::Controls& controls);
+
+    /// the node of the level for the possible values of the wires that are read both above and below it
+    dd::Package::mEdge buildCarryChain(dd::Qubit level, CarryChain& chain, const std::set<Assignment>& open);
+};
+
+#endif //DDSIM_EMULATEDOPERATIONS_HPP
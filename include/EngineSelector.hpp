@@ -0,0 +1,89 @@
+#ifndef DDSIM_ENGINESELECTOR_HPP
+#define DDSIM_ENGINESELECTOR_HPP
+
+#include "QuantumComputation.hpp"
+#include "dd/Definitions.hpp"
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Predicts which simulation engine is fastest for a circuit.
+ *
+ * The prediction is based on a few features of the circuit, most importantly the number of operations crossing splits of
+ * the register at a quarter, half and three quarters (the middle one being the decisions of the hybrid
+ * Schrodinger-Feynman simulator), which bounds the number of nodes per level of the state DD. All costs are rough
+ * estimates of the number of basic operations given as log2.
+ */
+class EngineSelector {
+public:
+    enum class Engine {
+        DD,
+        Dense,
+        Hybrid,
+        Path,
+        Unitary
+    };
+
+    enum class MeasurementStructure {
+        None,
+        Final,
+        MidCircuit
+    };
+
+    struct Features {
+        dd::QubitCount nqubits{0};
+        std::size_t    ngates{0};
+        std::size_t    depth{0};
+        dd::fp         two_qubit_fraction{0};
+        dd::fp         clifford_fraction{0};
+        /// number of leading Clifford gates (which can be simulated with a stabilizer tableau)
+        std::size_t clifford_prefix{0};
+
+        MeasurementStructure measurements{MeasurementStructure::None};
+        /// all operations but final measurements are standard operations (as required by the hybrid simulator)
+        bool only_standard_operations{true};
+
+        /// the simulation starts from an arbitrary initial state (which the hybrid and the path simulator do not support)
+        bool initial_state{false};
+
+        /// operations crossing each candidate split (the lowest level of the upper part) of the register, the ones crossing
+        /// the middle (as the decisions of the hybrid simulator) and the widest split, and whether the order of QubitOrdering
+        /// reduces them
+        std::map<dd::Qubit, std::size_t> cut_decisions{};
+        std::size_t                      decisions{0};
+        std::size_t                      max_decisions{0};
+        bool                             reorder{false};
+    };
+
+    struct Prediction {
+        Engine                   engine{Engine::DD};
+        std::map<Engine, dd::fp> log_costs{};
+        std::string              reason{};
+    };
+
+    /// a DD node operation is assumed to be 2^DD_NODE_COST times as expensive as updating a dense amplitude
+    static constexpr dd::fp DD_NODE_COST = 4;
+    /// the dense and the hybrid (amplitude mode) simulation store 2^n amplitudes
+    static constexpr dd::QubitCount MAX_DENSE_QUBITS = 30;
+
+    [[nodiscard]] static Features   analyze(const qc::QuantumComputation& qc);
+    [[nodiscard]] static Prediction predict(const Features& features, std::size_t nthreads = 1, dd::QubitCount max_dense_qubits = MAX_DENSE_QUBITS);
+
+    /// the features and the prediction in the format of Simulator::AdditionalStatistics
+    [[nodiscard]] static std::map<std::string, std::string> toStatistics(const Features& features, const Prediction& prediction);
+
+    [[nodiscard]] static std::string toString(Engine engine);
+
+    /// number of operations acting on levels on both sides of each split, where levels[q] is the level of qubit q
+    [[nodiscard]] static std::map<dd::Qubit, std::size_t> countDecisions(const qc::QuantumComputation& qc, const std::vector<dd::Qubit>& levels, const std::set<dd::Qubit>& splits);
+
+private:
+    /// log2(2^a + 2^b)
+    [[nodiscard]] static dd::fp logSum(dd::fp a, dd::fp b);
+};
+
+#endif //DDSIM_ENGINESELECTOR_HPP
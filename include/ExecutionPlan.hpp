@@ -0,0 +1,109 @@
+#ifndef DDSIM_EXECUTIONPLAN_HPP
+#define DDSIM_EXECUTIONPLAN_HPP
+
+#include "DenseState.hpp"
+#include "QuantumComputation.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * Flat, pre-lowered representation of a quantum computation for repeated execution.
+ *
+ * The matrix DDs of all gates are built once and pinned (reference counted) in the given package, so that
+ * multi-shot and multi-trajectory simulations do not have to rebuild them on every run. Measurements and
+ * classically-controlled operations are described by classical bit positions and bitmasks instead of
+ * being re-analyzed via dynamic casts on every execution.
+ */
+class ExecutionPlan {
+public:
+    enum class Kind {
+        Gate,
+        Measure,
+        Reset
+    };
+
+    /// classical bits packed into 64-bit words (bit i is stored in word i / 64 at position i % 64)
+    using ClassicalBits = std::vector<std::uint64_t>;
+
+    /// the instruction is executed iff (bits[word] & mask) == expected holds for all conditions
+    struct Condition {
+        std::size_t   word;
+        std::uint64_t mask;
+        std::uint64_t expected;
+    };
+
+    struct Instruction {
+        Kind kind = Kind::Gate;
+        /// the (underlying) operation, i.e., for classically-controlled operations the controlled operation
+        const qc::Operation* op = nullptr;
+        /// pinned DD of the operation (only for gates that are not applied directly)
+        qc::MatrixDD dd{};
+        /// matrix of single-target gates that are applied directly via the GateApplicator
+        std::optional<dd::GateMatrix> matrix{};
+        /// matrix of two-target gates that are applied directly to dense states
+        std::optional<DenseState::TwoTargetMatrix> two_target_matrix{};
+        /// measured and reset qubits, or targets followed by the controls of a gate
+        std::vector<dd::Qubit> qubits{};
+        /// classical bits the measurement results are written to
+        std::vector<std::size_t> classics{};
+        std::vector<Condition>   condition{};
+
+        [[nodiscard]] bool isConditional() const { return !condition.empty(); }
+    };
+
+    /// if directGates is set, no DDs are built for gates that are supported by the GateApplicator
+    ExecutionPlan(const qc::QuantumComputation& qc, std::unique_ptr<dd::Package>& dd, bool directGates = false);
+
+    ~ExecutionPlan();
+
+    ExecutionPlan(const ExecutionPlan&) = delete;
+    ExecutionPlan& operator=(const ExecutionPlan&) = delete;
+
+    [[nodiscard]] ClassicalBits makeClassicalBits() const { return ClassicalBits((ncbits + 63) / 64, 0); }
+
+    [[nodiscard]] static bool getBit(const ClassicalBits& bits, std::size_t index) {
+        return (bits.at(index / 64) >> (index % 64)) & 1ULL;
+    }
+
+    static void setBit(ClassicalBits& bits, std::size_t index, bool value) {
+        const std::uint64_t mask = 1ULL << (index % 64);
+        if (value) {
+            bits.at(index / 64) |= mask;
+        } else {
+            bits.at(index / 64) &= ~mask;
+        }
+    }
+
+    [[nodiscard]] static bool conditionHolds(const Instruction& instruction, const ClassicalBits& bits) {
+        for (const auto& c: instruction.condition) {
+            if ((bits.at(c.word) & c.mask) != c.expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+    [[nodiscard]] std::size_t    getNcbits() const { return ncbits; }
+    [[nodiscard]] std::size_t size() const { return instructions.size(); }
+
+    [[nodiscard]] const Instruction& at(std::size_t i) const { return instructions.at(i); }
+
+    [[nodiscard]] auto begin() const { return instructions.cbegin(); }
+    [[nodiscard]] auto end() const { return instructions.cend(); }
+
+private:
+    std::unique_ptr<dd::Package>& dd;
+    std::vector<Instruction>      instructions{};
+    dd::QubitCount                nqubits;
+    std::size_t                   ncbits;
+
+    static std::vector<Condition> lowerCondition(std::size_t start, std::size_t length, unsigned int expectedValue);
+};
+
+#endif //DDSIM_EXECUTIONPLAN_HPP
@@ -0,0 +1,105 @@
+#ifndef DDSIM_FACTORIZEDSTATE_HPP
+#define DDSIM_FACTORIZEDSTATE_HPP
+
+#include "ExecutionPlan.hpp"
+#include "GateApplicator.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * State of a register that is kept as a product of independent components.
+ *
+ * Every qubit starts in its own component. A component is merged with others only once an operation acts on
+ * qubits of several components, so the DDs (and the cost of applying gates to them) scale with the size of the
+ * largest component instead of the whole register. Level i of a component's DD represents the i-th smallest
+ * qubit of the component.
+ */
+class FactorizedState {
+public:
+    struct Component {
+        /// qubits of the component in ascending order
+        std::vector<dd::Qubit> qubits{};
+        dd::Package::vEdge     state{};
+    };
+
+    /**
+     * DDs of the operations without a single-target matrix on the registers of the components they were applied to,
+     * keyed by the instruction and the qubits of the component. The components evolve the same way in every shot,
+     * so the cache is shared by the states of all shots of a plan and the DDs are pinned in the package until clear().
+     */
+    class GateCache {
+    public:
+        explicit GateCache(std::unique_ptr<dd::Package>& dd):
+            dd(dd) {}
+
+        ~GateCache() { clear(); }
+
+        GateCache(const GateCache&) = delete;
+        GateCache& operator=(const GateCache&) = delete;
+
+        /// the DD of the operation on the register of a component with the given qubits (built on first use)
+        dd::Package::mEdge get(const ExecutionPlan::Instruction& instruction, const std::vector<dd::Qubit>& qubits, dd::QubitCount nqubits);
+
+        /// releases the cached DDs (required whenever the plan changes)
+        void clear();
+
+        [[nodiscard]] std::size_t getCacheHits() const { return hits; }
+
+    private:
+        using Key = std::pair<const ExecutionPlan::Instruction*, std::vector<dd::Qubit>>;
+
+        std::unique_ptr<dd::Package>&     dd;
+        std::map<Key, dd::Package::mEdge> cache{};
+        std::size_t                       hits{0};
+    };
+
+    FactorizedState(std::unique_ptr<dd::Package>& dd, dd::QubitCount nqubits, GateCache& gates);
+    ~FactorizedState();
+
+    FactorizedState(const FactorizedState&) = delete;
+    FactorizedState& operator=(const FactorizedState&) = delete;
+
+    void apply(const ExecutionPlan::Instruction& instruction, GateApplicator& applicator);
+
+    std::vector<bool> measure(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+    void              reset(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+    dd::fp            postSelect(const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes);
+
+    /// DD of the whole register (the returned edge is not reference counted)
+    [[nodiscard]] dd::Package::vEdge assemble();
+
+    [[nodiscard]] const std::vector<Component>& getComponents() const { return components; }
+    /// size of the largest component that existed so far
+    [[nodiscard]] std::size_t getLargestComponent() const { return largest; }
+
+private:
+    using ProductCache = std::map<std::pair<dd::Package::vNode*, dd::Package::vNode*>, dd::Package::vEdge>;
+
+    std::unique_ptr<dd::Package>& dd;
+    dd::QubitCount                nqubits;
+    GateCache&                    gates;
+    std::vector<Component>        components{};
+    std::vector<std::size_t>      componentOf{};
+    std::size_t                   largest = 1;
+
+    /// merges the components of the given qubits and returns the index of the resulting component
+    std::size_t join(const std::set<dd::Qubit>& qubits);
+    Component   merge(const Component& a, const Component& b);
+
+    /// groups the given qubits by component (as local levels together with their positions in the given vector)
+    std::map<std::size_t, std::pair<std::vector<dd::Qubit>, std::vector<std::size_t>>> group(const std::vector<dd::Qubit>& qubits) const;
+
+    [[nodiscard]] dd::Qubit localIndex(const Component& component, dd::Qubit qubit) const;
+
+    dd::Package::vEdge product(const dd::Package::vEdge& a, const dd::Package::vEdge& b, const std::vector<bool>& fromA, ProductCache& cache);
+    dd::Complex        multiply(const dd::Complex& a, const dd::Complex& b);
+};
+
+#endif //DDSIM_FACTORIZEDSTATE_HPP
@@ -0,0 +1,99 @@
+#ifndef DDSIM_GARBAGECOLLECTIONPOLICY_HPP
+#define DDSIM_GARBAGECOLLECTIONPOLICY_HPP
+
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+struct GarbageCollectionInfo {
+    enum CollectWhen {
+        Default,     // let the package decide after every operation (based on its internal limits)
+        EveryK,      // force a collection every `every_k` operations
+        DeadRatio,   // force a collection once the fraction of dead nodes exceeds `threshold`
+        Memory,      // force a collection once the estimated size of the tables grew by `threshold` MiB since the last one
+        Measurements // force a collection only after measurements and resets
+    };
+
+    /* Default to the behavior of the package */
+    GarbageCollectionInfo():
+        collect_when(CollectWhen::Default), every_k(1), threshold(0.5) {}
+
+    GarbageCollectionInfo(CollectWhen collect_when, std::size_t every_k, double threshold):
+        collect_when(collect_when), every_k(every_k), threshold(threshold) {}
+
+    friend std::istream& operator>>(std::istream& in, CollectWhen& when) {
+        std::string token;
+        in >> token;
+
+        if (token == "default") {
+            when = Default;
+        } else if (token == "every") {
+            when = EveryK;
+        } else if (token == "dead_ratio") {
+            when = DeadRatio;
+        } else if (token == "memory") {
+            when = Memory;
+        } else if (token == "measurements") {
+            when = Measurements;
+        } else {
+            throw std::runtime_error("Unknown garbage collection mode '" + token + "'.");
+        }
+
+        return in;
+    }
+
+    CollectWhen collect_when;
+    std::size_t every_k;
+    double      threshold;
+};
+
+/**
+ * Decides when the simulation loops collect garbage and keeps track of how often and how long collections ran.
+ */
+class GarbageCollectionPolicy {
+public:
+    explicit GarbageCollectionPolicy(const GarbageCollectionInfo& info = GarbageCollectionInfo()):
+        info(info) {
+        if (info.collect_when == GarbageCollectionInfo::EveryK && info.every_k == 0) {
+            throw std::runtime_error("Garbage collection interval must be positive.");
+        }
+    }
+
+    /// to be called after each operation (measurement is set after measurements, resets and at the end of runs); returns whether garbage was actually collected
+    bool afterOperation(std::unique_ptr<dd::Package>& dd, bool measurement = false);
+
+    /// accumulates the statistics of another policy instance (e.g., of a worker thread)
+    void merge(const GarbageCollectionPolicy& other) {
+        gc_calls += other.gc_calls;
+        gc_runs += other.gc_runs;
+        gc_time += other.gc_time;
+    }
+
+    [[nodiscard]] const GarbageCollectionInfo& getInfo() const { return info; }
+    [[nodiscard]] std::size_t                  getCalls() const { return gc_calls; }
+    [[nodiscard]] std::size_t                  getRuns() const { return gc_runs; }
+    [[nodiscard]] double                       getTime() const { return gc_time; }
+
+    /// fraction of nodes in the unique tables that are not referenced
+    static double deadNodeRatio(const std::unique_ptr<dd::Package>& dd);
+
+    /// rough estimate of the memory occupied by the unique tables and the complex table in MiB
+    static double estimatedMemory(const std::unique_ptr<dd::Package>& dd);
+
+private:
+    GarbageCollectionInfo info;
+    std::size_t           ops_since_collection{0};
+    double                memory_after_collection{0}; // estimated size of the tables left by the last forced collection
+
+    std::size_t gc_calls{0}; // calls to the package's garbage collection
+    std::size_t gc_runs{0};  // calls that actually collected something
+    double      gc_time{0};  // time spent in all calls (in seconds)
+
+    bool collect(std::unique_ptr<dd::Package>& dd, bool force);
+};
+
+#endif //DDSIM_GARBAGECOLLECTIONPOLICY_HPP
@@ -0,0 +1,67 @@
+#ifndef DDSIM_GATEAPPLICATOR_HPP
+#define DDSIM_GATEAPPLICATOR_HPP
+
+#include "dd/Package.hpp"
+#include "operations/Operation.hpp"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Applies (controlled) single-target gates given as dense 2x2 matrices directly to a vector DD.
+ *
+ * Instead of building an n-qubit matrix DD and multiplying it with the state, only the levels between the top of
+ * the DD and the lowest involved qubit are rewritten. Subtrees below that level and branches in which a control is
+ * not satisfied are reused as they are.
+ */
+class GateApplicator {
+public:
+    explicit GateApplicator(std::unique_ptr<dd::Package>& dd):
+        dd(dd) {}
+
+    /// returns the (not reference counted) state after applying the gate, analogous to dd::Package::multiply
+    dd::Package::vEdge apply(const dd::GateMatrix& matrix, dd::Qubit target, const dd::Controls& controls, const dd::Package::vEdge& e);
+
+    /// returns the matrix of single-target standard operations or nothing if the operation is not supported
+    static std::optional<dd::GateMatrix> getGateMatrix(const qc::Operation& op);
+
+private:
+    std::unique_ptr<dd::Package>& dd;
+
+    dd::GateMatrix matrix{};
+    dd::Qubit      target{};
+    /// control type per level: 0 = no control, 1 = positive control, -1 = negative control
+    std::vector<signed char> controlType{};
+    /// lowest control below the target or -1 if there is none
+    dd::Qubit lowestControl{-1};
+
+    using MixKey = std::tuple<dd::Package::vNode*, dd::CTEntry*, dd::CTEntry*, dd::Package::vNode*, dd::CTEntry*, dd::CTEntry*>;
+
+    std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>         aboveCache{};
+    std::map<MixKey, std::pair<dd::Package::vEdge, dd::Package::vEdge>> mixCache{};
+
+    dd::Package::vEdge applyAbove(dd::Package::vNode* p);
+
+    std::pair<dd::Package::vEdge, dd::Package::vEdge> mix(const dd::Package::vEdge& x, const dd::Package::vEdge& y, dd::Qubit level);
+
+    dd::Package::vEdge combine(const dd::ComplexValue& a, const dd::Package::vEdge& x, const dd::ComplexValue& b, const dd::Package::vEdge& y);
+
+    dd::Package::vEdge scale(const dd::Package::vEdge& e, const dd::ComplexValue& c);
+
+    dd::Package::vEdge child(const dd::Package::vEdge& e, std::size_t i);
+
+    static dd::ComplexValue toValue(const dd::Complex& c) {
+        return {dd::CTEntry::val(c.r), dd::CTEntry::val(c.i)};
+    }
+
+    [[nodiscard]] bool isActive(dd::Qubit level, std::size_t branch) const {
+        return controlType.at(level) == 0 || (controlType.at(level) == 1) == (branch == 1);
+    }
+};
+
+#endif //DDSIM_GATEAPPLICATOR_HPP
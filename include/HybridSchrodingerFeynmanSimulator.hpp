@@ -31,6 +31,13 @@ public:
 
     std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
 
+    /// the slices always start from |0...0>
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState()) {
+            Simulator::setInitialState(state);
+        }
+    }
+
     Mode                                                   mode = Mode::Amplitude;
     [[nodiscard]] const std::vector<std::complex<dd::fp>>& getFinalAmplitudes() const { return finalAmplitudes; }
 
@@ -43,6 +50,8 @@ private:
     std::size_t                       nthreads = 2;
     std::vector<std::complex<dd::fp>> finalAmplitudes{};
 
+    /// permutes the circuit according to QubitOrdering if this reduces the number of decisions
+    void ReorderQubits(dd::Qubit split_qubit);
     void SimulateHybridTaskflow(dd::Qubit split_qubit);
     void SimulateHybridAmplitudes(dd::Qubit split_qubit);
 
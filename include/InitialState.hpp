@@ -0,0 +1,71 @@
+#ifndef DDSIM_INITIALSTATE_HPP
+#define DDSIM_INITIALSTATE_HPP
+
+#include "dd/Package.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * State a simulation starts from instead of |0...0>, given as a dense amplitude vector, a sparse map from basis indices
+ * to amplitudes or a string of single-qubit basis states (bit q of a basis index refers to qubit q).
+ *
+ * The DD is built bottom-up, i.e., in time linear in the number of (non-zero) amplitudes, with equal sub-vectors being
+ * shared by the unique table. The amplitudes are normalized on construction.
+ */
+class InitialState {
+public:
+    /// |0...0> on all qubits of the circuit
+    InitialState() = default;
+
+    static InitialState fromAmplitudes(std::vector<std::complex<dd::fp>> amplitudes);
+
+    static InitialState fromSparseAmplitudes(dd::QubitCount nqubits, const std::map<std::size_t, std::complex<dd::fp>>& amplitudes);
+
+    /// one of 0, 1, +, -, r, l (i.e., |0>, |1>, |+>, |->, |+i>, |-i>) per qubit, starting with qubit n-1 like the
+    /// measurement results
+    static InitialState fromBasisString(const std::string& basis);
+
+    [[nodiscard]] bool isZeroState() const { return kind == Kind::Zero; }
+
+    /// number of qubits of the state (0 for the zero state, which fits every circuit)
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+
+    /// the (not reference counted) DD of the state on n qubits, where qubit q is represented by level levels[q] (by
+    /// level q if levels is empty)
+    dd::Package::vEdge toDD(std::unique_ptr<dd::Package>& dd, dd::QubitCount n, const std::vector<dd::Qubit>& levels = {}) const;
+
+    [[nodiscard]] std::vector<std::complex<dd::fp>> toVector(dd::QubitCount n) const;
+
+private:
+    enum class Kind {
+        Zero,
+        Dense,
+        Sparse,
+        Basis
+    };
+
+    using SparseAmplitudes = std::vector<std::pair<std::size_t, std::complex<dd::fp>>>;
+
+    Kind           kind{Kind::Zero};
+    dd::QubitCount nqubits{0};
+
+    std::vector<std::complex<dd::fp>> dense{};
+    /// sorted by basis index
+    SparseAmplitudes             sparse{};
+    std::vector<dd::BasisStates> basis{};
+
+    void checkQubits(dd::QubitCount n) const;
+
+    static std::size_t toLevelIndex(std::size_t index, const std::vector<dd::Qubit>& levels);
+
+    static dd::Package::vEdge terminal(std::unique_ptr<dd::Package>& dd, const std::complex<dd::fp>& amplitude);
+
+    static dd::Package::vEdge buildSparse(std::unique_ptr<dd::Package>& dd, dd::Qubit level, SparseAmplitudes::const_iterator first, SparseAmplitudes::const_iterator last);
+};
+
+#endif //DDSIM_INITIALSTATE_HPP
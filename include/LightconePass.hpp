@@ -0,0 +1,30 @@
+#ifndef DDSIM_LIGHTCONEPASS_HPP
+#define DDSIM_LIGHTCONEPASS_HPP
+
+#include "QuantumComputation.hpp"
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+/**
+ * Backward-lightcone analysis of a quantum computation.
+ *
+ * Starting from the end of the circuit, the set of qubits that can influence a measurement outcome is tracked
+ * backwards. Every measurement (and thereby every bit a classically-controlled operation depends on) is part of
+ * the cone. Gates acting only on qubits outside the cone cannot change the outcome distribution and are removed.
+ * Circuits without measurements are sampled on all qubits and, hence, are left unchanged.
+ */
+class LightconePass {
+public:
+    /// determines for every operation of the circuit whether it lies in the backward lightcone of the measurements
+    [[nodiscard]] static std::vector<bool> analyze(const qc::QuantumComputation& qc);
+
+    /// removes all operations outside the lightcone and returns the number of removed operations
+    static std::size_t apply(qc::QuantumComputation& qc);
+
+    /// adds all qubits the operation (or any of its sub-operations) acts on to the given set
+    static void collectQubits(const qc::Operation& op, std::set<dd::Qubit>& qubits);
+};
+
+#endif //DDSIM_LIGHTCONEPASS_HPP
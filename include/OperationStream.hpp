@@ -0,0 +1,107 @@
+#ifndef DDSIM_OPERATIONSTREAM_HPP
+#define DDSIM_OPERATIONSTREAM_HPP
+
+#include "dd/Package.hpp"
+#include "operations/Operation.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Source of the operations of a circuit that is consumed in chunks (see StreamingSimulator), so that the circuit never
+ * has to be held in memory as a whole.
+ *
+ * The number of qubits and classical bits has to be known before the first operation. Chunks may be requested from a
+ * different thread than the one that created the stream, but never concurrently.
+ */
+class OperationStream {
+public:
+    using Chunk = std::vector<std::unique_ptr<qc::Operation>>;
+
+    OperationStream(dd::QubitCount nqubits, std::size_t ncbits, std::string name):
+        nqubits(nqubits), ncbits(ncbits), name(std::move(name)) {}
+
+    virtual ~OperationStream() = default;
+
+    /// the next (at most) max_ops operations, empty once the stream is exhausted
+    virtual Chunk nextChunk(std::size_t max_ops) = 0;
+
+    [[nodiscard]] dd::QubitCount     getNqubits() const { return nqubits; }
+    [[nodiscard]] std::size_t        getNcbits() const { return ncbits; }
+    [[nodiscard]] const std::string& getName() const { return name; }
+
+    /// operations produced by a callback until it returns nullptr
+    static std::unique_ptr<OperationStream> fromGenerator(dd::QubitCount nqubits, std::size_t ncbits, std::function<std::unique_ptr<qc::Operation>()> generator);
+
+    /// operations moved out of a range of std::unique_ptr<qc::Operation> given by input iterators
+    template<class InputIt>
+    static std::unique_ptr<OperationStream> fromRange(dd::QubitCount nqubits, std::size_t ncbits, InputIt first, InputIt last);
+
+    /// the gate statements of an OpenQASM 2.0 program (the declarations must precede the first operation)
+    static std::unique_ptr<OperationStream> fromQasm(const std::string& filename);
+    static std::unique_ptr<OperationStream> fromQasm(std::unique_ptr<std::istream>&& is, const std::string& name = "stream");
+
+protected:
+    dd::QubitCount nqubits;
+    std::size_t    ncbits;
+    std::string    name;
+};
+
+class GeneratorStream: public OperationStream {
+public:
+    GeneratorStream(dd::QubitCount nqubits, std::size_t ncbits, std::function<std::unique_ptr<qc::Operation>()> generator):
+        OperationStream(nqubits, ncbits, "stream"), generator(std::move(generator)) {}
+
+    Chunk nextChunk(std::size_t max_ops) override;
+
+private:
+    std::function<std::unique_ptr<qc::Operation>()> generator;
+    bool                                            exhausted{false};
+};
+
+/**
+ * Reads an OpenQASM 2.0 program statement by statement. The declarations (registers, includes and gate definitions) are
+ * kept, and each chunk of gate statements is parsed by the OpenQASM parser of the QFR as a program consisting of the
+ * declarations and the chunk. Since the declarations are parsed again for every chunk, chunks should be large compared
+ * to them. The initial layout and output permutation comments ('// i' and '// o') are not supported and rejected.
+ */
+class QasmStream: public OperationStream {
+public:
+    QasmStream(std::unique_ptr<std::istream>&& is, const std::string& name);
+
+    Chunk nextChunk(std::size_t max_ops) override;
+
+private:
+    std::unique_ptr<std::istream> is;
+    std::string                   declarations{};
+    /// operation statement read while looking for the end of the declarations
+    std::string pending{};
+
+    /// reads the next statement (without comments) and returns false at the end of the input
+    bool readStatement(std::string& statement);
+
+    /// whether the comment (starting after its first slash) specifies the initial layout or the output permutation
+    [[nodiscard]] static bool isLayoutComment(const std::string& comment);
+    [[nodiscard]] static bool isDeclaration(const std::string& statement);
+    [[nodiscard]] static bool isRegisterDeclaration(const std::string& statement);
+    [[nodiscard]] static std::string keyword(const std::string& statement);
+};
+
+template<class InputIt>
+std::unique_ptr<OperationStream> OperationStream::fromRange(const dd::QubitCount nqubits, const std::size_t ncbits, InputIt first, InputIt last) {
+    return fromGenerator(nqubits, ncbits, [first, last]() mutable -> std::unique_ptr<qc::Operation> {
+        if (first == last) {
+            return nullptr;
+        }
+        auto op = std::move(*first);
+        ++first;
+        return op;
+    });
+}
+
+#endif //DDSIM_OPERATIONSTREAM_HPP
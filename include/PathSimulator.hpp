@@ -63,9 +63,13 @@ public:
         // random seed
         std::size_t seed;
 
+        // remove all operations outside the backward lightcone of the measurements before determining the path.
+        // only the measured qubits are sampled in this case.
+        bool lightcone;
+
         //Add new variables here
-        explicit Configuration(Mode mode = Mode::Sequential, std::size_t bracketSize = 2, std::size_t alternatingStart = 0, std::size_t seed = 0):
-            mode(mode), bracketSize(bracketSize), alternatingStart(alternatingStart), seed(seed){};
+        explicit Configuration(Mode mode = Mode::Sequential, std::size_t bracketSize = 2, std::size_t alternatingStart = 0, std::size_t seed = 0, bool lightcone = false):
+            mode(mode), bracketSize(bracketSize), alternatingStart(alternatingStart), seed(seed), lightcone(lightcone){};
 
         static Mode modeFromString(const std::string& mode) {
             if (mode == "sequential" || mode == "0") {
@@ -111,6 +115,9 @@ public:
             if (seed != 0) {
                 conf["seed"] = seed;
             }
+            if (lightcone) {
+                conf["lightcone"] = lightcone;
+            }
             return conf;
         }
 
@@ -123,7 +130,14 @@ public:
         CircuitSimulator(std::move(qc)), executor(1) {
         if (configuration.seed != 0) {
             // override seed in case a non-trivial one is given
-            mt.seed(seed);
+            mt.seed(configuration.seed);
+        }
+
+        // the lightcone is determined by the measurements, so it has to be computed before they are removed.
+        // qubits outside the lightcone are left in an unspecified state, hence only the measured qubits are sampled.
+        if (configuration.lightcone) {
+            pruneToLightcone();
+            measurement_map = analyzeMeasurements(*(this->qc)).measurement_map;
         }
 
         // remove final measurements implement measurement support for task-based simulation
@@ -159,6 +173,13 @@ public:
 
     std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
 
+    /// the simulation path always starts from |0...0>
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState()) {
+            Simulator::setInitialState(state);
+        }
+    }
+
     const SimulationPath& getSimulationPath() const {
         return simulationPath;
     }
@@ -183,6 +204,9 @@ private:
     tf::Executor   executor{};
     SimulationPath simulationPath{};
 
+    // qubit -> classical bit of the final measurements (only populated if the circuit was pruned to its lightcone)
+    std::map<unsigned int, unsigned int> measurement_map{};
+
     void constructTaskGraph();
     void addSimulationTask(std::size_t leftID, std::size_t rightID, std::size_t resultID);
 };
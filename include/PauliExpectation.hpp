@@ -0,0 +1,61 @@
+#ifndef DDSIM_PAULIEXPECTATION_HPP
+#define DDSIM_PAULIEXPECTATION_HPP
+
+#include "DenseState.hpp"
+#include "dd/Package.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// weighted Pauli string given by one of I, X, Y, Z per qubit, starting with qubit n-1 (like the measurement results)
+struct PauliTerm {
+    dd::fp      coefficient;
+    std::string pauli;
+};
+
+/**
+ * Computes the expectation value <psi|H|psi> of a weighted sum H of Pauli strings exactly from a vector DD or a dense state.
+ *
+ * For a DD, each term P is evaluated by a single joint traversal of |psi> and P|psi>, where P only swaps (X, Y) and
+ * negates (Y, Z) the branches of the levels it acts on, i.e., P|psi> is never built. The results of the traversal are
+ * memoized per pair of nodes and Pauli string below their level, so that terms agreeing on the lower levels share their
+ * sub-results. The terms are grouped by these suffixes and distributed over the threads, each keeping its own cache.
+ */
+class PauliExpectation {
+public:
+    /// levels[q] is the level representing qubit q (level q if levels is empty)
+    PauliExpectation(dd::QubitCount nqubits, const std::vector<PauliTerm>& terms, const std::vector<dd::Qubit>& levels = {});
+
+    [[nodiscard]] dd::fp compute(const dd::Package::vEdge& state, std::size_t nthreads = 1) const;
+
+    /// the same for amplitudes indexed by level
+    [[nodiscard]] dd::fp compute(const DenseState::Amplitudes& amplitudes, std::size_t nthreads = 1) const;
+
+private:
+    struct Term {
+        dd::fp coefficient;
+        /// Pauli operator per level
+        std::vector<char> operators;
+        /// identifier of the Pauli string on levels 0, ..., l per level l
+        std::vector<std::size_t> suffixes;
+    };
+
+    /// (node of <psi|, node of P|psi>, suffix identifier) -> partial inner product
+    using Cache = std::map<std::tuple<dd::Package::vNode*, dd::Package::vNode*, std::size_t>, std::complex<dd::fp>>;
+
+    dd::QubitCount    nqubits;
+    std::vector<Term> terms{};
+
+    [[nodiscard]] static std::complex<dd::fp> innerProduct(const Term& term, dd::Package::vNode* u, dd::Package::vNode* v, dd::Qubit level, Cache& cache);
+
+    [[nodiscard]] static std::complex<dd::fp> toComplex(const dd::Complex& c) {
+        return {dd::CTEntry::val(c.r), dd::CTEntry::val(c.i)};
+    }
+};
+
+#endif //DDSIM_PAULIEXPECTATION_HPP
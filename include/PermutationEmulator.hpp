@@ -0,0 +1,85 @@
+#ifndef DDSIM_PERMUTATIONEMULATOR_HPP
+#define DDSIM_PERMUTATIONEMULATOR_HPP
+
+#include "dd/Package.hpp"
+#include "operations/Operation.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Applies classical permutations |x> -> |f(x)> of the basis states of a register directly to a vector DD, e.g., whole
+ * sections of classical reversible gates (NOT/Toffoli and Fredkin gates with any number of controls).
+ *
+ * The state is split into its slices for the register values that occur in it, i.e., the sub-DDs in which every
+ * register level only keeps the branch of the corresponding bit of x. The branches of the register levels of each slice
+ * are then moved to the bits of f(x) and the (disjoint) slices are added up again. No amplitude is computed and no matrix
+ * DD is built, and the cost grows with the number of register values occurring in the state rather than with the number
+ * of gates. f only needs to be injective on these values. As a state in superposition may contain up to 2^r register
+ * values, the slicing is aborted once more than max_slices slices have been created, and the caller has to apply the
+ * permutation otherwise (e.g., gate by gate).
+ */
+class PermutationEmulator {
+public:
+    /// NOT of a single target or SWAP of two targets, applied if all controls are satisfied
+    struct ReversibleGate {
+        dd::Controls           controls{};
+        std::vector<dd::Qubit> targets{};
+    };
+    using Netlist = std::vector<ReversibleGate>;
+
+    /// register values are limited to 64 bits
+    static constexpr std::size_t MAX_REGISTER_QUBITS = 64;
+    /// slices (over all nodes of the state) created before a permutation is aborted
+    static constexpr std::size_t DEFAULT_MAX_SLICES = 1ULL << 16U;
+
+    explicit PermutationEmulator(std::unique_ptr<dd::Package>& dd, std::size_t max_slices = DEFAULT_MAX_SLICES):
+        dd(dd), max_slices(max_slices) {}
+
+    /// returns the (not reference counted) state after applying |x> -> |f(x)> to the register given by the qubits (least
+    /// significant first), analogous to dd::Package::multiply, or nothing if the state has more than max_slices slices
+    std::optional<dd::Package::vEdge> apply(const std::vector<dd::Qubit>& qubits, const std::function<unsigned long long(unsigned long long)>& f, const dd::Package::vEdge& e);
+
+    /// the same for the permutation computed by the netlist (on the register of all qubits it acts on)
+    std::optional<dd::Package::vEdge> apply(const Netlist& netlist, const dd::Package::vEdge& e);
+
+    void                      setMaxSlices(std::size_t slices) { max_slices = slices; }
+    [[nodiscard]] std::size_t getMaxSlices() const { return max_slices; }
+
+    /// whether the operation is an X or SWAP gate (with any controls)
+    [[nodiscard]] static bool isReversibleGate(const qc::Operation& op);
+
+    [[nodiscard]] static ReversibleGate toReversibleGate(const qc::Operation& op);
+
+    /// the sorted qubits the netlist acts on
+    [[nodiscard]] static std::vector<dd::Qubit> registerOf(const Netlist& netlist);
+
+private:
+    std::unique_ptr<dd::Package>& dd;
+    std::size_t                   max_slices;
+    /// slices created by the current permutation
+    std::size_t created_slices{0};
+
+    /// register bit of each level (-1 for levels outside of the register)
+    std::vector<int> bit_of_level{};
+
+    using Slices = std::map<unsigned long long, dd::Package::vEdge>;
+
+    const Slices                                                terminal_slices{{0, dd::Package::vEdge::one}};
+    const Slices                                                no_slices{};
+    std::unordered_map<dd::Package::vNode*, Slices>             slice_cache{};
+    std::unordered_map<dd::Package::vNode*, dd::Package::vEdge> relabel_cache{};
+
+    const Slices& slices(dd::Package::vNode* p);
+
+    dd::Package::vEdge relabel(const dd::Package::vEdge& e, unsigned long long y);
+
+    dd::Package::vEdge scale(const dd::Package::vEdge& e, const dd::Complex& c);
+};
+
+#endif //DDSIM_PERMUTATIONEMULATOR_HPP
@@ -0,0 +1,88 @@
+#ifndef DDSIM_PREFIXCACHE_HPP
+#define DDSIM_PREFIXCACHE_HPP
+
+#include "ExecutionPlan.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Cache of intermediate state DDs keyed by a rolling structural hash of the (unitary) circuit prefix that produced
+ * them. Simulating a circuit that shares a prefix with a previously simulated one can resume from the deepest cached
+ * state instead of starting from scratch. As different prefixes may share a hash, every entry also keeps the operations
+ * of its prefix, which are compared before a state is returned. The cached states are pinned in the package and evicted in least recently
+ * used order once their accumulated size exceeds the node budget.
+ *
+ * Resetting the package invalidates all cached states, i.e., clear() has to be called before dd::Package::reset().
+ */
+class PrefixCache {
+public:
+    PrefixCache(std::unique_ptr<dd::Package>& dd, std::size_t max_nodes, std::size_t checkpoint_interval):
+        dd(dd), max_nodes(max_nodes), checkpoint_interval(checkpoint_interval) {}
+
+    ~PrefixCache() { clear(); }
+
+    PrefixCache(const PrefixCache&) = delete;
+    PrefixCache& operator=(const PrefixCache&) = delete;
+
+    /// hashes of all prefixes of the plan that only consist of unconditional gates (entry i covers the instructions 0..i)
+    [[nodiscard]] static std::vector<std::size_t> prefixHashes(const ExecutionPlan& plan, dd::QubitCount nqubits);
+
+    /// returns the deepest cached state (and the number of instructions it covers) matching one of the prefixes of the plan
+    std::optional<std::pair<std::size_t, dd::Package::vEdge>> lookup(const std::vector<std::size_t>& hashes, const ExecutionPlan& plan);
+
+    /// whether the state after the given number of instructions should be stored
+    [[nodiscard]] bool isCheckpoint(std::size_t depth, std::size_t prefix_length) const;
+
+    /// stores the state after the first depth instructions of the plan
+    void insert(std::size_t hash, const ExecutionPlan& plan, std::size_t depth, const dd::Package::vEdge& state);
+
+    void clear();
+
+    [[nodiscard]] std::size_t getHits() const { return hits; }
+    [[nodiscard]] std::size_t getMisses() const { return misses; }
+    [[nodiscard]] std::size_t getReusedOps() const { return reused_ops; }
+    [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+private:
+    struct Gate {
+        qc::OpType          type;
+        qc::Targets         targets;
+        dd::Controls        controls;
+        std::vector<dd::fp> parameters;
+    };
+
+    struct Entry {
+        std::vector<Gate>  gates;
+        dd::Package::vEdge state;
+        std::size_t        nodes;
+        std::size_t        last_use;
+    };
+
+    std::unique_ptr<dd::Package>&          dd;
+    std::size_t                            max_nodes;
+    std::size_t                            checkpoint_interval;
+    std::unordered_map<std::size_t, Entry> entries{};
+    std::size_t                            total_nodes{0};
+    std::size_t                            use_counter{0};
+
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t reused_ops{0};
+
+    void evict();
+
+    [[nodiscard]] static Gate describe(const qc::Operation& op);
+    [[nodiscard]] static bool matches(const std::vector<Gate>& gates, const ExecutionPlan& plan);
+
+    static void hashCombine(std::size_t& seed, std::size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+    }
+};
+
+#endif //DDSIM_PREFIXCACHE_HPP
@@ -0,0 +1,35 @@
+#ifndef DDSIM_QUBITORDERING_HPP
+#define DDSIM_QUBITORDERING_HPP
+
+#include "QuantumComputation.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Static variable order for the DD levels derived from the interaction graph of a circuit.
+ *
+ * The order is chosen such that qubits interacting often are placed on close-by levels, i.e., it heuristically
+ * minimizes the weighted linear arrangement sum_{i,j} w_ij * |level(i) - level(j)|, where w_ij is the number of
+ * operations acting on both qubits i and j. A greedy construction is refined by adjacent transpositions.
+ */
+class QubitOrdering {
+public:
+    using Weights = std::vector<std::vector<std::size_t>>;
+
+    /// computes the level of every qubit (the identity if no better order is found)
+    [[nodiscard]] static std::vector<dd::Qubit> compute(const qc::QuantumComputation& qc);
+
+    /// copy of the circuit in which qubit q is replaced by levels[q]
+    [[nodiscard]] static std::unique_ptr<qc::QuantumComputation> permute(const qc::QuantumComputation& qc, const std::vector<dd::Qubit>& levels);
+
+    [[nodiscard]] static Weights     interactionWeights(const qc::QuantumComputation& qc);
+    [[nodiscard]] static std::size_t arrangementCost(const Weights& weights, const std::vector<dd::Qubit>& levels);
+
+private:
+    static std::vector<std::size_t> greedyOrder(const Weights& weights);
+    static void                     improveOrder(const Weights& weights, std::vector<std::size_t>& order);
+};
+
+#endif //DDSIM_QUBITORDERING_HPP
@@ -0,0 +1,53 @@
+#ifndef DDSIM_REGISTERCOMPACTION_HPP
+#define DDSIM_REGISTERCOMPACTION_HPP
+
+#include "QuantumComputation.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Removes idle qubits from the simulated register.
+ *
+ * A qubit is idle if no operation other than barriers and resets (i.e., initialization to |0>) acts on it.
+ * Such qubits remain in |0> for the whole computation, so the circuit can be simulated on the remaining
+ * (active) qubits only. Afterwards, the idle qubits are re-inserted as constant |0> levels into the state DD,
+ * such that sampling, amplitude queries and the exported vector refer to the original register.
+ */
+class RegisterCompaction {
+public:
+    explicit RegisterCompaction(const qc::QuantumComputation& qc);
+
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+    [[nodiscard]] dd::QubitCount getNactive() const { return static_cast<dd::QubitCount>(active.size()); }
+    [[nodiscard]] std::size_t    getNidle() const { return nqubits - active.size(); }
+
+    /// original index of the given qubit of the compacted register
+    [[nodiscard]] dd::Qubit original(dd::Qubit qubit) const { return active.at(static_cast<std::size_t>(qubit)); }
+
+    /// copy of the circuit acting on the active qubits only
+    [[nodiscard]] std::unique_ptr<qc::QuantumComputation> compact(const qc::QuantumComputation& qc) const;
+
+    /// re-inserts the idle qubits (in |0>) into a state of the compacted register
+    [[nodiscard]] dd::Package::vEdge expand(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e) const;
+
+    /// moves the operation onto a register of the given size, where qubit q is mapped to position[q]
+    static void remap(qc::Operation& op, const std::vector<dd::Qubit>& position, dd::QubitCount nqubits);
+
+private:
+    dd::QubitCount         nqubits;
+    std::vector<dd::Qubit> active{};
+    /// position of a qubit in the compacted register (or -1 if it is idle)
+    std::vector<dd::Qubit> position{};
+
+    /// expansion of the node the edge points to (ignoring the weight of the edge)
+    dd::Package::vEdge expandNode(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>& cache) const;
+
+    static dd::Package::vEdge pad(std::unique_ptr<dd::Package>& dd, dd::Package::vEdge e, dd::Qubit lower, dd::Qubit upper);
+    static dd::Package::vEdge scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, const dd::Complex& w);
+};
+
+#endif //DDSIM_REGISTERCOMPACTION_HPP
@@ -0,0 +1,79 @@
+#ifndef DDSIM_REPEATEDBLOCKS_HPP
+#define DDSIM_REPEATEDBLOCKS_HPP
+
+#include "ExecutionPlan.hpp"
+#include "dd/Package.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Runs of structurally identical consecutive blocks of (unconditional) gates in an execution plan, e.g., Trotter
+ * steps or Grover iterations, which are applied as powers of the block operator instead of gate by gate.
+ *
+ * The powers U^(2^j) of the block operator U are computed by repeated squaring as long as they stay within the node
+ * budget, and k repetitions are applied as the product of the powers given by the binary representation of k (the
+ * largest compact power is applied repeatedly if the squaring had to stop early). Hence, O(log k) matrix
+ * multiplications replace the O(k * length) gate applications. The powers are pinned in the package until clear().
+ */
+class RepeatedBlocks {
+public:
+    struct Run {
+        std::size_t start;
+        std::size_t length;
+        std::size_t repetitions;
+    };
+
+    /// runs with fewer repetitions are simulated gate by gate
+    static constexpr std::size_t MIN_REPETITIONS = 4;
+
+    RepeatedBlocks(std::unique_ptr<dd::Package>& dd, std::size_t max_length, std::size_t max_nodes):
+        dd(dd), max_length(max_length), max_nodes(max_nodes) {}
+
+    ~RepeatedBlocks() { clear(); }
+
+    RepeatedBlocks(const RepeatedBlocks&) = delete;
+    RepeatedBlocks& operator=(const RepeatedBlocks&) = delete;
+
+    /// finds the maximal runs of blocks with at most max_length gates in the plan (replacing those of a previous plan)
+    void analyze(const ExecutionPlan& plan);
+
+    /// the run starting at the given instruction (nullptr if there is none)
+    [[nodiscard]] const Run* runAt(std::size_t start) const;
+
+    /// applies all repetitions of the run to the state; returns false (leaving the state untouched) if the block
+    /// operator itself exceeds the node budget
+    bool apply(const ExecutionPlan& plan, const Run& run, dd::Package::vEdge& state);
+
+    /// releases the powers and forgets the runs
+    void clear();
+
+    [[nodiscard]] const std::vector<Run>& getRuns() const { return runs; }
+    [[nodiscard]] std::size_t             getAppliedRuns() const { return applied_runs; }
+    [[nodiscard]] std::size_t             getSquarings() const { return squarings; }
+
+private:
+    std::unique_ptr<dd::Package>& dd;
+    std::size_t                   max_length;
+    std::size_t                   max_nodes;
+
+    std::vector<Run>                             runs{};
+    std::unordered_map<std::size_t, std::size_t> run_index{};
+    /// U^(2^j) for the block of the run starting at the key (empty if U exceeds the node budget)
+    std::unordered_map<std::size_t, std::vector<dd::Package::mEdge>> powers{};
+
+    std::size_t applied_runs{0};
+    std::size_t squarings{0};
+
+    [[nodiscard]] static bool isBlockGate(const ExecutionPlan::Instruction& instruction) {
+        return instruction.kind == ExecutionPlan::Kind::Gate && !instruction.isConditional();
+    }
+
+    [[nodiscard]] static bool sameBlock(const ExecutionPlan& plan, std::size_t first, std::size_t second, std::size_t length);
+
+    std::vector<dd::Package::mEdge> computePowers(const ExecutionPlan& plan, const Run& run);
+};
+
+#endif //DDSIM_REPEATEDBLOCKS_HPP
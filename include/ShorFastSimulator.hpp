@@ -1,6 +1,7 @@
 #ifndef DDSIM_SHORFASTSIMULATOR_HPP
 #define DDSIM_SHORFASTSIMULATOR_HPP
 
+#include "GateApplicator.hpp"
 #include "QuantumComputation.hpp"
 #include "Simulator.hpp"
 
@@ -67,6 +68,8 @@ class ShorFastSimulator: public Simulator {
 
     std::map<dd::Package::vNode*, dd::Package::vEdge> dag_edges;
 
+    GateApplicator applicator{dd};
+
 public:
     ShorFastSimulator(int composite_number, int coprime_a, bool verbose = false):
         Simulator(), n(composite_number), coprime_a(coprime_a),
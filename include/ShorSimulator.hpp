@@ -1,6 +1,7 @@
 #ifndef DDSIM_SHORSIMULATOR_HPP
 #define DDSIM_SHORSIMULATOR_HPP
 
+#include "GateApplicator.hpp"
 #include "QuantumComputation.hpp"
 #include "Simulator.hpp"
 
@@ -96,6 +97,8 @@ class ShorSimulator: public Simulator {
 
     std::map<dd::Package::vNode*, dd::Package::mEdge> dag_edges;
 
+    GateApplicator applicator{dd};
+
 public:
     ShorSimulator(int composite_number, int coprime_a):
         Simulator(), n(composite_number), coprime_a(coprime_a),
@@ -1,15 +1,22 @@
 #ifndef DDSIMULATOR_H
 #define DDSIMULATOR_H
 
+#include "DenseState.hpp"
+#include "DiagonalCost.hpp"
+#include "ExecutionPlan.hpp"
+#include "InitialState.hpp"
+#include "PauliExpectation.hpp"
 #include "dd/Package.hpp"
 
 #include <algorithm>
 #include <array>
 #include <complex>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -38,12 +45,26 @@ public:
 
     virtual std::map<std::string, std::string> AdditionalStatistics() { return {}; };
 
+    /// simulations start from the given state instead of |0...0> (not supported by all simulators)
+    virtual void setInitialState([[maybe_unused]] const InitialState& state) {
+        throw std::runtime_error("Simulator '" + getName() + "' does not support initial states.");
+    }
+
     std::string MeasureAll(bool collapse = false) {
-        return dd->measureAll(root_edge, collapse, mt, epsilon);
+        if (dense_state) {
+            return fromLevelString(dense_state->measureAll(collapse, mt));
+        }
+        return fromLevelString(dd->measureAll(root_edge, collapse, mt, epsilon));
     }
 
     std::map<std::string, std::size_t> MeasureAllNonCollapsing(unsigned int shots) {
         std::map<std::string, std::size_t> results;
+        if (dense_state) {
+            for (const auto& [outcome, count]: dense_state->sample(shots, mt)) {
+                results[fromLevelString(outcome)] += count;
+            }
+            return results;
+        }
         for (unsigned int i = 0; i < shots; i++) {
             const auto m = MeasureAll(false);
             results[m]++;
@@ -52,7 +73,38 @@ public:
     }
 
     char MeasureOneCollapsing(dd::Qubit index, bool assume_probability_normalization = true) {
-        return dd->measureOneCollapsing(root_edge, index, assume_probability_normalization, mt, epsilon);
+        if (dense_state) {
+            return dense_state->measure({toLevel(index)}, mt).front() ? '1' : '0';
+        }
+        return dd->measureOneCollapsing(root_edge, toLevel(index), assume_probability_normalization, mt, epsilon);
+    }
+
+    /// samples the given qubits jointly in a single traversal of the DD and collapses the state onto the outcome (returned in the order of the qubits)
+    static std::vector<bool> MeasureCollapsing(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+    std::vector<bool>        MeasureCollapsing(const std::vector<dd::Qubit>& qubits) {
+        if (dense_state) {
+            return dense_state->measure(toLevels(qubits), mt);
+        }
+        return MeasureCollapsing(dd, root_edge, toLevels(qubits), mt);
+    }
+
+    /// resets the given qubits to |0> by sampling their values and moving the selected branches onto the |0> successors
+    static void ResetQubits(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator);
+    void        ResetQubits(const std::vector<dd::Qubit>& qubits) {
+        if (dense_state) {
+            dense_state->reset(toLevels(qubits), mt);
+            return;
+        }
+        ResetQubits(dd, root_edge, toLevels(qubits), mt);
+    }
+
+    /// projects the state onto the given outcome of the qubits, renormalizes it and returns the probability of that outcome
+    static dd::fp PostSelect(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes);
+    dd::fp        PostSelect(const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes) {
+        if (dense_state) {
+            return dense_state->postSelect(toLevels(qubits), outcomes);
+        }
+        return PostSelect(dd, root_edge, toLevels(qubits), outcomes);
     }
 
     std::map<std::string, std::size_t> SampleFromAmplitudeVectorInPlace(std::vector<std::complex<dd::fp>>& amplitudes, unsigned int shots);
@@ -63,6 +115,15 @@ public:
 
     [[nodiscard]] std::vector<std::complex<dd::fp>> getVectorComplex() const;
 
+    /// exact expectation value of the weighted sum of Pauli strings in the current state (see PauliExpectation)
+    [[nodiscard]] dd::fp expectationValue(const std::vector<PauliTerm>& observable, std::size_t nthreads = 1) const;
+
+    /// exact expectation value of the classical cost of the measurement results of the current state (see DiagonalCost)
+    [[nodiscard]] dd::fp expectationValue(const DiagonalCost& cost) const;
+
+    /// CVaR_alpha of the cost of the measurement results (the most probable max_outcomes outcomes are considered for DDs)
+    [[nodiscard]] DiagonalCost::CVaR conditionalValueAtRisk(const DiagonalCost& cost, dd::fp alpha, std::size_t max_outcomes = DiagonalCost::DEFAULT_MAX_OUTCOMES) const;
+
     [[nodiscard]] std::size_t getActiveNodeCount() const { return dd->vUniqueTable.getActiveNodeCount(); }
 
     [[nodiscard]] virtual std::size_t getMaxNodeCount() const { return dd->vUniqueTable.getMaxActiveNodes(); }
@@ -79,6 +140,24 @@ public:
 
     [[nodiscard]] virtual std::string getName() const = 0;
 
+    /// classification of the non-unitary operations of a circuit
+    struct MeasurementInfo {
+        bool has_nonmeasurement_nonunitary = false;
+        bool has_measurements              = false;
+        bool measurements_last             = true;
+        /// measured qubit -> classical bit
+        std::map<unsigned int, unsigned int> measurement_map{};
+
+        /// a single run suffices for all shots if the only non-unitaries are final measurements
+        [[nodiscard]] bool singleRun() const { return !has_nonmeasurement_nonunitary && (!has_measurements || measurements_last); }
+    };
+
+    [[nodiscard]] static MeasurementInfo analyzeMeasurements(const qc::QuantumComputation& qc);
+
+    /// maps counts of measurement results over all qubits (qubit n-1 first) onto the classical bits given by a map from
+    /// the measured qubits to their classical bits
+    [[nodiscard]] static std::map<std::string, std::size_t> toClassicalCounts(const std::map<std::string, std::size_t>& counts, const std::map<unsigned int, unsigned int>& measurement_map, std::size_t n_qubits, std::size_t n_cbits);
+
     [[nodiscard]] static inline std::string toBinaryString(std::size_t m, dd::QubitCount nq) {
         std::string binary(nq, '0');
         for (std::size_t j = 0; j < nq; ++j) {
@@ -110,7 +189,49 @@ protected:
     const bool               has_fixed_seed;
     const dd::fp             epsilon = 0.001L;
 
+    InitialState initial_state{};
+
+    /// dense representation of the state, which replaces root_edge if set
+    std::unique_ptr<DenseState> dense_state{};
+
+    /// DD level representing each qubit (empty if qubit q is represented by level q)
+    std::vector<dd::Qubit> qubit_levels{};
+
+    [[nodiscard]] dd::Qubit              toLevel(dd::Qubit qubit) const { return qubit_levels.empty() ? qubit : qubit_levels.at(static_cast<std::size_t>(qubit)); }
+    [[nodiscard]] std::vector<dd::Qubit> toLevels(const std::vector<dd::Qubit>& qubits) const;
+    /// converts a path, where path[q] refers to qubit q, into one where path[l] refers to level l
+    [[nodiscard]] std::size_t toLevelIndex(std::size_t index) const;
+    [[nodiscard]] std::string toLevelPath(const std::string& qubit_path) const;
+    /// converts a measurement string (with level n-1 first) into one with qubit n-1 first
+    [[nodiscard]] std::string fromLevelString(const std::string& level_string) const;
+
     static void NextPath(std::string& s);
+
+    /// runs the shots, where single_shot(ignore_nonunitaries) simulates the circuit once and returns the classical bits
+    std::map<std::string, std::size_t> runShots(const MeasurementInfo& info, std::size_t n_qubits, std::size_t n_cbits, unsigned int shots, const std::function<ExecutionPlan::ClassicalBits(bool)>& single_shot);
+
+    /// exchanges the package and the (final) state with another simulator
+    void exchangeState(Simulator& other) {
+        std::swap(dd, other.dd);
+        std::swap(root_edge, other.root_edge);
+        std::swap(dense_state, other.dense_state);
+        std::swap(qubit_levels, other.qubit_levels);
+    }
+
+    /// outcome per level for projections: not involved, fixed to 0/1 or still to be sampled
+    static constexpr signed char NOT_INVOLVED = -1;
+    static constexpr signed char TO_SAMPLE    = 2;
+
+    static std::vector<signed char> InvolvedLevels(const dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits);
+
+    /// samples all levels marked as TO_SAMPLE (requires a generator) and returns the probability of the (sampled and fixed) outcome
+    static dd::fp SelectOutcome(const dd::Package::vEdge& edge, std::vector<signed char>& outcomes, std::mt19937_64* generator);
+
+    /// projects the state onto the outcome (optionally moving it to |0>) and renormalizes it
+    static void Project(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<signed char>& outcomes, bool moveToZero, dd::fp probability);
+
+    static dd::Package::vEdge ProjectNode(std::unique_ptr<dd::Package>& localDD, const dd::Package::vEdge& e, const std::vector<signed char>& outcomes, bool moveToZero, dd::Qubit lowest,
+                                          std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>& computed);
 };
 
 #endif //DDSIMULATOR_H
@@ -0,0 +1,94 @@
+#ifndef DDSIM_STABILIZERTABLEAU_HPP
+#define DDSIM_STABILIZERTABLEAU_HPP
+
+#include "dd/Package.hpp"
+#include "operations/Operation.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Stabilizer tableau (Aaronson and Gottesman, "Improved simulation of stabilizer circuits") for Clifford circuits.
+ *
+ * Rows 0..n-1 hold the destabilizers, rows n..2n-1 the stabilizers and row 2n is used as scratch space. A row with
+ * both the x and the z bit of a qubit set denotes Y on that qubit. As the tableau only determines the state up to a
+ * global phase, the phase of the amplitude of a reference basis state in the support of the state is tracked as well.
+ * To update it in O(n) per H gate, the X parts of the stabilizers are kept in a reduced form, which every gate restores
+ * in O(n^2).
+ */
+class StabilizerTableau {
+public:
+    explicit StabilizerTableau(dd::QubitCount nqubits);
+
+    /// whether the operation is a Clifford gate supported by apply (single-qubit Cliffords, CX, CY, CZ and SWAP, as well
+    /// as phase and RZ rotations by multiples of pi/2)
+    [[nodiscard]] static bool isClifford(const qc::Operation& op);
+
+    void apply(const qc::Operation& op);
+
+    void h(dd::Qubit q);
+    void s(dd::Qubit q);
+    void sdg(dd::Qubit q);
+    void x(dd::Qubit q);
+    void y(dd::Qubit q);
+    void z(dd::Qubit q);
+    void cx(dd::Qubit control, dd::Qubit target);
+
+    /// measures the qubit in the computational basis; random outcomes are resolved to the preferred value
+    bool measure(dd::Qubit q, bool preferred = false);
+
+    /// builds the vector DD of the stabilizer state (including its global phase) by projecting the reference basis
+    /// state onto the state (the returned edge is not reference counted)
+    [[nodiscard]] dd::Package::vEdge toDD(std::unique_ptr<dd::Package>& dd) const;
+
+    [[nodiscard]] dd::QubitCount getNqubits() const { return nqubits; }
+
+private:
+    using PauliCache = std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>;
+
+    dd::QubitCount                 nqubits;
+    std::vector<std::vector<bool>> xs;
+    std::vector<std::vector<bool>> zs;
+    std::vector<bool>              rs;
+    /// stabilizer row that is the only one with an X part on the qubit (2n if there is none); the stabilizers that are
+    /// not a pivot have no X part at all
+    std::vector<std::size_t> pivots;
+
+    /// basis state with non-zero amplitude and the phase of its amplitude
+    std::vector<bool>    reference;
+    std::complex<dd::fp> phase{1., 0.};
+
+    /// amplitude of the reference with the given qubit flipped, relative to the amplitude of the reference
+    [[nodiscard]] std::complex<dd::fp> relativeAmplitude(dd::Qubit q) const;
+
+    /// factor c with P|reference> = c|reference ^ x>, where P is the Pauli string of the row and x its X part
+    [[nodiscard]] std::complex<dd::fp> rowPhase(std::size_t row) const;
+
+    /// k in 0..3 if the angle is k pi/2 modulo 2 pi, -1 otherwise
+    [[nodiscard]] static int quarterTurns(dd::fp angle);
+
+    /// multiplies row h by row i (row h <- row i * row h)
+    void rowsum(std::size_t h, std::size_t i);
+
+    /// multiplies stabilizer h by stabilizer i and updates the destabilizers such that they still pair up
+    void combineStabilizers(std::size_t h, std::size_t i);
+
+    /// qubit whose pivot is the given stabilizer row (n if there is none)
+    [[nodiscard]] std::size_t pivotColumn(std::size_t row) const;
+
+    /// makes the qubit, on which the stabilizer row has an X part, the pivot of the row
+    void makePivot(std::size_t row, std::size_t col);
+
+    /// restores the reduced form after the X parts of the stabilizers on the qubit changed
+    void restorePivots(std::size_t col);
+
+    /// applies the Pauli string of the given row to the state
+    [[nodiscard]] dd::Package::vEdge applyRow(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, std::size_t row, PauliCache& cache) const;
+
+    static dd::Package::vEdge scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, dd::fp r, dd::fp i);
+};
+
+#endif //DDSIM_STABILIZERTABLEAU_HPP
@@ -0,0 +1,65 @@
+#ifndef DDSIM_STATEVECTORSIMULATOR_HPP
+#define DDSIM_STATEVECTORSIMULATOR_HPP
+
+#include "DenseState.hpp"
+#include "ExecutionPlan.hpp"
+#include "QuantumComputation.hpp"
+#include "Simulator.hpp"
+#include "taskflow/taskflow.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * Simulator storing the full state vector as a dense array (see DenseState).
+ *
+ * Intended for dense circuits with up to ~32 qubits, where a DD does not pay off. Gates with one or two targets are
+ * applied by the dense gate kernels, only gates with more targets are applied via their matrix DD.
+ */
+class StateVectorSimulator: public Simulator {
+public:
+    explicit StateVectorSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_):
+        qc(std::move(qc_)), nthreads(1), executor(1) {
+        dd->resize(qc->getNqubits());
+    }
+
+    StateVectorSimulator(std::unique_ptr<qc::QuantumComputation>&& qc_, const unsigned long long seed, const std::size_t nthreads = 1):
+        Simulator(seed), qc(std::move(qc_)), nthreads(nthreads), executor(nthreads) {
+        dd->resize(qc->getNqubits());
+    }
+
+    std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
+
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState() && state.getNqubits() != qc->getNqubits()) {
+            throw std::runtime_error("The initial state has " + std::to_string(state.getNqubits()) + " qubits, but the circuit has " + std::to_string(qc->getNqubits()) + ".");
+        }
+        initial_state = state;
+    }
+
+    std::map<std::string, std::string> AdditionalStatistics() override {
+        return {
+                {"single_shots", std::to_string(single_shots)},
+                {"threads", std::to_string(nthreads)},
+                {"simd", DenseState::getSimdExtension()},
+        };
+    };
+
+    [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return qc->getNqubits(); };
+
+    [[nodiscard]] std::size_t getNumberOfOps() const override { return qc->getNops(); };
+
+    [[nodiscard]] std::string getName() const override { return qc->getName(); };
+
+protected:
+    std::unique_ptr<qc::QuantumComputation> qc;
+    std::size_t                             single_shots{0};
+    std::size_t                             nthreads;
+    tf::Executor                            executor;
+
+    ExecutionPlan::ClassicalBits single_shot(const ExecutionPlan& plan, bool ignore_nonunitaries);
+};
+
+#endif //DDSIM_STATEVECTORSIMULATOR_HPP
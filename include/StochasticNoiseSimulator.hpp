@@ -1,6 +1,8 @@
 #ifndef DDSIM_STOCHASTICNOISESIMULATOR_HPP
 #define DDSIM_STOCHASTICNOISESIMULATOR_HPP
 
+#include "ExecutionPlan.hpp"
+#include "GarbageCollectionPolicy.hpp"
 #include "QuantumComputation.hpp"
 #include "Simulator.hpp"
 
@@ -52,9 +54,14 @@ public:
                 {"stoch_wall_time", std::to_string(stoch_run_time)},
                 {"mean_stoch_run_time", std::to_string(mean_stoch_time)},
                 {"parallel_instances", std::to_string(max_instances)},
+                {"gc_calls", std::to_string(gc_policy.getCalls())},
+                {"gc_runs", std::to_string(gc_policy.getRuns())},
+                {"gc_time", std::to_string(gc_policy.getTime())},
         };
     };
 
+    void setGarbageCollectionInfo(const GarbageCollectionInfo& gc_info) { gc_policy = GarbageCollectionPolicy(gc_info); }
+
     [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return qc->getNqubits(); };
 
     [[nodiscard]] std::size_t getNumberOfOps() const override { return qc->getNops(); };
@@ -99,13 +106,16 @@ private:
     float  stoch_run_time{0};
     double mean_stoch_time{0};
 
-    void perfect_simulation_run();
+    GarbageCollectionPolicy gc_policy{};
+
+    void perfect_simulation_run(const ExecutionPlan& plan);
 
     void runStochSimulationForId(unsigned int                                stochRun,
                                  int                                         n_qubits,
                                  dd::Package::vEdge                          rootEdgePerfectRun,
                                  std::vector<double>&                        recordedPropertiesStorage,
                                  std::vector<std::tuple<long, std::string>>& recordedPropertiesList,
+                                 GarbageCollectionPolicy&                    localGcPolicy,
                                  unsigned long long                          localSeed);
 
     dd::Package::mEdge generateNoiseOperation(bool                                    amplitudeDamping,
@@ -115,8 +125,7 @@ private:
                                               dd::Package::mEdge                      dd_operation,
                                               std::unique_ptr<dd::Package>&           localDD);
 
-    void applyNoiseOperation(const qc::Targets&                      targets,
-                             const dd::Controls&                     control_qubits,
+    void applyNoiseOperation(const std::vector<dd::Qubit>&           usedQubits,
                              dd::Package::mEdge                      dd_op,
                              std::unique_ptr<dd::Package>&           localDD,
                              dd::Package::vEdge&                     localRootEdge,
@@ -131,7 +140,6 @@ private:
     //    double ApproximateEdgeByFidelity(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, double targetFidelity, bool allLevels, bool removeNodes);
     //
     //    dd::Package::vEdge RemoveNodesInPackage(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge e, std::map<dd::Package::vNode*, dd::Package::vEdge>& dag_edges);
-    void setMeasuredQubitToZero(dd::Qubit& at, dd::Package::vEdge& e, std::unique_ptr<dd::Package>& localDD);
 };
 
 #endif //DDSIM_STOCHASTICNOISESIMULATOR_HPP
@@ -0,0 +1,96 @@
+#ifndef DDSIM_STREAMINGSIMULATOR_HPP
+#define DDSIM_STREAMINGSIMULATOR_HPP
+
+#include "GarbageCollectionPolicy.hpp"
+#include "GateApplicator.hpp"
+#include "OperationStream.hpp"
+#include "Simulator.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Simulates a circuit while it is read from an OperationStream, i.e., without materializing the circuit.
+ *
+ * The operations are pulled in chunks of at most chunk_size operations, applied and discarded; the next chunk is read on
+ * a separate thread while the current one is simulated. Hence, the memory for the circuit is bounded by two chunks. Since
+ * the stream can only be consumed once, there is only a single run, which supports gates and measurements (that are
+ * sampled at the end, i.e., measured qubits must not be acted upon afterwards), but no resets or classically controlled
+ * operations.
+ */
+class StreamingSimulator: public Simulator {
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1024;
+
+    explicit StreamingSimulator(std::unique_ptr<OperationStream>&& stream_, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE):
+        stream(std::move(stream_)), chunk_size(chunk_size) {
+        checkChunkSize();
+        dd->resize(stream->getNqubits());
+    }
+
+    StreamingSimulator(std::unique_ptr<OperationStream>&& stream_, const unsigned long long seed, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE):
+        Simulator(seed), stream(std::move(stream_)), chunk_size(chunk_size) {
+        checkChunkSize();
+        dd->resize(stream->getNqubits());
+    }
+
+    std::map<std::string, std::size_t> Simulate(unsigned int shots) override;
+
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState() && state.getNqubits() != stream->getNqubits()) {
+            throw std::runtime_error("The initial state has " + std::to_string(state.getNqubits()) + " qubits, but the circuit has " + std::to_string(stream->getNqubits()) + ".");
+        }
+        initial_state = state;
+    }
+
+    void setGarbageCollectionInfo(const GarbageCollectionInfo& gc_info) { gc_policy = GarbageCollectionPolicy(gc_info); }
+
+    std::map<std::string, std::string> AdditionalStatistics() override {
+        return {
+                {"chunk_size", std::to_string(chunk_size)},
+                {"chunks", std::to_string(chunks)},
+                {"stream_wait_time", std::to_string(wait_time)},
+                {"gc_calls", std::to_string(gc_policy.getCalls())},
+                {"gc_runs", std::to_string(gc_policy.getRuns())},
+                {"gc_time", std::to_string(gc_policy.getTime())},
+        };
+    };
+
+    [[nodiscard]] dd::QubitCount getNumberOfQubits() const override { return stream->getNqubits(); };
+
+    /// number of operations read from the stream so far
+    [[nodiscard]] std::size_t getNumberOfOps() const override { return nops; };
+
+    [[nodiscard]] std::string getName() const override { return stream->getName(); };
+
+protected:
+    std::unique_ptr<OperationStream> stream;
+    std::size_t                      chunk_size;
+    bool                             consumed{false};
+
+    GateApplicator          applicator{dd};
+    GarbageCollectionPolicy gc_policy{};
+
+    std::size_t nops{0};
+    std::size_t chunks{0};
+    /// time the simulation waited for the stream (in seconds)
+    double wait_time{0.};
+
+    /// measured qubit of each classical bit
+    std::map<std::size_t, dd::Qubit> measurements{};
+    std::vector<bool>                measured{};
+
+    void checkChunkSize() const {
+        if (chunk_size == 0) {
+            throw std::runtime_error("The chunk size must be positive.");
+        }
+    }
+
+    void apply(const qc::Operation& op);
+};
+
+#endif //DDSIM_STREAMINGSIMULATOR_HPP
@@ -29,6 +29,13 @@ public:
 
     void Construct();
 
+    /// the unitary does not depend on the initial state
+    void setInitialState(const InitialState& state) override {
+        if (!state.isZeroState()) {
+            Simulator::setInitialState(state);
+        }
+    }
+
     [[nodiscard]] Mode         getMode() const { return mode; }
     [[nodiscard]] qc::MatrixDD getConstructedDD() const { return e; }
     [[nodiscard]] double       getConstructionTime() const { return constructionTime; }
@@ -0,0 +1,83 @@
+"""Backend for DDSIM selecting the simulation engine automatically."""
+
+import logging
+import time
+
+from qiskit.providers import Options
+from qiskit.providers.models import BackendConfiguration
+from qiskit.qobj import QasmQobjExperiment
+from qiskit.utils.multiprocessing import local_hardware_info
+
+from mqt import ddsim
+from mqt.ddsim.qasmsimulator import QasmSimulator
+
+logger = logging.getLogger(__name__)
+
+
+class AutoSimulator(QasmSimulator):
+    """Python interface to MQT DDSIM dispatching every circuit to the engine predicted to be fastest"""
+
+    @classmethod
+    def _default_options(cls) -> Options:
+        return Options(
+            shots=None,
+            parameter_binds=None,
+            simulator_seed=None,
+            nthreads=local_hardware_info()['cpus'],
+        )
+
+    def __init__(self, configuration=None, provider=None):
+        conf = {
+            'backend_name': 'auto_simulator',
+            'backend_version': ddsim.__version__,
+            'url': 'https://github.com/cda-tum/ddsim',
+            'simulator': True,
+            'local': True,
+            'description': 'MQT DDSIM C++ simulator with automatic engine selection',
+            'basis_gates': ['id', 'u0', 'u1', 'u2', 'u3', 'cu3',
+                            'x', 'cx', 'ccx', 'mcx_gray', 'mcx_recursive', 'mcx_vchain',
+                            'y', 'cy',
+                            'z', 'cz',
+                            'h', 'ch',
+                            's', 'sdg', 't', 'tdg',
+                            'rx', 'crx', 'mcrx',
+                            'ry', 'cry', 'mcry',
+                            'rz', 'crz', 'mcrz',
+                            'p', 'cp', 'cu1', 'mcphase',
+                            'sx', 'csx', 'sxdg',
+                            'swap', 'cswap', 'iswap',
+                            'reset', 'snapshot'],
+            'memory': False,
+            'n_qubits': 64,
+            'coupling_map': None,
+            'conditional': False,
+            'max_shots': 1000000000,
+            'open_pulse': False,
+            'gates': []
+        }
+        super().__init__(configuration=configuration or BackendConfiguration.from_dict(conf), provider=provider)
+
+    def run_experiment(self, qobj_experiment: QasmQobjExperiment, **options):
+        start_time = time.time()
+        seed = options.get('seed', -1)
+        nthreads = int(options.get('nthreads', local_hardware_info()['cpus']))
+        sim = ddsim.AutoCircuitSimulator(qobj_experiment, seed, nthreads)
+        logger.info('Simulating %s with the %s engine: %s', qobj_experiment.header.name, sim.get_engine(),
+                    sim.statistics()['engine_reason'])
+
+        shots = options.get('shots', 1024)
+        counts = sim.simulate(shots)
+        end_time = time.time()
+        counts_hex = {hex(int(result, 2)): count for result, count in counts.items()}
+
+        result = {'header': qobj_experiment.header.to_dict(),
+                  'name': qobj_experiment.header.name,
+                  'status': 'DONE',
+                  'time_taken': end_time - start_time,
+                  'seed': seed,
+                  'shots': shots,
+                  'engine': sim.get_engine(),
+                  'data': {'counts': counts_hex},
+                  'success': True,
+                  }
+        return result
@@ -3,9 +3,13 @@
  * See file README.md or go to https://iic.jku.at/eda/research/quantum/ for more information.
  */
 // clang-format off
+#include "AdjointSimulator.hpp"
+#include "AutoSimulator.hpp"
+#include "BatchSimulator.hpp"
 #include "CircuitSimulator.hpp"
 #include "HybridSchrodingerFeynmanSimulator.hpp"
 #include "PathSimulator.hpp"
+#include "StateVectorSimulator.hpp"
 #include "UnitarySimulator.hpp"
 #include "qiskit/QasmQobjExperiment.hpp"
 #include "qiskit/QuantumCircuit.hpp"
@@ -17,6 +21,8 @@
 // clang-format on
 
 #include <memory>
+#include <random>
+#include <sstream>
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -42,6 +48,10 @@ std::unique_ptr<Simulator> create_simulator(const py::object& circ, const long l
     if constexpr (std::is_same_v<Simulator, PathSimulator>) {
         return std::make_unique<Simulator>(std::move(qc),
                                            std::forward<Args>(args)...);
+    } else if constexpr (std::is_same_v<Simulator, StateVectorSimulator> || std::is_same_v<Simulator, AutoSimulator> || std::is_same_v<Simulator, BatchSimulator> || std::is_same_v<Simulator, AdjointSimulator>) {
+        // these simulators do not approximate and take further arguments only after a seed (which is drawn randomly if not given)
+        const auto fixed_seed = seed < 0 ? static_cast<unsigned long long>(std::random_device{}()) : static_cast<unsigned long long>(seed);
+        return std::make_unique<Simulator>(std::move(qc), fixed_seed, std::forward<Args>(args)...);
     } else {
         if (seed < 0) {
             return std::make_unique<Simulator>(std::move(qc),
@@ -60,6 +70,52 @@ std::unique_ptr<Simulator> create_simulator_without_seed(const py::object& circ,
     return create_simulator<Simulator>(circ, -1, std::forward<Args>(args)...);
 }
 
+InitialState to_initial_state(const dd::QubitCount nqubits, const py::object& state) {
+    if (py::isinstance<py::str>(state)) {
+        return InitialState::fromBasisString(state.cast<std::string>());
+    }
+    if (py::isinstance<py::dict>(state)) {
+        return InitialState::fromSparseAmplitudes(nqubits, state.cast<std::map<std::size_t, std::complex<dd::fp>>>());
+    }
+    const auto amplitudes = py::array_t<std::complex<dd::fp>, py::array::c_style | py::array::forcecast>::ensure(state);
+    if (!amplitudes || amplitudes.ndim() != 1) {
+        throw std::runtime_error("The initial state must be a basis string, a dict of amplitudes or a one-dimensional array of amplitudes.");
+    }
+    return InitialState::fromAmplitudes({amplitudes.data(), amplitudes.data() + amplitudes.size()});
+}
+
+template<class Simulator>
+void set_initial_state(Simulator& sim, const py::object& state) {
+    sim.setInitialState(to_initial_state(sim.getNumberOfQubits(), state));
+}
+
+template<class Simulator>
+void set_garbage_collection(Simulator& sim, const std::string& mode, const std::size_t every_k, const double threshold) {
+    GarbageCollectionInfo::CollectWhen when{};
+    std::istringstream(mode) >> when;
+    sim.setGarbageCollectionInfo(GarbageCollectionInfo(when, every_k, threshold));
+}
+
+std::vector<PauliTerm> to_pauli_terms(const py::object& observable) {
+    // Pauli strings with (real) coefficients as a dict or as a list of pairs, e.g., from SparsePauliOp.to_list()
+    const auto terms = py::isinstance<py::dict>(observable) ? observable.cast<py::dict>().attr("items")() : observable;
+
+    std::vector<PauliTerm> pauli_terms{};
+    for (const auto& term: terms) {
+        const auto pair = term.cast<py::tuple>();
+        if (pair.size() != 2) {
+            throw std::runtime_error("The observable must be given as pairs of a Pauli string and its coefficient.");
+        }
+        pauli_terms.push_back({pair[1].cast<std::complex<dd::fp>>().real(), pair[0].cast<std::string>()});
+    }
+    return pauli_terms;
+}
+
+template<class Simulator>
+dd::fp expectation_value(const Simulator& sim, const py::object& observable, const std::size_t nthreads) {
+    return sim.expectationValue(to_pauli_terms(observable), nthreads);
+}
+
 void getNumpyMatrixRec(const qc::MatrixDD& e, const std::complex<dd::fp>& amp, std::size_t i, std::size_t j, std::size_t dim, std::complex<dd::fp>* mat) {
     // calculate new accumulated amplitude
     auto w = std::complex<dd::fp>{dd::CTEntry::val(e.w.r), dd::CTEntry::val(e.w.i)};
@@ -125,6 +181,31 @@ void dump_tensor_network(const py::object& circ, const std::string& filename) {
 PYBIND11_MODULE(pyddsim, m) {
     m.doc() = "Python interface for the MQT DDSIM quantum circuit simulator";
 
+    py::enum_<EmulatedOperation::Kind>(m, "EmulatedOperationKind")
+            .value("qft", EmulatedOperation::Kind::QFT)
+            .value("inverse_qft", EmulatedOperation::Kind::InverseQFT)
+            .value("add_constant", EmulatedOperation::Kind::AddConstant)
+            .value("add_register", EmulatedOperation::Kind::AddRegister)
+            .value("multiply_modulo", EmulatedOperation::Kind::MultiplyModulo)
+            .value("less_than", EmulatedOperation::Kind::LessThan)
+            .export_values();
+
+    py::class_<DiagonalCost>(m, "DiagonalCost",
+                             R"pbdoc(Classical cost function of the measured bits with linear and quadratic terms, e.g., of a QUBO or an Ising model)pbdoc")
+            .def(py::init<dd::QubitCount, dd::fp>(), "nqubits"_a, "offset"_a = 0.)
+            .def_static("from_ising", &DiagonalCost::fromIsing, "nqubits"_a, "h"_a, "J"_a, "offset"_a = 0.,
+                        R"pbdoc(offset + sum_i h[i] z_i + sum_{(i, j)} J[(i, j)] z_i z_j with the spins z_q = 1 - 2 x_q)pbdoc")
+            .def_static("from_qubo", &DiagonalCost::fromQubo, "nqubits"_a, "Q"_a, "offset"_a = 0.,
+                        R"pbdoc(offset + sum_{(i, j)} Q[(i, j)] x_i x_j)pbdoc")
+            .def("add_linear", &DiagonalCost::addLinear, "qubit"_a, "coefficient"_a)
+            .def("add_quadratic", &DiagonalCost::addQuadratic, "first"_a, "second"_a, "coefficient"_a)
+            .def("evaluate", &DiagonalCost::evaluate, "outcome"_a);
+
+    py::class_<DiagonalCost::CVaR>(m, "CVaR")
+            .def_readonly("value", &DiagonalCost::CVaR::value)
+            .def_readonly("covered_probability", &DiagonalCost::CVaR::covered_probability)
+            .def_readonly("outcomes", &DiagonalCost::CVaR::outcomes);
+
     py::class_<CircuitSimulator>(m, "CircuitSimulator")
             .def(py::init<>(&create_simulator<CircuitSimulator>), "circ"_a, "seed"_a)
             .def(py::init<>(&create_simulator_without_seed<CircuitSimulator>), "circ"_a)
@@ -132,7 +213,140 @@ PYBIND11_MODULE(pyddsim, m) {
             .def("get_name", &CircuitSimulator::getName)
             .def("simulate", &CircuitSimulator::Simulate, "shots"_a)
             .def("statistics", &CircuitSimulator::AdditionalStatistics)
-            .def("get_vector", &CircuitSimulator::getVectorComplex);
+            .def("get_vector", &CircuitSimulator::getVectorComplex)
+            .def("expectation_value", &expectation_value<CircuitSimulator>, "observable"_a, "nthreads"_a = 1,
+                 R"pbdoc(Exact expectation value of a sum of Pauli strings (qubit n-1 first) with real coefficients, given as a dict or a list of pairs, in the final state)pbdoc")
+            .def("cost_expectation", py::overload_cast<const DiagonalCost&>(&CircuitSimulator::expectationValue, py::const_), "cost"_a,
+                 R"pbdoc(Exact expectation value of the cost of the measurement results of the final state)pbdoc")
+            .def("cost_cvar", &CircuitSimulator::conditionalValueAtRisk, "cost"_a, "alpha"_a, "max_outcomes"_a = DiagonalCost::DEFAULT_MAX_OUTCOMES,
+                 R"pbdoc(CVaR of the cost over the (at most max_outcomes) most probable measurement results of the final state)pbdoc")
+            .def("set_initial_state", &set_initial_state<CircuitSimulator>, "state"_a,
+                 R"pbdoc(Start from the given state instead of |0...0>: a basis string (one of 0, 1, +, -, r, l per qubit, starting with the last qubit), a dict from basis indices to amplitudes or an array of all amplitudes)pbdoc")
+            .def("set_post_selection", &CircuitSimulator::setPostSelection, "values"_a,
+                 R"pbdoc(Post-select measurements writing to the given classical bits onto the given values instead of sampling them)pbdoc")
+            .def("get_post_selection_probability", &CircuitSimulator::getPostSelectionProbability)
+            .def("prune_to_lightcone", &CircuitSimulator::pruneToLightcone,
+                 R"pbdoc(Remove all operations outside the backward lightcone of the measurements and return their number)pbdoc")
+            .def("set_idle_qubit_elimination", &CircuitSimulator::setIdleQubitElimination, "enable"_a,
+                 R"pbdoc(Simulate only the qubits that are acted upon and re-insert the idle ones in the final state)pbdoc")
+            .def("set_factorization", &CircuitSimulator::setFactorization, "enable"_a,
+                 R"pbdoc(Keep unentangled groups of qubits in separate DDs until a gate entangles them)pbdoc")
+            .def("set_qubit_reordering", &CircuitSimulator::setQubitReordering, "enable"_a,
+                 R"pbdoc(Simulate with a qubit order derived from the interaction graph of the circuit)pbdoc")
+            .def("set_dense_switch", &CircuitSimulator::setDenseSwitch, "node_ratio"_a, "max_qubits"_a = 28,
+                 R"pbdoc(Continue on a dense state vector once the DD has more than node_ratio * 2^n nodes)pbdoc")
+            .def("set_stabilizer_prefix", &CircuitSimulator::setStabilizerPrefix, "enable"_a,
+                 R"pbdoc(Simulate the leading Clifford gates with a stabilizer tableau (the state agrees up to a global phase))pbdoc")
+            .def("set_deadline", &CircuitSimulator::setDeadline, "seconds"_a, "min_step_fidelity"_a = 0.9,
+                 R"pbdoc(Approximate the state whenever the simulation is projected to take longer than the deadline (the fidelity of the worst shot is included in final_fidelity, the mean over the shots is reported as deadline_mean_fidelity))pbdoc")
+            .def("clear_deadline", &CircuitSimulator::clearDeadline)
+            .def("set_garbage_collection", &set_garbage_collection<CircuitSimulator>, "mode"_a, "every_k"_a = 1, "threshold"_a = 0.5,
+                 R"pbdoc(Collect garbage by the package's own limits ('default'), every every_k operations ('every'), once the fraction of dead nodes exceeds threshold ('dead_ratio'), once the tables grew by threshold MiB since the last collection ('memory') or only after measurements and resets ('measurements'))pbdoc")
+            .def("enable_dynamic_reordering", &CircuitSimulator::enableDynamicReordering, "growth_factor"_a,
+                 R"pbdoc(Sift the levels of the state DD whenever its size grows by the given factor since the last sifting)pbdoc")
+            .def("disable_dynamic_reordering", &CircuitSimulator::disableDynamicReordering)
+            .def("enable_block_exponentiation", &CircuitSimulator::enableBlockExponentiation, "max_block_length"_a, "max_nodes"_a = 1U << 14U,
+                 R"pbdoc(Apply runs of identical consecutive blocks of gates as powers of the block operator computed by repeated squaring)pbdoc")
+            .def("disable_block_exponentiation", &CircuitSimulator::disableBlockExponentiation)
+            .def("set_permutation_emulation", &CircuitSimulator::setPermutationEmulation, "min_gates"_a, "max_slices"_a = PermutationEmulator::DEFAULT_MAX_SLICES,
+                 R"pbdoc(Apply sections of at least min_gates consecutive X and SWAP gates (with any controls) as one permutation of the basis states (0 = disable), unless the state has more than max_slices slices)pbdoc")
+            .def(
+                    "add_emulation", [](CircuitSimulator& sim, std::size_t first_op, std::size_t nops, EmulatedOperation::Kind kind, const std::vector<dd::Qubit>& qubits, const std::vector<dd::Qubit>& other, unsigned long long constant, unsigned long long modulus, const std::vector<dd::Qubit>& controls) {
+                        EmulatedOperation operation{kind, qubits, other, constant, modulus, {}};
+                        for (const auto control: controls) {
+                            operation.controls.insert(dd::Control{control});
+                        }
+                        sim.addEmulation(first_op, nops, operation);
+                    },
+                    "first_op"_a, "nops"_a, "kind"_a, "qubits"_a, "other"_a = std::vector<dd::Qubit>{}, "constant"_a = 0, "modulus"_a = 0, "controls"_a = std::vector<dd::Qubit>{},
+                    R"pbdoc(Apply the given operations of the circuit at once as the emulated operation they implement (registers are given least significant qubit first))pbdoc")
+            .def("clear_emulations", &CircuitSimulator::clearEmulations);
+
+    py::class_<StateVectorSimulator>(m, "DenseCircuitSimulator")
+            .def(py::init<>(&create_simulator<StateVectorSimulator, const std::size_t&>), "circ"_a, "seed"_a, "nthreads"_a = 1)
+            .def(py::init<>(&create_simulator_without_seed<StateVectorSimulator>), "circ"_a)
+            .def("get_number_of_qubits", &StateVectorSimulator::getNumberOfQubits)
+            .def("get_name", &StateVectorSimulator::getName)
+            .def("simulate", &StateVectorSimulator::Simulate, "shots"_a)
+            .def("statistics", &StateVectorSimulator::AdditionalStatistics)
+            .def("get_vector", &StateVectorSimulator::getVectorComplex)
+            .def("expectation_value", &expectation_value<StateVectorSimulator>, "observable"_a, "nthreads"_a = 1,
+                 R"pbdoc(Exact expectation value of a sum of Pauli strings (qubit n-1 first) with real coefficients, given as a dict or a list of pairs, in the final state)pbdoc")
+            .def("cost_expectation", py::overload_cast<const DiagonalCost&>(&StateVectorSimulator::expectationValue, py::const_), "cost"_a,
+                 R"pbdoc(Exact expectation value of the cost of the measurement results of the final state)pbdoc")
+            .def("cost_cvar", &StateVectorSimulator::conditionalValueAtRisk, "cost"_a, "alpha"_a, "max_outcomes"_a = DiagonalCost::DEFAULT_MAX_OUTCOMES,
+                 R"pbdoc(CVaR of the cost over the (at most max_outcomes) most probable measurement results of the final state)pbdoc")
+            .def("set_initial_state", &set_initial_state<StateVectorSimulator>, "state"_a,
+                 R"pbdoc(Start from the given state instead of |0...0>: a basis string (one of 0, 1, +, -, r, l per qubit, starting with the last qubit), a dict from basis indices to amplitudes or an array of all amplitudes)pbdoc");
+
+    py::class_<AutoSimulator>(m, "AutoCircuitSimulator")
+            .def(py::init<>(&create_simulator<AutoSimulator, const std::size_t&>), "circ"_a, "seed"_a, "nthreads"_a = 2)
+            .def(py::init<>(&create_simulator_without_seed<AutoSimulator>), "circ"_a)
+            .def("get_number_of_qubits", &AutoSimulator::getNumberOfQubits)
+            .def("get_name", &AutoSimulator::getName)
+            .def("get_engine", [](const AutoSimulator& sim) { return EngineSelector::toString(sim.getPrediction().engine); },
+                 R"pbdoc(Name of the selected engine ('dd', 'dense', 'hybrid' or 'path'))pbdoc")
+            .def("simulate", &AutoSimulator::Simulate, "shots"_a)
+            .def("statistics", &AutoSimulator::AdditionalStatistics)
+            .def("get_vector", &AutoSimulator::getVectorComplex)
+            .def("expectation_value", &expectation_value<AutoSimulator>, "observable"_a, "nthreads"_a = 1,
+                 R"pbdoc(Exact expectation value of a sum of Pauli strings (qubit n-1 first) with real coefficients, given as a dict or a list of pairs, in the final state)pbdoc")
+            .def("cost_expectation", py::overload_cast<const DiagonalCost&>(&AutoSimulator::expectationValue, py::const_), "cost"_a,
+                 R"pbdoc(Exact expectation value of the cost of the measurement results of the final state)pbdoc")
+            .def("cost_cvar", &AutoSimulator::conditionalValueAtRisk, "cost"_a, "alpha"_a, "max_outcomes"_a = DiagonalCost::DEFAULT_MAX_OUTCOMES,
+                 R"pbdoc(CVaR of the cost over the (at most max_outcomes) most probable measurement results of the final state)pbdoc")
+            .def("set_initial_state", &set_initial_state<AutoSimulator>, "state"_a,
+                 R"pbdoc(Start from the given state instead of |0...0>: a basis string (one of 0, 1, +, -, r, l per qubit, starting with the last qubit), a dict from basis indices to amplitudes or an array of all amplitudes)pbdoc");
+
+    py::class_<AdjointSimulator>(m, "AdjointCircuitSimulator")
+            .def(py::init<>(&create_simulator<AdjointSimulator>), "circ"_a, "seed"_a)
+            .def(py::init<>(&create_simulator_without_seed<AdjointSimulator>), "circ"_a)
+            .def("get_number_of_qubits", &AdjointSimulator::getNumberOfQubits)
+            .def("get_name", &AdjointSimulator::getName)
+            .def("simulate", &AdjointSimulator::Simulate, "shots"_a)
+            .def("statistics", &AdjointSimulator::AdditionalStatistics)
+            .def("get_vector", &AdjointSimulator::getVectorComplex)
+            .def("set_initial_state", &set_initial_state<AdjointSimulator>, "state"_a,
+                 R"pbdoc(Start from the given state instead of |0...0>: a basis string (one of 0, 1, +, -, r, l per qubit, starting with the last qubit), a dict from basis indices to amplitudes or an array of all amplitudes)pbdoc")
+            .def("expectation_value", &expectation_value<AdjointSimulator>, "observable"_a, "nthreads"_a = 1,
+                 R"pbdoc(Exact expectation value of a sum of Pauli strings (qubit n-1 first) with real coefficients, given as a dict or a list of pairs, in the final state)pbdoc")
+            .def(
+                    "gradient", [](AdjointSimulator& sim, const py::object& observable) {
+                        const auto gradient = sim.gradient(to_pauli_terms(observable));
+                        return py::array_t<dd::fp>(static_cast<py::ssize_t>(gradient.size()), gradient.data());
+                    },
+                    "observable"_a,
+                    R"pbdoc(Gradient of the expectation value of the observable with respect to the parameters of all RX, RY, RZ, phase, U2 and U3 gates (in circuit order, U2 and U3 contributing one entry per parameter) by adjoint differentiation)pbdoc")
+            .def("set_parameters", &AdjointSimulator::setParameters, "values"_a,
+                 R"pbdoc(Set the parameters of all RX, RY, RZ, phase, U2 and U3 gates (in the order of the gradient))pbdoc")
+            .def("get_parameterized_operations", &AdjointSimulator::getParameterizedOperations)
+            .def("get_expectation_value", &AdjointSimulator::getExpectationValue,
+                 R"pbdoc(Expectation value of the observable of the last gradient)pbdoc");
+
+    py::enum_<BatchSimulator::Mode>(m, "BatchMode")
+            .value("auto", BatchSimulator::Mode::Auto)
+            .value("gate_by_gate", BatchSimulator::Mode::GateByGate)
+            .value("unitary", BatchSimulator::Mode::Unitary)
+            .export_values();
+
+    py::class_<BatchSimulator>(m, "BatchCircuitSimulator")
+            .def(py::init<>(&create_simulator<BatchSimulator>), "circ"_a, "seed"_a)
+            .def(py::init<>(&create_simulator_without_seed<BatchSimulator>), "circ"_a)
+            .def("get_number_of_qubits", &BatchSimulator::getNumberOfQubits)
+            .def("get_name", &BatchSimulator::getName)
+            .def("add_input", [](BatchSimulator& sim, const py::object& state) { sim.addInput(to_initial_state(sim.getNumberOfQubits(), state)); }, "state"_a,
+                 R"pbdoc(Add an input state given like the initial states of the other simulators)pbdoc")
+            .def("set_mode", &BatchSimulator::setMode, "mode"_a)
+            .def("set_unitary_limits", &BatchSimulator::setUnitaryLimits, "max_qubits"_a, "max_nodes"_a)
+            .def("simulate", &BatchSimulator::Simulate, "shots"_a,
+                 R"pbdoc(Counts of all inputs combined (shots per input))pbdoc")
+            .def("simulate_batch", &BatchSimulator::SimulateBatch, "shots"_a,
+                 R"pbdoc(Counts of each input)pbdoc")
+            .def("get_amplitude", &BatchSimulator::getAmplitude, "input"_a, "basis_state"_a)
+            .def("get_vector", [](BatchSimulator& sim, const std::size_t input) {
+                    sim.selectInput(input);
+                    return sim.getVectorComplex(); }, "input"_a)
+            .def("statistics", &BatchSimulator::AdditionalStatistics);
 
     py::enum_<HybridSchrodingerFeynmanSimulator::Mode>(m, "HybridMode")
             .value("DD", HybridSchrodingerFeynmanSimulator::Mode::DD)
@@ -149,6 +363,8 @@ PYBIND11_MODULE(pyddsim, m) {
             .def("simulate", &HybridSchrodingerFeynmanSimulator::Simulate, "shots"_a)
             .def("statistics", &CircuitSimulator::AdditionalStatistics)
             .def("get_vector", &CircuitSimulator::getVectorComplex)
+            .def("set_qubit_reordering", &CircuitSimulator::setQubitReordering, "enable"_a,
+                 R"pbdoc(Permute the qubits if this reduces the number of operations crossing the split)pbdoc")
             .def("get_mode", &HybridSchrodingerFeynmanSimulator::getMode)
             .def("get_final_amplitudes", &HybridSchrodingerFeynmanSimulator::getFinalAmplitudes);
 
@@ -172,6 +388,8 @@ PYBIND11_MODULE(pyddsim, m) {
                            R"pbdoc(Start of the alternating strategy)pbdoc")
             .def_readwrite("seed", &PathSimulator::Configuration::seed,
                            R"pbdoc(Seed for the simulator)pbdoc")
+            .def_readwrite("lightcone", &PathSimulator::Configuration::lightcone,
+                           R"pbdoc(Remove all operations outside the backward lightcone of the measurements and sample only the measured qubits)pbdoc")
             .def("json", &PathSimulator::Configuration::json)
             .def("__repr__", &PathSimulator::Configuration::toString);
 
@@ -1,6 +1,7 @@
 from qiskit.providers import ProviderV1
 from qiskit.providers.providerutils import filter_backends
 
+from .autosimulator import AutoSimulator
 from .qasmsimulator import QasmSimulator
 from .statevectorsimulator import StatevectorSimulator
 from .hybridqasmsimulator import HybridQasmSimulator
@@ -22,7 +23,8 @@ class DDSIMProvider(ProviderV1):
                 ('hybrid_statevector_simulator', HybridStatevectorSimulator, None, None),
                 ('path_sim_qasm_simulator', PathQasmSimulator, None, None),
                 ('path_sim_statevector_simulator', PathStatevectorSimulator, None, None),
-                ('unitary_simulator', UnitarySimulator, None, None)
+                ('unitary_simulator', UnitarySimulator, None, None),
+                ('auto_simulator', AutoSimulator, None, None)
             ]
 
     def get_backend(self, name=None, **kwargs):
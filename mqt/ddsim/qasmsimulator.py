@@ -30,6 +30,17 @@ class QasmSimulator(BackendV1):
             shots=None,
             parameter_binds=None,
             simulator_seed=None,
+            lightcone=False,
+            eliminate_idle_qubits=False,
+            factorize=False,
+            reorder_qubits=False,
+            stabilizer_prefix=False,
+            initial_state=None,
+            deadline=None,
+            min_step_fidelity=0.9,
+            gc_mode='default',
+            gc_every=1,
+            gc_threshold=0.5,
         )
 
     def __init__(self, configuration=None, provider=None):
@@ -52,7 +63,7 @@ class QasmSimulator(BackendV1):
                             'p', 'cp', 'cu1', 'mcphase',
                             'sx', 'csx', 'sxdg',
                             'swap', 'cswap', 'iswap',
-                            'snapshot'],
+                            'reset', 'snapshot'],
             'memory': False,
             'n_qubits': 64,
             'coupling_map': None,
@@ -105,6 +116,17 @@ class QasmSimulator(BackendV1):
     def run_experiment(self, qobj_experiment: QasmQobjExperiment, **options):
         start_time = time.time()
         sim = ddsim.CircuitSimulator(qobj_experiment, options.get('seed', -1))
+        if options.get('lightcone', False):
+            sim.prune_to_lightcone()
+        sim.set_idle_qubit_elimination(options.get('eliminate_idle_qubits', False))
+        sim.set_factorization(options.get('factorize', False))
+        sim.set_qubit_reordering(options.get('reorder_qubits', False))
+        sim.set_stabilizer_prefix(options.get('stabilizer_prefix', False))
+        if options.get('initial_state') is not None:
+            sim.set_initial_state(options['initial_state'])
+        if options.get('deadline') is not None:
+            sim.set_deadline(options['deadline'], options.get('min_step_fidelity', 0.9))
+        sim.set_garbage_collection(options.get('gc_mode', 'default'), options.get('gc_every', 1), options.get('gc_threshold', 0.5))
         counts = sim.simulate(options.get('shots', 1024))
         end_time = time.time()
         counts_hex = {hex(int(result, 2)): count for result, count in counts.items()}
@@ -118,6 +140,11 @@ class QasmSimulator(BackendV1):
                   'data': {'counts': counts_hex},
                   'success': True,
                   }
+        if options.get('deadline') is not None:
+            statistics = sim.statistics()
+            result['final_fidelity'] = float(statistics['final_fidelity'])
+            result['deadline_forced_approximation'] = statistics['deadline_forced_approximation'] == 'true'
+            result['deadline_mean_fidelity'] = float(statistics['deadline_mean_fidelity'])
         if self.SHOW_STATE_VECTOR:
             result['data']['statevector'] = sim.get_vector()
         return result
@@ -35,7 +35,7 @@ class StatevectorSimulator(QasmSimulator):
                             'p', 'cp', 'cu1', 'mcphase',
                             'sx', 'csx', 'sxdg',
                             'swap', 'cswap', 'iswap',
-                            'snapshot'],
+                            'reset', 'snapshot'],
             'memory': False,
             'n_qubits': 64,
             'coupling_map': None,
@@ -0,0 +1,212 @@
+#include "AdjointSimulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+std::vector<dd::fp> AdjointSimulator::gradient(const std::vector<PauliTerm>& observable) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto n  = qc->getNqubits();
+
+    std::vector<const qc::Operation*> gates{};
+    for (const auto& op: *qc) {
+        if (op->getType() == qc::Barrier) {
+            continue;
+        }
+        if (!op->isStandardOperation()) {
+            throw std::runtime_error("Adjoint differentiation only supports standard operations, but the circuit contains " + std::string(op->getName()) + ".");
+        }
+        gates.push_back(op.get());
+    }
+    // validates the observable before anything is simulated
+    static_cast<void>(PauliExpectation(n, observable));
+
+    // forward pass (on the qubits of the circuit)
+    if (final_state.p != nullptr) {
+        dd->decRef(final_state);
+    }
+    dense_state.reset();
+    qubit_levels.clear();
+    auto psi = initial_state.isZeroState() ? dd->makeZeroState(n) : initial_state.toDD(dd, n);
+    dd->incRef(psi);
+    for (const auto* op: gates) {
+        psi = apply(op->getDD(dd), psi);
+        dd->garbageCollect();
+    }
+    final_state = psi;
+    root_edge   = final_state;
+    dd->incRef(final_state);
+
+    auto phi    = applyObservable(observable, psi);
+    expectation = dd->innerProduct(psi, phi).r;
+
+    // backward pass, where phi is the observable applied to the state after and psi the state before the current gate
+    std::vector<dd::fp> gradients{};
+    for (auto it = gates.rbegin(); it != gates.rend(); ++it) {
+        const auto inverse = (*it)->getInverseDD(dd);
+        dd->incRef(inverse);
+        psi = apply(inverse, psi);
+        // the gradient is reversed at the end, hence the parameters of an operation are visited backwards as well
+        for (auto parameter = countParameters(**it); parameter > 0; --parameter) {
+            gradients.push_back(2. * derivativeOverlap(**it, parameter - 1, phi, psi));
+        }
+        phi = apply(inverse, phi);
+        dd->decRef(inverse);
+        dd->garbageCollect();
+    }
+    dd->decRef(psi);
+    dd->decRef(phi);
+
+    std::reverse(gradients.begin(), gradients.end());
+    parameters    = gradients.size();
+    gradient_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return gradients;
+}
+
+std::vector<std::size_t> AdjointSimulator::getParameterizedOperations() const {
+    std::vector<std::size_t> operations{};
+    std::size_t              i = 0;
+    for (const auto& op: *qc) {
+        operations.insert(operations.end(), countParameters(*op), i);
+        ++i;
+    }
+    return operations;
+}
+
+void AdjointSimulator::setParameters(const std::vector<dd::fp>& values) {
+    const auto operations = getParameterizedOperations();
+    if (values.size() != operations.size()) {
+        throw std::runtime_error("The circuit has " + std::to_string(operations.size()) + " parameters, but " + std::to_string(values.size()) + " values were given.");
+    }
+    // consecutive entries of the same operation refer to its consecutive parameters
+    for (std::size_t i = 0, parameter = 0; i < operations.size(); ++i) {
+        parameter = i > 0 && operations.at(i) == operations.at(i - 1) ? parameter + 1 : 0;
+        qc->at(operations.at(i))->getParameter().at(parameter) = values.at(i);
+    }
+}
+
+std::size_t AdjointSimulator::countParameters(const qc::Operation& op) {
+    if (!op.isStandardOperation() || op.getTargets().size() != 1) {
+        return 0;
+    }
+    switch (op.getType()) {
+        case qc::RX:
+        case qc::RY:
+        case qc::RZ:
+        case qc::Phase:
+            return 1;
+        case qc::U2:
+            return 2;
+        case qc::U3:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+dd::GateMatrix AdjointSimulator::derivative(const qc::Operation& op, const std::size_t parameter) {
+    const auto& p = op.getParameter();
+    if (op.getType() == qc::U2 || op.getType() == qc::U3) {
+        // U3(lambda, phi, theta) = [[cos(theta/2), -e^(i lambda) sin(theta/2)],
+        //                           [e^(i phi) sin(theta/2), e^(i (lambda + phi)) cos(theta/2)]] and U2(lambda, phi) = U3(lambda, phi, pi/2)
+        const auto theta   = op.getType() == qc::U3 ? p.at(2) : dd::PI_2;
+        const auto c       = std::cos(theta / 2.);
+        const auto s       = std::sin(theta / 2.);
+        const auto lambda  = std::polar(1., p.at(0));
+        const auto phi     = std::polar(1., p.at(1));
+        const auto i       = std::complex<dd::fp>{0., 1.};
+        const auto toValue = [](const std::complex<dd::fp>& z) { return dd::ComplexValue{z.real(), z.imag()}; };
+        switch (parameter) {
+            case 0:
+                return {dd::complex_zero, toValue(-i * lambda * s), dd::complex_zero, toValue(i * lambda * phi * c)};
+            case 1:
+                return {dd::complex_zero, dd::complex_zero, toValue(i * phi * s), toValue(i * lambda * phi * c)};
+            default:
+                return {dd::ComplexValue{-s / 2., 0.}, toValue(-lambda * c / 2.), toValue(phi * c / 2.), toValue(-lambda * phi * s / 2.)};
+        }
+    }
+
+    const auto theta = p.at(0);
+    const auto c     = std::cos(theta / 2.);
+    const auto s     = std::sin(theta / 2.);
+    switch (op.getType()) {
+        case qc::RX:
+            return {dd::ComplexValue{-s / 2., 0.}, dd::ComplexValue{0., -c / 2.}, dd::ComplexValue{0., -c / 2.}, dd::ComplexValue{-s / 2., 0.}};
+        case qc::RY:
+            return {dd::ComplexValue{-s / 2., 0.}, dd::ComplexValue{-c / 2., 0.}, dd::ComplexValue{c / 2., 0.}, dd::ComplexValue{-s / 2., 0.}};
+        case qc::RZ:
+            return {dd::ComplexValue{-s / 2., -c / 2.}, dd::complex_zero, dd::complex_zero, dd::ComplexValue{-s / 2., c / 2.}};
+        case qc::Phase:
+            return {dd::complex_zero, dd::complex_zero, dd::complex_zero, dd::ComplexValue{-std::sin(theta), std::cos(theta)}};
+        default:
+            throw std::runtime_error("The operation is not parameterized.");
+    }
+}
+
+dd::fp AdjointSimulator::derivativeOverlap(const qc::Operation& op, const std::size_t parameter, const qc::VectorDD& phi, const qc::VectorDD& psi) {
+    const auto  n        = qc->getNqubits();
+    const auto  target   = op.getTargets().front();
+    const auto& controls = op.getControls();
+    if (controls.empty()) {
+        return dd->innerProduct(phi, dd->multiply(dd->makeGateDD(derivative(op, parameter), n, target), psi)).r;
+    }
+    // the controlled gate DD acts as the identity if a control is not satisfied, which does not belong to the derivative
+    static constexpr dd::GateMatrix ZEROMAT{dd::complex_zero, dd::complex_zero, dd::complex_zero, dd::complex_zero};
+    const auto                      value    = dd->innerProduct(phi, dd->multiply(dd->makeGateDD(derivative(op, parameter), n, controls, target), psi)).r;
+    const auto                      inactive = dd->innerProduct(phi, dd->multiply(dd->makeGateDD(ZEROMAT, n, controls, target), psi)).r;
+    return value - inactive;
+}
+
+qc::VectorDD AdjointSimulator::applyObservable(const std::vector<PauliTerm>& observable, const qc::VectorDD& psi) {
+    const auto n = qc->getNqubits();
+
+    auto result = qc::VectorDD::zero;
+    for (const auto& [coefficient, pauli]: observable) {
+        if (pauli.size() != n) {
+            throw std::runtime_error("The Pauli string '" + pauli + "' does not have one operator per qubit.");
+        }
+        auto term = psi;
+        dd->incRef(term);
+        // the coefficient is multiplied into the first factor (an identity on qubit 0 if there is none)
+        bool       scaled      = false;
+        const auto applyFactor = [&](dd::GateMatrix matrix, const dd::Qubit q) {
+            if (!scaled) {
+                for (auto& entry: matrix) {
+                    entry = dd::ComplexValue{entry.r * coefficient, entry.i * coefficient};
+                }
+                scaled = true;
+            }
+            term = apply(dd->makeGateDD(matrix, n, q), term);
+        };
+        for (std::size_t q = 0; q < n; ++q) {
+            const auto op = pauli.at(n - 1 - q);
+            if (op == 'X') {
+                applyFactor(dd::Xmat, static_cast<dd::Qubit>(q));
+            } else if (op == 'Y') {
+                applyFactor(dd::Ymat, static_cast<dd::Qubit>(q));
+            } else if (op == 'Z') {
+                applyFactor(dd::Zmat, static_cast<dd::Qubit>(q));
+            } else if (op != 'I') {
+                throw std::runtime_error("Unknown Pauli operator '" + std::string(1, op) + "'.");
+            }
+        }
+        if (!scaled) {
+            applyFactor(dd::Imat, 0);
+        }
+        auto sum = dd->add(result, term);
+        dd->incRef(sum);
+        dd->decRef(result);
+        dd->decRef(term);
+        result = sum;
+    }
+    return result;
+}
+
+qc::VectorDD AdjointSimulator::apply(const qc::MatrixDD& m, const qc::VectorDD& state) {
+    auto result = dd->multiply(m, state);
+    dd->incRef(result);
+    dd->decRef(state);
+    return result;
+}
@@ -0,0 +1,110 @@
+#include "AutoSimulator.hpp"
+
+#include "CircuitSimulator.hpp"
+#include "HybridSchrodingerFeynmanSimulator.hpp"
+#include "PathSimulator.hpp"
+#include "StateVectorSimulator.hpp"
+
+#include <stdexcept>
+
+void AutoSimulator::initialize(std::unique_ptr<qc::QuantumComputation>&& qc) {
+    circuit  = std::move(qc);
+    features = EngineSelector::analyze(*circuit);
+
+    for (const auto& op: *circuit) {
+        if (op->getType() == qc::Measure) {
+            const auto* measurement = dynamic_cast<const qc::NonUnitaryOperation*>(op.get());
+            for (std::size_t i = 0; i < measurement->getTargets().size(); ++i) {
+                measurement_map[static_cast<unsigned int>(measurement->getTargets().at(i))] = static_cast<unsigned int>(measurement->getClassics().at(i));
+            }
+        }
+    }
+
+    createEngine(EngineSelector::predict(features, nthreads));
+}
+
+void AutoSimulator::createEngine(const EngineSelector::Prediction& prediction_) {
+    prediction = prediction_;
+    auto qc    = std::make_unique<qc::QuantumComputation>(circuit->clone());
+
+    // the state of a previous engine is discarded
+    dense_state.reset();
+    root_edge          = {};
+    holds_engine_state = false;
+
+    // without a fixed seed, the engine is seeded randomly as well
+    const auto engine_seed = has_fixed_seed ? seed : mt();
+    switch (prediction.engine) {
+        case EngineSelector::Engine::DD: {
+            auto circuitSim = std::make_unique<CircuitSimulator>(std::move(qc), engine_seed);
+            circuitSim->setQubitReordering(features.reorder);
+            circuitSim->setStabilizerPrefix(features.clifford_prefix > 0);
+            engine = std::move(circuitSim);
+            break;
+        }
+        case EngineSelector::Engine::Dense:
+            engine = std::make_unique<StateVectorSimulator>(std::move(qc), engine_seed, nthreads);
+            break;
+        case EngineSelector::Engine::Hybrid: {
+            auto hybridSim = std::make_unique<HybridSchrodingerFeynmanSimulator>(std::move(qc), ApproximationInfo{}, engine_seed, HybridSchrodingerFeynmanSimulator::Mode::Amplitude, nthreads);
+            hybridSim->setQubitReordering(features.reorder);
+            engine = std::move(hybridSim);
+            break;
+        }
+        case EngineSelector::Engine::Path:
+            engine = std::make_unique<PathSimulator>(std::move(qc), PathSimulator::Configuration(PathSimulator::Configuration::Mode::PairwiseRecursiveGrouping, 2, 0, engine_seed));
+            break;
+        default:
+            throw std::runtime_error("The unitary simulator cannot be used to simulate a circuit.");
+    }
+}
+
+void AutoSimulator::setEngine(const EngineSelector::Engine engine_) {
+    const bool slicing = engine_ == EngineSelector::Engine::Hybrid || engine_ == EngineSelector::Engine::Path;
+    if (slicing && (!features.only_standard_operations || features.measurements == EngineSelector::MeasurementStructure::MidCircuit || features.initial_state)) {
+        throw std::runtime_error("The " + EngineSelector::toString(engine_) + " simulator does not support the circuit.");
+    }
+    auto selected   = prediction;
+    selected.engine = engine_;
+    selected.reason = "the engine was selected explicitly";
+    createEngine(selected);
+}
+
+void AutoSimulator::setInitialState(const InitialState& state) {
+    features.initial_state = !state.isZeroState();
+    if (features.initial_state && (prediction.engine == EngineSelector::Engine::Hybrid || prediction.engine == EngineSelector::Engine::Path)) {
+        createEngine(EngineSelector::predict(features, nthreads));
+    }
+    engine->setInitialState(state);
+}
+
+std::map<std::string, std::size_t> AutoSimulator::Simulate(unsigned int shots) {
+    auto* hybridSim = dynamic_cast<HybridSchrodingerFeynmanSimulator*>(engine.get());
+    if (hybridSim != nullptr && hybridSim->getMode() == HybridSchrodingerFeynmanSimulator::Mode::Amplitude) {
+        dense_state.reset();
+        auto results = engine->Simulate(shots);
+        if (shots == 0) {
+            // the amplitudes are only left untouched if no shots were sampled
+            dense_state = std::make_unique<DenseState>(hybridSim->getFinalAmplitudes());
+        }
+        return toClassicalBits(results);
+    }
+
+    // the engine simulates in its own package, which is taken over afterwards
+    if (holds_engine_state) {
+        exchangeState(*engine);
+    }
+    auto results = engine->Simulate(shots);
+    exchangeState(*engine);
+    holds_engine_state = true;
+    return toClassicalBits(results);
+}
+
+std::map<std::string, std::size_t> AutoSimulator::toClassicalBits(const std::map<std::string, std::size_t>& results) const {
+    // the DD and the dense simulator already return the classical bits
+    const bool all_qubits = prediction.engine == EngineSelector::Engine::Hybrid || prediction.engine == EngineSelector::Engine::Path;
+    if (!all_qubits || measurement_map.empty()) {
+        return results;
+    }
+    return toClassicalCounts(results, measurement_map, circuit->getNqubits(), circuit->getNcbits());
+}
@@ -0,0 +1,175 @@
+#include "BatchSimulator.hpp"
+
+#include "PermutationEmulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+std::map<std::string, std::size_t> BatchSimulator::Simulate(const unsigned int shots) {
+    std::map<std::string, std::size_t> counts{};
+    for (const auto& input_counts: SimulateBatch(shots)) {
+        for (const auto& [outcome, count]: input_counts) {
+            counts[outcome] += count;
+        }
+    }
+    return counts;
+}
+
+std::vector<std::map<std::string, std::size_t>> BatchSimulator::SimulateBatch(const unsigned int shots) {
+    const auto measured = measuredQubits();
+    const auto n_qubits = qc->getNqubits();
+
+    releaseStates();
+    unitary_ops  = 0;
+    used_unitary = mode != Mode::GateByGate && constructUnitary();
+
+    states.reserve(inputs.size());
+    for (const auto& input: inputs) {
+        const auto state = input.toDD(dd, n_qubits);
+        dd->incRef(state);
+        states.push_back(state);
+    }
+
+    const auto applyToAll = [&](const qc::MatrixDD& u) {
+        for (auto& state: states) {
+            auto tmp = dd->multiply(u, state);
+            dd->incRef(tmp);
+            dd->decRef(state);
+            state = tmp;
+        }
+        dd->garbageCollect();
+    };
+
+    if (used_unitary) {
+        applyToAll(unitary);
+    } else {
+        for (const auto& op: *qc) {
+            if (op->getType() == qc::Barrier || op->getType() == qc::Measure) {
+                continue;
+            }
+            // the gate DD and the compute table entries of the first input are reused by all further inputs
+            const auto gate = op->getDD(dd);
+            dd->incRef(gate);
+            applyToAll(gate);
+            dd->decRef(gate);
+        }
+    }
+
+    std::vector<std::map<std::string, std::size_t>> results(inputs.size());
+    if (shots == 0) {
+        return results;
+    }
+    const auto n_cbits = qc->getNcbits();
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        selectInput(i);
+        if (measured.empty()) {
+            results.at(i) = MeasureAllNonCollapsing(shots);
+            continue;
+        }
+        for (const auto& [outcome, count]: MeasureAllNonCollapsing(shots)) {
+            std::string result_string(n_cbits, '0');
+            for (const auto& [bit, qubit]: measured) {
+                result_string[n_cbits - bit - 1] = outcome[n_qubits - static_cast<std::size_t>(qubit) - 1];
+            }
+            results.at(i)[result_string] += count;
+        }
+    }
+    return results;
+}
+
+void BatchSimulator::selectInput(const std::size_t input) {
+    if (input >= states.size()) {
+        throw std::runtime_error("Input " + std::to_string(input) + " has not been simulated.");
+    }
+    root_edge = states.at(input);
+}
+
+std::complex<dd::fp> BatchSimulator::getAmplitude(const std::size_t input, const std::string& basis_state) const {
+    if (input >= states.size()) {
+        throw std::runtime_error("Input " + std::to_string(input) + " has not been simulated.");
+    }
+    if (basis_state.size() != qc->getNqubits()) {
+        throw std::runtime_error("The basis state must have one bit per qubit.");
+    }
+    const auto value = dd->getValueByPath(states.at(input), std::string{basis_state.rbegin(), basis_state.rend()});
+    return {value.r, value.i};
+}
+
+bool BatchSimulator::constructUnitary() {
+    if (mode == Mode::Auto) {
+        // building the unitary only pays off if it is applied to several inputs and is likely to be small
+        const bool reversible = std::all_of(qc->begin(), qc->end(), [](const auto& op) {
+            return op->getType() == qc::Barrier || op->getType() == qc::Measure || PermutationEmulator::isReversibleGate(*op);
+        });
+        if (inputs.size() < 2 || (qc->getNqubits() > max_unitary_qubits && !reversible)) {
+            return false;
+        }
+    }
+
+    // the unitary is built gate by gate in a separate package, so that its construction can be aborted as soon as it
+    // exceeds the node limit
+    auto       package = std::make_unique<dd::Package>(qc->getNqubits());
+    const auto start   = std::chrono::steady_clock::now();
+    auto       u       = package->makeIdent(qc->getNqubits());
+    package->incRef(u);
+    for (const auto& op: *qc) {
+        if (op->getType() == qc::Barrier || op->getType() == qc::Measure) {
+            continue;
+        }
+        auto tmp = package->multiply(op->getDD(package), u);
+        package->incRef(tmp);
+        package->decRef(u);
+        u = tmp;
+        package->garbageCollect();
+        ++unitary_ops;
+        if (mode == Mode::Auto && package->size(u) > max_unitary_nodes) {
+            // the package is discarded together with the partial unitary
+            return false;
+        }
+    }
+
+    // take over the package holding the unitary
+    std::swap(dd, package);
+    unitary           = u;
+    unitary_nodes     = dd->size(unitary);
+    construction_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void BatchSimulator::releaseStates() {
+    for (const auto& state: states) {
+        dd->decRef(state);
+    }
+    states.clear();
+    root_edge = {};
+    if (used_unitary) {
+        dd->decRef(unitary);
+        unitary = {};
+    }
+}
+
+std::map<std::size_t, dd::Qubit> BatchSimulator::measuredQubits() const {
+    std::map<std::size_t, dd::Qubit> measured{};
+    for (const auto& op: *qc) {
+        if (op->getType() == qc::Barrier) {
+            continue;
+        }
+        if (op->getType() == qc::Measure) {
+            const auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get());
+            if (nu_op == nullptr) {
+                throw std::runtime_error("Op with type Measurement could not be casted to NonUnitaryOperation");
+            }
+            const auto& quantum = nu_op->getTargets();
+            const auto& classic = nu_op->getClassics();
+            if (quantum.size() != classic.size()) {
+                throw std::runtime_error("Measurement: Sizes of quantum and classic register mismatch.");
+            }
+            for (std::size_t i = 0; i < quantum.size(); ++i) {
+                measured[classic.at(i)] = quantum.at(i);
+            }
+        } else if (!op->isUnitary() || op->isClassicControlledOperation() || !measured.empty()) {
+            throw std::runtime_error("Batched simulation only supports circuits of gates followed by measurements.");
+        }
+    }
+    return measured;
+}
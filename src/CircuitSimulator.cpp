@@ -2,156 +2,301 @@
 
 #include "dd/Export.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 std::map<std::string, std::size_t> CircuitSimulator::Simulate(const unsigned int shots) {
-    bool has_nonmeasurement_nonunitary = false;
-    bool has_measurements              = false;
-    bool measurements_last             = true;
+    postselection_probability_sum = 0.;
+    postselection_shots           = 0;
 
-    std::map<unsigned int, unsigned int> measurement_map;
+    // the passes below produce the circuit that is actually simulated
+    const qc::QuantumComputation*           simulated = qc.get();
+    std::unique_ptr<qc::QuantumComputation> reordered{};
+    qubit_levels.clear();
+    static_levels.clear();
+    if (reorder_qubits) {
+        static_levels = QubitOrdering::compute(*qc);
+        qubit_levels  = static_levels;
+        reordered     = QubitOrdering::permute(*qc, static_levels);
+        simulated     = reordered.get();
+    }
 
-    for (auto& op: *qc) {
-        if (op->isClassicControlledOperation() || (op->isNonUnitaryOperation() && op->getType() != qc::Measure && op->getType() != qc::Barrier)) {
-            has_nonmeasurement_nonunitary = true;
+    std::unique_ptr<qc::QuantumComputation> compacted{};
+    compaction.reset();
+    if (eliminate_idle_qubits && initial_state.isZeroState()) {
+        compaction.emplace(*simulated);
+        if (compaction->getNidle() > 0) {
+            compacted = compaction->compact(*simulated);
+            simulated = compacted.get();
         }
-        if (op->getType() == qc::Measure) {
-            auto nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get());
-            if (nu_op == nullptr) {
-                throw std::runtime_error("Op with type Measurement could not be casted to NonUnitaryOperation");
-            }
-            has_measurements = true;
+    }
 
-            const auto& quantum = nu_op->getTargets();
-            const auto& classic = nu_op->getClassics();
+    const ExecutionPlan plan(*simulated, dd, true);
 
-            if (quantum.size() != classic.size()) {
-                throw std::runtime_error("Measurement: Sizes of quantum and classic register mismatch.");
-            }
+    const bool approximating = approx_info.step_number > 0 && approx_info.step_fidelity < 1.0;
+    if (prefix_cache && !approximating && initial_state.isZeroState()) {
+        prefix_hashes = PrefixCache::prefixHashes(plan, plan.getNqubits());
+    } else {
+        prefix_hashes.clear();
+    }
 
-            for (unsigned int i = 0; i < quantum.size(); ++i) {
-                measurement_map[quantum.at(i)] = classic.at(i);
+    if (clifford_state.p != nullptr) {
+        dd->decRef(clifford_state);
+        clifford_state = dd::Package::vEdge{};
+    }
+    clifford_prefix = 0;
+    // the cached gates refer to the instructions of the previous plan
+    factorized_gates.clear();
+    sifted_gates.clear();
+    if (stabilizer_prefix && initial_state.isZeroState() && !prefix_cache && !(factorize && !approximating)) {
+        while (clifford_prefix < plan.size()) {
+            const auto& instruction = plan.at(clifford_prefix);
+            if (instruction.kind != ExecutionPlan::Kind::Gate || instruction.isConditional() || !StabilizerTableau::isClifford(*instruction.op)) {
+                break;
             }
+            clifford_prefix++;
         }
-        if (has_measurements && op->isUnitary()) {
-            measurements_last = false;
+        if (clifford_prefix > 0) {
+            // the prefix is deterministic, hence its state is shared by all shots
+            StabilizerTableau tableau(plan.getNqubits());
+            for (std::size_t i = 0; i < clifford_prefix; ++i) {
+                tableau.apply(*plan.at(i).op);
+            }
+            clifford_state = tableau.toDD(dd);
+            dd->incRef(clifford_state);
         }
     }
 
-    // easiest case: all gates are unitary --> simulate once and sample away on all qubits
-    if (!has_nonmeasurement_nonunitary && !has_measurements) {
-        single_shot(false);
-        return MeasureAllNonCollapsing(shots);
+    // the levels found by sifting are kept across shots, as every shot starts from the (order-independent) zero state
+    simulated_levels.clear();
+    if (sifting && !compacted && !prefix_cache && !(factorize && !approximating)) {
+        simulated_levels.resize(plan.getNqubits());
+        std::iota(simulated_levels.begin(), simulated_levels.end(), 0);
     }
 
-    // single shot is enough, but the sampling should only return actually measured qubits
-    if (!has_nonmeasurement_nonunitary && measurements_last) {
-        single_shot(true);
-        std::map<std::string, std::size_t> m_counter;
-        const auto                         n_qubits = qc->getNqubits();
-        const auto                         n_cbits  = qc->getNcbits();
+    dense_threshold = 0;
+    if (dense_ratio > 0 && plan.getNqubits() <= max_dense_qubits && !approximating && simulated_levels.empty() && !compacted && !prefix_cache && !factorize) {
+        dense_threshold = dense_ratio * static_cast<dd::fp>(1ULL << plan.getNqubits());
+    }
 
-        // MeasureAllNonCollapsing returns a map from measurement over all qubits to the number of occurrences
-        for (const auto& item: MeasureAllNonCollapsing(shots)) {
-            std::string result_string(qc->getNcbits(), '0');
+    if (repeated_blocks) {
+        if (!approximating && simulated_levels.empty() && dense_threshold == 0 && !factorize && !prefix_cache) {
+            repeated_blocks->analyze(plan);
+        } else {
+            repeated_blocks->clear();
+        }
+    }
 
-            for (auto const& m: measurement_map) {
-                // m.first is the qubit, m.second the classical bit
-                result_string[n_cbits - m.second - 1] = item.first[n_qubits - m.first - 1];
+    emulated_instructions.clear();
+    if (!emulations.empty() && !approximating && !reordered && !compacted && simulated_levels.empty() && !(factorize && !prefix_cache)) {
+        // barriers are not part of the plan
+        std::vector<std::size_t> plan_index(qc->getNops() + 1, 0);
+        for (std::size_t i = 0; i < qc->getNops(); ++i) {
+            plan_index.at(i + 1) = plan_index.at(i) + (qc->at(i)->getType() == qc::Barrier ? 0 : 1);
+        }
+        std::size_t covered = 0;
+        for (const auto& [first_op, emulation]: emulations) {
+            const auto& [nops, operation] = emulation;
+            if (nops == 0 || first_op + nops > qc->getNops()) {
+                throw std::runtime_error("Emulation annotation exceeds the circuit.");
             }
-
-            m_counter[result_string] += item.second;
+            const auto start = plan_index.at(first_op);
+            const auto end   = plan_index.at(first_op + nops);
+            if (start < covered) {
+                throw std::runtime_error("Emulation annotations must not overlap.");
+            }
+            for (auto i = start; i < end; ++i) {
+                if (plan.at(i).kind != ExecutionPlan::Kind::Gate || plan.at(i).isConditional()) {
+                    throw std::runtime_error("Emulation annotations may only cover unconditional gates.");
+                }
+            }
+            if (end > start) {
+                emulated_instructions.emplace(start, std::pair{end - start, operation});
+            }
+            covered = end;
         }
-
-        return m_counter;
     }
 
-    // there are nonunitaries (or intermediate measurement_map) and we have to actually do multiple single_shots :(
-    std::map<std::string, std::size_t> m_counter;
-
-    for (unsigned int i = 0; i < shots; i++) {
-        const auto result  = single_shot(false);
-        const auto n_cbits = qc->getNcbits();
+    reversible_sections.clear();
+    if (min_reversible_gates > 0 && !approximating && simulated_levels.empty() && !(factorize && !prefix_cache)) {
+        const auto isReversible = [&](std::size_t i) {
+            const auto& instruction = plan.at(i);
+            return instruction.kind == ExecutionPlan::Kind::Gate && !instruction.isConditional() && PermutationEmulator::isReversibleGate(*instruction.op);
+        };
+        std::size_t i = 0;
+        while (i < plan.size()) {
+            auto end = i;
+            while (end < plan.size() && isReversible(end)) {
+                ++end;
+            }
+            if (end - i >= min_reversible_gates) {
+                PermutationEmulator::Netlist netlist{};
+                for (auto k = i; k < end; ++k) {
+                    netlist.push_back(PermutationEmulator::toReversibleGate(*plan.at(k).op));
+                }
+                reversible_sections.emplace(i, std::pair{end - i, std::move(netlist)});
+            }
+            i = std::max(end, i + 1);
+        }
+    }
 
-        std::string result_string(qc->getNcbits(), '0');
+    const auto measurements = analyzeMeasurements(*qc);
 
-        // result is a map from the cbit index to the Boolean value
-        for (const auto& r: result) {
-            result_string[n_cbits - r.first - 1] = r.second ? '1' : '0';
-        }
-        m_counter[result_string]++;
+    deadline_ops          = 0;
+    deadline_fidelity     = 1.0L;
+    deadline_fidelity_sum = 0.0L;
+    deadline_shots        = 0;
+    if (deadline) {
+        deadline->start(plan.size() * (measurements.singleRun() ? 1 : shots));
     }
 
-    return m_counter;
+    // only the state of the last shot remains after the run
+    auto remaining_shots = measurements.singleRun() ? 1U : shots;
+    return runShots(measurements, qc->getNqubits(), qc->getNcbits(), shots, [&](bool ignore_nonunitaries) { return single_shot(plan, ignore_nonunitaries, --remaining_shots == 0); });
 }
 
-std::map<std::size_t, bool> CircuitSimulator::single_shot(const bool ignore_nonunitaries) {
+ExecutionPlan::ClassicalBits CircuitSimulator::single_shot(const ExecutionPlan& plan, const bool ignore_nonunitaries, const bool keep_state) {
     single_shots++;
-    const dd::QubitCount n_qubits = qc->getNqubits();
+    const dd::QubitCount n_qubits = plan.getNqubits();
 
-    root_edge = dd->makeZeroState(n_qubits);
-    dd->incRef(root_edge);
+    const bool approximating = approx_info.step_number > 0 && approx_info.step_fidelity < 1.0;
+
+    dense_state.reset();
+    dense_other_nodes = 0;
+    std::size_t first = 0;
+    if (factorize && !approximating && !prefix_cache && initial_state.isZeroState()) {
+        factorized_state.emplace(dd, n_qubits, factorized_gates);
+    } else if (const auto cached = prefix_hashes.empty() ? std::nullopt : prefix_cache->lookup(prefix_hashes, plan)) {
+        // resume from the deepest cached state of the unitary prefix
+        first     = cached->first;
+        root_edge = cached->second;
+        dd->incRef(root_edge);
+    } else if (clifford_prefix > 0) {
+        first     = clifford_prefix;
+        root_edge = clifford_state;
+        dd->incRef(root_edge);
+        // the state of the prefix refers to the initial levels
+        std::iota(simulated_levels.begin(), simulated_levels.end(), 0);
+    } else if (!initial_state.isZeroState()) {
+        // the initial state refers to the qubits of the circuit
+        std::vector<dd::Qubit> levels{};
+        if (!static_levels.empty() || !simulated_levels.empty()) {
+            levels.resize(n_qubits);
+            for (std::size_t q = 0; q < levels.size(); ++q) {
+                const auto simulated_qubit = static_levels.empty() ? q : static_cast<std::size_t>(static_levels.at(q));
+                levels.at(q)               = simulated_levels.empty() ? static_cast<dd::Qubit>(simulated_qubit) : simulated_levels.at(simulated_qubit);
+            }
+        }
+        root_edge = initial_state.toDD(dd, n_qubits, levels);
+        dd->incRef(root_edge);
+    } else {
+        root_edge = dd->makeZeroState(n_qubits);
+        dd->incRef(root_edge);
+    }
 
-    std::size_t                 op_num = 0;
-    std::map<std::size_t, bool> classic_values;
+    std::size_t op_num         = first;
+    auto        classic_values = plan.makeClassicalBits();
 
     const int approx_mod = std::ceil(static_cast<double>(qc->getNops()) / (approx_info.step_number + 1));
 
-    for (auto& op: *qc) {
-        if (op->isNonUnitaryOperation()) {
+    dd::fp      postselection_probability = 1.;
+    long double shot_fidelity             = 1.0L;
+
+    for (std::size_t i = first; i < plan.size(); ++i) {
+        const auto& instruction = plan.at(i);
+        if (instruction.kind != ExecutionPlan::Kind::Gate) {
             if (ignore_nonunitaries) {
+                // post-selection still has to be applied as it changes the state that is sampled from
+                if (instruction.kind == ExecutionPlan::Kind::Measure && !post_selection.empty()) {
+                    postselection_probability *= measure(instruction, classic_values, true);
+                }
                 continue;
             }
-            if (auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get())) {
-                if (op->getType() == qc::Measure) {
-                    auto quantum = nu_op->getTargets();
-                    auto classic = nu_op->getClassics();
+            if (instruction.kind == ExecutionPlan::Kind::Measure) {
+                postselection_probability *= measure(instruction, classic_values, false);
+            } else if (dense_state) {
+                dense_state->reset(instruction.qubits, mt);
+            } else if (factorized_state) {
+                factorized_state->reset(instruction.qubits, mt);
+            } else {
+                ResetQubits(dd, root_edge, toSimulatedLevels(instruction.qubits), mt);
+            }
+            gc_policy.afterOperation(dd, true);
+        } else {
+            if (instruction.isConditional() && !ExecutionPlan::conditionHolds(instruction, classic_values)) {
+                continue;
+            }
+            /*std::clog << "[INFO] op " << op_num << " is " << instruction.op->getName() << " on " << +instruction.qubits.at(0)
+                      << " #controls=" << instruction.op->getControls().size()
+                      << " statesize=" << dd->size(root_edge) << "\n";//*/
 
-                    assert(quantum.size() == classic.size()); // this should not happen do to check in Simulate
+            if (const auto it = emulated_instructions.find(i); it != emulated_instructions.end()) {
+                // the annotated gates are applied at once
+                const auto& [length, operation] = it->second;
+                if (dense_state) {
+                    dense_state->applyMatrix(emulator.get(n_qubits, operation));
+                } else {
+                    emulator.apply(operation, root_edge, n_qubits);
+                }
+                i += length - 1;
+                op_num += length;
+                emulated_ops++;
+                gc_policy.afterOperation(dd);
+                continue;
+            }
 
-                    for (unsigned int i = 0; i < quantum.size(); ++i) {
-                        auto result = MeasureOneCollapsing(quantum.at(i));
-                        assert(result == '0' || result == '1');
-                        classic_values[classic.at(i)] = (result == '1');
-                    }
-                } else if (op->getType() == qc::Barrier) {
+            if (const auto it = reversible_sections.find(i); it != reversible_sections.end() && !dense_state && !factorized_state) {
+                // the whole section is applied as a single permutation of the basis states, unless the state contains too
+                // many register values, in which case the gates of the section are applied one by one
+                const auto& [length, netlist] = it->second;
+                if (const auto tmp = permutation_emulator.apply(netlist, root_edge)) {
+                    dd->incRef(*tmp);
+                    dd->decRef(root_edge);
+                    root_edge = *tmp;
+                    i += length - 1;
+                    op_num += length;
+                    emulated_sections++;
+                    gc_policy.afterOperation(dd);
                     continue;
-                } else {
-                    throw std::runtime_error("Unsupported non-unitary functionality.");
                 }
-            } else {
-                throw std::runtime_error("Dynamic cast to NonUnitaryOperation failed.");
+                rejected_sections++;
             }
-            dd->garbageCollect();
-        } else {
-            if (op->isClassicControlledOperation()) {
-                if (auto* cc_op = dynamic_cast<qc::ClassicControlledOperation*>(op.get())) {
-                    const auto         start_index    = static_cast<unsigned short>(cc_op->getParameter().at(0));
-                    const auto         length         = static_cast<unsigned short>(cc_op->getParameter().at(1));
-                    const unsigned int expected_value = cc_op->getExpectedValue();
-                    unsigned int       actual_value   = 0;
-                    for (unsigned int i = 0; i < length; i++) {
-                        actual_value |= (classic_values[start_index + i] ? 1u : 0u) << i;
-                    }
 
-                    //std::clog << "expected " << expected_value << " and actual value was " << actual_value << "\n";
+            if (const auto* run = repeated_blocks ? repeated_blocks->runAt(i) : nullptr; run != nullptr && repeated_blocks->apply(plan, *run, root_edge)) {
+                // all repetitions of the block have been applied at once
+                i += run->length * run->repetitions - 1;
+                op_num += run->length * run->repetitions;
+                gc_policy.afterOperation(dd);
+                continue;
+            }
 
-                    if (actual_value != expected_value) {
-                        continue;
-                    }
+            if (dense_state) {
+                if (instruction.matrix) {
+                    dense_state->applyGate(*instruction.matrix, instruction.qubits.front(), instruction.op->getControls());
+                } else if (instruction.two_target_matrix) {
+                    dense_state->applyTwoTargetGate(*instruction.two_target_matrix, instruction.qubits.at(0), instruction.qubits.at(1), instruction.op->getControls());
                 } else {
-                    throw std::runtime_error("Dynamic cast to ClassicControlledOperation failed.");
+                    dense_state->applyMatrix(instruction.dd);
+                }
+            } else if (factorized_state) {
+                factorized_state->apply(instruction, applicator);
+            } else {
+                applyGate(instruction);
+                if (const auto active = getActiveNodeCount(); dense_threshold > 0 && static_cast<dd::fp>(active) > dense_threshold + static_cast<dd::fp>(dense_other_nodes)) {
+                    if (const auto size = dd->size(root_edge); static_cast<dd::fp>(size) > dense_threshold) {
+                        // the DD is no longer compact, hence the rest of the shot is simulated on a dense state vector
+                        dense_state = std::make_unique<DenseState>(root_edge, n_qubits);
+                        dd->decRef(root_edge);
+                        root_edge = dd::Package::vEdge::zero;
+                        dense_switches++;
+                    } else {
+                        // the state cannot exceed the threshold before the other nodes are outnumbered
+                        dense_other_nodes = active - size;
+                    }
                 }
             }
-            /*std::clog << "[INFO] op " << op_num << " is " << op->getName() << " on " << +op->getTargets().at(0)
-                      << " #controls=" << op->getControls().size()
-                      << " statesize=" << dd->size(root_edge) << "\n";//*/
-
-            auto dd_op = op->getDD(dd);
-            auto tmp   = dd->multiply(dd_op, root_edge);
-            dd->incRef(tmp);
-            dd->decRef(root_edge);
-            root_edge = tmp;
 
-            if (approx_info.step_number > 0 && approx_info.step_fidelity < 1.0) {
+            if (approximating) {
                 if (approx_info.approx_when == ApproximationInfo::FidelityDriven && (op_num + 1) % approx_mod == 0 &&
                     approximation_runs < approx_info.step_number) {
                     //const unsigned int size_before = dd->size(root_edge);
@@ -180,9 +325,141 @@ std::map<std::size_t, bool> CircuitSimulator::single_shot(const bool ignore_nonu
                     }
                 }
             }
-            dd->garbageCollect();
+            if (deadline && !dense_state && !factorized_state && !prefix_cache) {
+                if (const auto fidelity = deadline->check(deadline_ops + i + 1); fidelity < 1.) {
+                    shot_fidelity *= ApproximateByFidelity(fidelity, false, true);
+                    approximation_runs++;
+                }
+            }
+            if (!simulated_levels.empty()) {
+                sifting->afterOperation(root_edge, simulated_levels);
+            }
+            if (prefix_cache && prefix_cache->isCheckpoint(i + 1, prefix_hashes.size())) {
+                prefix_cache->insert(prefix_hashes.at(i), plan, i + 1, root_edge);
+            }
+            gc_policy.afterOperation(dd);
         }
         op_num++;
     }
+    postselection_probability_sum += postselection_probability;
+    postselection_shots++;
+    deadline_ops += plan.size();
+    if (deadline) {
+        // the shots are approximated independently, hence their fidelities do not multiply
+        deadline_fidelity = std::min(deadline_fidelity, shot_fidelity);
+        deadline_fidelity_sum += shot_fidelity;
+        deadline_shots++;
+    }
+
+    if (factorized_state) {
+        largest_component = std::max(largest_component, factorized_state->getLargestComponent());
+        root_edge         = factorized_state->assemble();
+        dd->incRef(root_edge);
+        factorized_state.reset();
+    }
+
+    if (!simulated_levels.empty()) {
+        // report the results with respect to the original qubits
+        qubit_levels.resize(qc->getNqubits());
+        for (std::size_t q = 0; q < qubit_levels.size(); ++q) {
+            const auto level = static_levels.empty() ? q : static_cast<std::size_t>(static_levels.at(q));
+            qubit_levels.at(q) = simulated_levels.at(level);
+        }
+    }
+
+    if (keep_state && compaction && compaction->getNidle() > 0) {
+        // the idle qubits have been removed from the simulated register
+        auto expanded = compaction->expand(dd, root_edge);
+        dd->incRef(expanded);
+        dd->decRef(root_edge);
+        root_edge = expanded;
+    }
     return classic_values;
 }
+
+dd::fp CircuitSimulator::measure(const ExecutionPlan::Instruction& instruction, ExecutionPlan::ClassicalBits& classic_values, const bool post_select_only) {
+    std::vector<dd::Qubit>   sampled_qubits;
+    std::vector<std::size_t> sampled_bits;
+    std::vector<dd::Qubit>   selected_qubits;
+    std::vector<bool>        selected_values;
+
+    for (std::size_t i = 0; i < instruction.qubits.size(); ++i) {
+        const auto bit = instruction.classics.at(i);
+        const auto it  = post_selection.find(bit);
+        if (it != post_selection.end()) {
+            selected_qubits.push_back(instruction.qubits.at(i));
+            selected_values.push_back(it->second);
+            ExecutionPlan::setBit(classic_values, bit, it->second);
+        } else {
+            sampled_qubits.push_back(instruction.qubits.at(i));
+            sampled_bits.push_back(bit);
+        }
+    }
+
+    // the qubits of the instruction refer to the levels of the simulated circuit (unless they have been sifted)
+    selected_qubits = toSimulatedLevels(selected_qubits);
+    sampled_qubits  = toSimulatedLevels(sampled_qubits);
+
+    dd::fp probability = 1.;
+    if (dense_state) {
+        probability = dense_state->postSelect(selected_qubits, selected_values);
+    } else if (factorized_state) {
+        probability = factorized_state->postSelect(selected_qubits, selected_values);
+    } else {
+        probability = PostSelect(dd, root_edge, selected_qubits, selected_values);
+    }
+    if (!post_select_only) {
+        std::vector<bool> results{};
+        if (dense_state) {
+            results = dense_state->measure(sampled_qubits, mt);
+        } else if (factorized_state) {
+            results = factorized_state->measure(sampled_qubits, mt);
+        } else {
+            results = MeasureCollapsing(dd, root_edge, sampled_qubits, mt);
+        }
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            ExecutionPlan::setBit(classic_values, sampled_bits.at(i), results.at(i));
+        }
+    }
+    return probability;
+}
+
+void CircuitSimulator::applyGate(const ExecutionPlan::Instruction& instruction) {
+    const bool         permuted = !std::is_sorted(simulated_levels.begin(), simulated_levels.end());
+    dd::Package::vEdge tmp{};
+    if (instruction.matrix) {
+        if (permuted) {
+            dd::Controls controls{};
+            for (const auto& control: instruction.op->getControls()) {
+                controls.insert({simulated_levels.at(static_cast<std::size_t>(control.qubit)), control.type});
+            }
+            tmp = applicator.apply(*instruction.matrix, simulated_levels.at(static_cast<std::size_t>(instruction.qubits.front())), controls, root_edge);
+        } else {
+            tmp = applicator.apply(*instruction.matrix, instruction.qubits.front(), instruction.op->getControls(), root_edge);
+        }
+    } else if (permuted) {
+        // the pinned DD refers to the initial levels, hence the gate is built for the current ones (once per permutation)
+        std::vector<dd::Qubit> qubits(simulated_levels.size());
+        for (std::size_t q = 0; q < simulated_levels.size(); ++q) {
+            qubits.at(static_cast<std::size_t>(simulated_levels.at(q))) = static_cast<dd::Qubit>(q);
+        }
+        tmp = dd->multiply(sifted_gates.get(instruction, qubits, static_cast<dd::QubitCount>(qubits.size())), root_edge);
+    } else {
+        tmp = dd->multiply(instruction.dd, root_edge);
+    }
+    dd->incRef(tmp);
+    dd->decRef(root_edge);
+    root_edge = tmp;
+}
+
+std::vector<dd::Qubit> CircuitSimulator::toSimulatedLevels(const std::vector<dd::Qubit>& qubits) const {
+    if (simulated_levels.empty()) {
+        return qubits;
+    }
+    std::vector<dd::Qubit> levels{};
+    levels.reserve(qubits.size());
+    for (const auto q: qubits) {
+        levels.push_back(simulated_levels.at(static_cast<std::size_t>(q)));
+    }
+    return levels;
+}
@@ -0,0 +1,41 @@
+#include "DeadlineController.hpp"
+
+#include <algorithm>
+
+void DeadlineController::start(const std::size_t total_ops) {
+    total          = total_ops;
+    start_time     = std::chrono::steady_clock::now();
+    last_ops       = 0;
+    last_time      = 0.;
+    max_interval   = std::max<std::size_t>(1, total_ops / CHECKS);
+    interval       = max_interval;
+    next_check     = interval;
+    infidelity     = 0.;
+    approximations = 0;
+}
+
+dd::fp DeadlineController::check(const std::size_t done_ops) {
+    if (done_ops < next_check) {
+        return 1.;
+    }
+    const auto now       = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    const auto time_per  = done_ops > last_ops ? (now - last_time) / static_cast<double>(done_ops - last_ops) : 0.;
+    const auto remaining = total > done_ops ? total - done_ops : 0;
+    const auto projected = now + time_per * static_cast<double>(remaining);
+    last_ops             = done_ops;
+    last_time            = now;
+
+    if (projected <= deadline) {
+        interval   = std::min(2 * interval, max_interval);
+        next_check = done_ops + interval;
+        infidelity /= 2;
+        return 1.;
+    }
+
+    // behind schedule: approximate more aggressively and check again sooner
+    infidelity = std::min(infidelity == 0. ? INITIAL_INFIDELITY : 2 * infidelity, 1. - min_step_fidelity);
+    interval   = std::max<std::size_t>(1, interval / 2);
+    next_check = done_ops + interval;
+    approximations++;
+    return 1. - infidelity;
+}
@@ -0,0 +1,368 @@
+#include "DenseState.hpp"
+
+#include "taskflow/taskflow.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+DenseState::DenseState(dd::QubitCount nqubits):
+    nqubits(nqubits), amplitudes(1ULL << nqubits) {
+    amplitudes.front() = 1.;
+}
+
+DenseState::DenseState(const dd::Package::vEdge& e, dd::QubitCount nqubits):
+    nqubits(nqubits), amplitudes(1ULL << nqubits) {
+    fill(e, 1., 0);
+}
+
+DenseState::DenseState(const std::vector<std::complex<dd::fp>>& values):
+    nqubits(0), amplitudes(values.begin(), values.end()) {
+    while ((1ULL << nqubits) < values.size()) {
+        ++nqubits;
+    }
+    if ((1ULL << nqubits) != values.size()) {
+        throw std::runtime_error("The number of amplitudes has to be a power of two.");
+    }
+}
+
+void DenseState::fill(const dd::Package::vEdge& e, std::complex<dd::fp> weight, std::size_t offset) {
+    if (e.w == dd::Complex::zero) {
+        return;
+    }
+    const auto w = weight * std::complex<dd::fp>(dd::CTEntry::val(e.w.r), dd::CTEntry::val(e.w.i));
+    if (e.isTerminal()) {
+        amplitudes.at(offset) = w;
+        return;
+    }
+    fill(e.p->e.at(0), w, offset);
+    fill(e.p->e.at(1), w, offset + (1ULL << e.p->v));
+}
+
+void DenseState::applyGate(const dd::GateMatrix& matrix, dd::Qubit target, const dd::Controls& controls) {
+    const std::array<std::complex<dd::fp>, 4> m{std::complex<dd::fp>{matrix.at(0).r, matrix.at(0).i},
+                                                std::complex<dd::fp>{matrix.at(1).r, matrix.at(1).i},
+                                                std::complex<dd::fp>{matrix.at(2).r, matrix.at(2).i},
+                                                std::complex<dd::fp>{matrix.at(3).r, matrix.at(3).i}};
+
+    // the bits of the target and the controls are fixed, all others enumerate the pairs of amplitudes to update
+    std::vector<std::size_t> fixed{static_cast<std::size_t>(target)};
+    std::size_t              value = 0;
+    for (const auto& control: controls) {
+        fixed.push_back(static_cast<std::size_t>(control.qubit));
+        if (control.type == dd::Control::Type::pos) {
+            value |= 1ULL << control.qubit;
+        }
+    }
+    std::sort(fixed.begin(), fixed.end());
+
+    // the amplitudes below the lowest fixed bit form contiguous runs
+    const std::size_t stride = 1ULL << target;
+    const std::size_t length = 1ULL << fixed.front();
+    const std::size_t runs   = (amplitudes.size() >> fixed.size()) / length;
+    auto*             a      = amplitudes.data();
+
+    const auto apply = [a, stride, length, value, &fixed, &m](std::size_t begin, std::size_t end) {
+        for (std::size_t run = begin; run < end; ++run) {
+            std::size_t base = run * length;
+            for (const auto bit: fixed) {
+                base = ((base >> bit) << (bit + 1)) | (base & ((1ULL << bit) - 1));
+            }
+            applyRun(a + (base | value), stride, length, m);
+        }
+    };
+
+    forRanges(runs, apply);
+}
+
+void DenseState::forRanges(std::size_t count, const std::function<void(std::size_t, std::size_t)>& apply) const {
+    if (executor == nullptr || amplitudes.size() < PARALLEL_THRESHOLD || count < 2) {
+        apply(0, count);
+        return;
+    }
+    const std::size_t chunks = std::min<std::size_t>(count, 4 * executor->num_workers());
+    tf::Taskflow      taskflow;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        taskflow.emplace([&apply, chunk, chunks, count]() { apply(chunk * count / chunks, (chunk + 1) * count / chunks); });
+    }
+    executor->run(taskflow).wait();
+}
+
+void DenseState::applyTwoTargetGate(const TwoTargetMatrix& matrix, dd::Qubit target0, dd::Qubit target1, const dd::Controls& controls) {
+    std::vector<std::size_t> fixed{static_cast<std::size_t>(target0), static_cast<std::size_t>(target1)};
+    std::size_t              value = 0;
+    for (const auto& control: controls) {
+        fixed.push_back(static_cast<std::size_t>(control.qubit));
+        if (control.type == dd::Control::Type::pos) {
+            value |= 1ULL << control.qubit;
+        }
+    }
+    std::sort(fixed.begin(), fixed.end());
+
+    // every group of four amplitudes only differs in the bits of the targets
+    const std::size_t offset0 = 1ULL << target0;
+    const std::size_t offset1 = 1ULL << target1;
+    const std::size_t groups  = amplitudes.size() >> fixed.size();
+    auto*             a       = amplitudes.data();
+
+    const auto apply = [a, offset0, offset1, value, &fixed, &matrix](std::size_t begin, std::size_t end) {
+        for (std::size_t group = begin; group < end; ++group) {
+            std::size_t base = group;
+            for (const auto bit: fixed) {
+                base = ((base >> bit) << (bit + 1)) | (base & ((1ULL << bit) - 1));
+            }
+            base |= value;
+            const std::array<std::size_t, 4>          index{base, base | offset0, base | offset1, base | offset0 | offset1};
+            const std::array<std::complex<dd::fp>, 4> in{a[index[0]], a[index[1]], a[index[2]], a[index[3]]};
+            for (std::size_t row = 0; row < 4; ++row) {
+                a[index[row]] = matrix[4 * row] * in[0] + matrix[4 * row + 1] * in[1] + matrix[4 * row + 2] * in[2] + matrix[4 * row + 3] * in[3];
+            }
+        }
+    };
+    forRanges(groups, apply);
+}
+
+DenseState::TwoTargetMatrix DenseState::getTwoTargetMatrix(const dd::Package::mEdge& m, dd::Qubit target0, dd::Qubit target1, const dd::Controls& controls) {
+    std::size_t base = 0;
+    for (const auto& control: controls) {
+        if (control.type == dd::Control::Type::pos) {
+            base |= 1ULL << control.qubit;
+        }
+    }
+    const auto toIndex = [base, target0, target1](std::size_t i) {
+        return base | ((i & 1U) << target0) | (((i >> 1U) & 1U) << target1);
+    };
+
+    TwoTargetMatrix matrix{};
+    for (std::size_t row = 0; row < 4; ++row) {
+        for (std::size_t col = 0; col < 4; ++col) {
+            const auto i = toIndex(row);
+            const auto j = toIndex(col);
+            // follow the path of the entry (i, j) down to the terminal
+            auto                 e = m;
+            std::complex<dd::fp> w = 1.;
+            while (e.w != dd::Complex::zero) {
+                w *= std::complex<dd::fp>(dd::CTEntry::val(e.w.r), dd::CTEntry::val(e.w.i));
+                if (e.isTerminal()) {
+                    matrix.at(4 * row + col) = w;
+                    break;
+                }
+                const auto v = static_cast<std::size_t>(e.p->v);
+                e            = e.p->e.at(dd::RADIX * ((i >> v) & 1U) + ((j >> v) & 1U));
+            }
+        }
+    }
+    return matrix;
+}
+
+void DenseState::applyRun(std::complex<dd::fp>* a, std::size_t stride, std::size_t length, const std::array<std::complex<dd::fp>, 4>& m) {
+    std::size_t j = 0;
+    if constexpr (std::is_same_v<dd::fp, double>) {
+        auto* d = reinterpret_cast<double*>(a);
+#if defined(__AVX512F__)
+        // four complex numbers per register; (re, im) * c = (re, im) * c.re -/+ (im, re) * c.im
+        const auto cmul = [](__m512d x, __m512d cr, __m512d ci) {
+            return _mm512_fmaddsub_pd(x, cr, _mm512_mul_pd(_mm512_permute_pd(x, 0x55), ci));
+        };
+        const __m512d m00r = _mm512_set1_pd(m[0].real()), m00i = _mm512_set1_pd(m[0].imag());
+        const __m512d m01r = _mm512_set1_pd(m[1].real()), m01i = _mm512_set1_pd(m[1].imag());
+        const __m512d m10r = _mm512_set1_pd(m[2].real()), m10i = _mm512_set1_pd(m[2].imag());
+        const __m512d m11r = _mm512_set1_pd(m[3].real()), m11i = _mm512_set1_pd(m[3].imag());
+        for (; j + 4 <= length; j += 4) {
+            const __m512d a0 = _mm512_loadu_pd(d + 2 * j);
+            const __m512d a1 = _mm512_loadu_pd(d + 2 * (j + stride));
+            _mm512_storeu_pd(d + 2 * j, _mm512_add_pd(cmul(a0, m00r, m00i), cmul(a1, m01r, m01i)));
+            _mm512_storeu_pd(d + 2 * (j + stride), _mm512_add_pd(cmul(a0, m10r, m10i), cmul(a1, m11r, m11i)));
+        }
+#elif defined(__AVX2__)
+        // two complex numbers per register; (re, im) * c = (re, im) * c.re -/+ (im, re) * c.im
+        const auto cmul = [](__m256d x, __m256d cr, __m256d ci) {
+            return _mm256_addsub_pd(_mm256_mul_pd(x, cr), _mm256_mul_pd(_mm256_permute_pd(x, 0x5), ci));
+        };
+        const __m256d m00r = _mm256_set1_pd(m[0].real()), m00i = _mm256_set1_pd(m[0].imag());
+        const __m256d m01r = _mm256_set1_pd(m[1].real()), m01i = _mm256_set1_pd(m[1].imag());
+        const __m256d m10r = _mm256_set1_pd(m[2].real()), m10i = _mm256_set1_pd(m[2].imag());
+        const __m256d m11r = _mm256_set1_pd(m[3].real()), m11i = _mm256_set1_pd(m[3].imag());
+        for (; j + 2 <= length; j += 2) {
+            const __m256d a0 = _mm256_loadu_pd(d + 2 * j);
+            const __m256d a1 = _mm256_loadu_pd(d + 2 * (j + stride));
+            _mm256_storeu_pd(d + 2 * j, _mm256_add_pd(cmul(a0, m00r, m00i), cmul(a1, m01r, m01i)));
+            _mm256_storeu_pd(d + 2 * (j + stride), _mm256_add_pd(cmul(a0, m10r, m10i), cmul(a1, m11r, m11i)));
+        }
+#else
+        static_cast<void>(d);
+#endif
+    }
+    for (; j < length; ++j) {
+        const auto a0 = a[j];
+        const auto a1 = a[j + stride];
+        a[j]          = m[0] * a0 + m[1] * a1;
+        a[j + stride] = m[2] * a0 + m[3] * a1;
+    }
+}
+
+std::string DenseState::getSimdExtension() {
+#if defined(__AVX512F__)
+    return std::is_same_v<dd::fp, double> ? "avx512" : "none";
+#elif defined(__AVX2__)
+    return std::is_same_v<dd::fp, double> ? "avx2" : "none";
+#else
+    return "none";
+#endif
+}
+
+void DenseState::applyMatrix(const dd::Package::mEdge& m) {
+    Amplitudes result(amplitudes.size());
+    multiply(m, 1., 0, 0, result);
+    amplitudes = std::move(result);
+}
+
+void DenseState::multiply(const dd::Package::mEdge& m, std::complex<dd::fp> weight, std::size_t in, std::size_t out, Amplitudes& result) const {
+    if (m.w == dd::Complex::zero) {
+        return;
+    }
+    const auto w = weight * std::complex<dd::fp>(dd::CTEntry::val(m.w.r), dd::CTEntry::val(m.w.i));
+    if (m.isTerminal()) {
+        result[out] += w * amplitudes[in];
+        return;
+    }
+    const std::size_t half = 1ULL << m.p->v;
+    if (m.p->ident) {
+        for (std::size_t i = 0; i < 2 * half; ++i) {
+            result[out + i] += w * amplitudes[in + i];
+        }
+        return;
+    }
+    for (std::size_t row = 0; row < dd::RADIX; ++row) {
+        for (std::size_t col = 0; col < dd::RADIX; ++col) {
+            multiply(m.p->e.at(dd::RADIX * row + col), w, in + col * half, out + row * half, result);
+        }
+    }
+}
+
+dd::fp DenseState::probabilityOfOne(std::size_t mask) const {
+    dd::fp probability = 0;
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        if ((i & mask) != 0) {
+            probability += std::norm(amplitudes[i]);
+        }
+    }
+    return probability;
+}
+
+void DenseState::project(std::size_t mask, std::size_t value, dd::fp factor) {
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        amplitudes[i] = (i & mask) == value ? amplitudes[i] * factor : 0.;
+    }
+}
+
+std::vector<bool> DenseState::measure(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    std::uniform_real_distribution<dd::fp> dist(0.0L, 1.0L);
+    std::vector<bool>                      results(qubits.size());
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        const std::size_t mask = 1ULL << qubits.at(i);
+        const auto        p1   = probabilityOfOne(mask);
+        results.at(i)          = dist(generator) < p1;
+        project(mask, results.at(i) ? mask : 0, 1. / std::sqrt(results.at(i) ? p1 : 1. - p1));
+    }
+    return results;
+}
+
+void DenseState::reset(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    const auto results = measure(qubits, generator);
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        if (!results.at(i)) {
+            continue;
+        }
+        // move the amplitudes onto |0>
+        const std::size_t mask = 1ULL << qubits.at(i);
+        for (std::size_t j = 0; j < amplitudes.size(); ++j) {
+            if ((j & mask) != 0) {
+                amplitudes[j & ~mask] = amplitudes[j];
+                amplitudes[j]         = 0.;
+            }
+        }
+    }
+}
+
+dd::fp DenseState::postSelect(const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes) {
+    if (qubits.size() != outcomes.size()) {
+        throw std::runtime_error("Post-selection: Sizes of qubits and outcomes mismatch.");
+    }
+    std::size_t mask  = 0;
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        mask |= 1ULL << qubits.at(i);
+        if (outcomes.at(i)) {
+            value |= 1ULL << qubits.at(i);
+        }
+    }
+    if (mask == 0) {
+        return 1.;
+    }
+    dd::fp probability = 0;
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        if ((i & mask) == value) {
+            probability += std::norm(amplitudes[i]);
+        }
+    }
+    if (probability <= 0) {
+        throw std::runtime_error("Cannot project onto an outcome with probability zero (e.g., an impossible post-selection).");
+    }
+    project(mask, value, 1. / std::sqrt(probability));
+    return probability;
+}
+
+std::string DenseState::measureAll(bool collapse, std::mt19937_64& generator) {
+    std::uniform_real_distribution<dd::fp> dist(0.0L, 1.0L);
+    dd::fp                                 threshold = dist(generator);
+    std::size_t                            index     = 0;
+    for (; index + 1 < amplitudes.size(); ++index) {
+        threshold -= std::norm(amplitudes[index]);
+        if (threshold < 0) {
+            break;
+        }
+    }
+    if (collapse) {
+        std::fill(amplitudes.begin(), amplitudes.end(), 0.);
+        amplitudes.at(index) = 1.;
+    }
+    return toLevelString(index);
+}
+
+std::map<std::string, std::size_t> DenseState::sample(std::size_t shots, std::mt19937_64& generator) const {
+    std::vector<dd::fp> cumulative(amplitudes.size());
+    dd::fp              sum = 0;
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        sum += std::norm(amplitudes[i]);
+        cumulative[i] = sum;
+    }
+
+    std::uniform_real_distribution<dd::fp> dist(0.0L, sum);
+    std::map<std::size_t, std::size_t>     counts;
+    for (std::size_t shot = 0; shot < shots; ++shot) {
+        const auto it = std::upper_bound(cumulative.begin(), cumulative.end(), dist(generator));
+        counts[std::min(static_cast<std::size_t>(it - cumulative.begin()), amplitudes.size() - 1)]++;
+    }
+
+    std::map<std::string, std::size_t> results;
+    for (const auto& [index, count]: counts) {
+        results[toLevelString(index)] = count;
+    }
+    return results;
+}
+
+std::string DenseState::toLevelString(std::size_t index) const {
+    std::string result(nqubits, '0');
+    for (std::size_t level = 0; level < nqubits; ++level) {
+        if ((index >> level) & 1ULL) {
+            result[nqubits - 1 - level] = '1';
+        }
+    }
+    return result;
+}
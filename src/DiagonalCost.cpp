@@ -0,0 +1,283 @@
+#include "DiagonalCost.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+DiagonalCost DiagonalCost::fromIsing(const dd::QubitCount nqubits, const std::vector<dd::fp>& h, const Couplings& J, const dd::fp offset) {
+    if (h.size() > nqubits) {
+        throw std::runtime_error("There are more local fields than qubits.");
+    }
+    // h z = h - 2 h x and J z_i z_j = J - 2 J x_i - 2 J x_j + 4 J x_i x_j
+    DiagonalCost cost(nqubits, offset);
+    for (std::size_t q = 0; q < h.size(); ++q) {
+        cost.offset += h.at(q);
+        cost.addLinear(static_cast<dd::Qubit>(q), -2. * h.at(q));
+    }
+    for (const auto& [qubits, coefficient]: J) {
+        const auto [i, j] = qubits;
+        cost.checkQubit(i);
+        cost.checkQubit(j);
+        cost.offset += coefficient;
+        if (i != j) {
+            cost.addLinear(i, -2. * coefficient);
+            cost.addLinear(j, -2. * coefficient);
+            cost.addQuadratic(i, j, 4. * coefficient);
+        }
+    }
+    return cost;
+}
+
+DiagonalCost DiagonalCost::fromQubo(const dd::QubitCount nqubits, const Couplings& Q, const dd::fp offset) {
+    DiagonalCost cost(nqubits, offset);
+    for (const auto& [qubits, coefficient]: Q) {
+        cost.addQuadratic(qubits.first, qubits.second, coefficient);
+    }
+    return cost;
+}
+
+void DiagonalCost::addLinear(const dd::Qubit qubit, const dd::fp coefficient) {
+    checkQubit(qubit);
+    linear.at(static_cast<std::size_t>(qubit)) += coefficient;
+}
+
+void DiagonalCost::addQuadratic(const dd::Qubit first, const dd::Qubit second, const dd::fp coefficient) {
+    checkQubit(first);
+    checkQubit(second);
+    if (first == second) {
+        addLinear(first, coefficient);
+        return;
+    }
+    quadratic[std::minmax(first, second)] += coefficient;
+}
+
+dd::fp DiagonalCost::evaluate(const std::string& outcome) const {
+    if (outcome.size() != nqubits) {
+        throw std::runtime_error("The outcome '" + outcome + "' does not have one bit per qubit.");
+    }
+    const auto bit = [&](const dd::Qubit q) { return outcome.at(nqubits - 1 - static_cast<std::size_t>(q)) == '1'; };
+
+    auto value = offset;
+    for (std::size_t q = 0; q < nqubits; ++q) {
+        value += bit(static_cast<dd::Qubit>(q)) ? linear.at(q) : 0.;
+    }
+    for (const auto& [qubits, coefficient]: quadratic) {
+        value += (bit(qubits.first) && bit(qubits.second)) ? coefficient : 0.;
+    }
+    return value;
+}
+
+dd::fp DiagonalCost::expectation(const dd::Package::vEdge& state, const std::vector<dd::Qubit>& levels) const {
+    if (state.w.approximatelyZero()) {
+        return 0.;
+    }
+    if (state.isTerminal() ? nqubits != 0 : static_cast<std::size_t>(state.p->v) + 1 != nqubits) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the state.");
+    }
+    const auto                                        terms = byLevel(levels);
+    std::unordered_map<dd::Package::vNode*, NodeSums> sums{};
+    const auto&                                       root = accumulate(state.p, static_cast<dd::Qubit>(nqubits - 1), terms, sums);
+    return probability(state.w) * (offset * root.mass + root.cost);
+}
+
+dd::fp DiagonalCost::expectation(const DenseState::Amplitudes& amplitudes, const std::vector<dd::Qubit>& levels) const {
+    if (amplitudes.size() != (1ULL << nqubits)) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the state.");
+    }
+    const auto terms = byLevel(levels);
+    dd::fp     value = 0.;
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        const auto p = std::norm(amplitudes[i]);
+        if (p == 0.) {
+            continue;
+        }
+        auto cost = offset;
+        for (std::size_t l = 0; l < nqubits; ++l) {
+            if (((i >> l) & 1U) == 0) {
+                continue;
+            }
+            cost += terms.at(l).linear;
+            for (const auto& [k, coefficient]: terms.at(l).couplings) {
+                cost += ((i >> k) & 1U) != 0 ? coefficient : 0.;
+            }
+        }
+        value += p * cost;
+    }
+    return value;
+}
+
+DiagonalCost::CVaR DiagonalCost::cvar(const dd::Package::vEdge& state, const dd::fp alpha, const std::vector<dd::Qubit>& levels, const std::size_t max_outcomes, const dd::fp tolerance) const {
+    if (alpha <= 0. || alpha > 1.) {
+        throw std::runtime_error("The CVaR level alpha has to be in (0, 1].");
+    }
+    if (state.w.approximatelyZero()) {
+        throw std::runtime_error("The state has no outcomes.");
+    }
+    if (state.isTerminal() ? nqubits != 0 : static_cast<std::size_t>(state.p->v) + 1 != nqubits) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the state.");
+    }
+
+    // best-first search, where the priority of a partial path is the probability of its most probable completion
+    using Partial = std::tuple<dd::fp, dd::fp, dd::Package::vNode*, dd::Qubit, std::vector<bool>>;
+    const auto lower = [](const Partial& a, const Partial& b) { return std::get<0>(a) < std::get<0>(b); };
+    std::priority_queue<Partial, std::vector<Partial>, decltype(lower)> queue(lower);
+    std::unordered_map<dd::Package::vNode*, dd::fp>                     maxima{};
+
+    const auto root_level = static_cast<dd::Qubit>(nqubits - 1);
+    const auto root_p     = probability(state.w);
+    queue.emplace(root_p * maxProbability(state.p, root_level, maxima), root_p, state.p, root_level, std::vector<bool>(nqubits, false));
+
+    std::vector<std::pair<dd::fp, dd::fp>> outcomes{};
+    dd::fp                                 covered = 0.;
+    while (!queue.empty() && outcomes.size() < max_outcomes && covered < 1. - tolerance) {
+        [[maybe_unused]] auto [bound, prefix, node, level, bits] = queue.top();
+        queue.pop();
+        if (level < 0) {
+            outcomes.emplace_back(prefix, evaluate(toOutcome(bits, levels)));
+            covered += prefix;
+            continue;
+        }
+        for (std::size_t b = 0; b < 2; ++b) {
+            const auto& e = node->e.at(b);
+            if (e.w.approximatelyZero()) {
+                continue;
+            }
+            auto child_bits                                = bits;
+            child_bits.at(static_cast<std::size_t>(level)) = b == 1;
+            const auto p                                   = prefix * probability(e.w);
+            queue.emplace(p * maxProbability(e.p, static_cast<dd::Qubit>(level - 1), maxima), p, e.p, static_cast<dd::Qubit>(level - 1), std::move(child_bits));
+        }
+    }
+    return tail(outcomes, alpha);
+}
+
+DiagonalCost::CVaR DiagonalCost::cvar(const DenseState::Amplitudes& amplitudes, const dd::fp alpha, const std::vector<dd::Qubit>& levels) const {
+    if (alpha <= 0. || alpha > 1.) {
+        throw std::runtime_error("The CVaR level alpha has to be in (0, 1].");
+    }
+    if (amplitudes.size() != (1ULL << nqubits)) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the state.");
+    }
+    std::vector<std::pair<dd::fp, dd::fp>> outcomes{};
+    std::vector<bool>                      bits(nqubits, false);
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        const auto p = std::norm(amplitudes[i]);
+        if (p == 0.) {
+            continue;
+        }
+        for (std::size_t l = 0; l < nqubits; ++l) {
+            bits.at(l) = ((i >> l) & 1U) != 0;
+        }
+        outcomes.emplace_back(p, evaluate(toOutcome(bits, levels)));
+    }
+    if (outcomes.empty()) {
+        throw std::runtime_error("The state has no outcomes.");
+    }
+    return tail(outcomes, alpha);
+}
+
+std::vector<DiagonalCost::LevelTerms> DiagonalCost::byLevel(const std::vector<dd::Qubit>& levels) const {
+    const auto toLevel = [&](const dd::Qubit q) { return levels.empty() ? static_cast<std::size_t>(q) : static_cast<std::size_t>(levels.at(static_cast<std::size_t>(q))); };
+
+    std::vector<LevelTerms> terms(nqubits);
+    for (std::size_t q = 0; q < nqubits; ++q) {
+        terms.at(toLevel(static_cast<dd::Qubit>(q))).linear = linear.at(q);
+    }
+    for (const auto& [qubits, coefficient]: quadratic) {
+        const auto [low, high] = std::minmax(toLevel(qubits.first), toLevel(qubits.second));
+        terms.at(high).couplings.emplace_back(low, coefficient);
+    }
+    return terms;
+}
+
+const DiagonalCost::NodeSums& DiagonalCost::accumulate(dd::Package::vNode* node, const dd::Qubit level, const std::vector<LevelTerms>& terms, std::unordered_map<dd::Package::vNode*, NodeSums>& sums) {
+    if (const auto it = sums.find(node); it != sums.end()) {
+        return it->second;
+    }
+    NodeSums result{};
+    if (level < 0) {
+        result.mass = 1.;
+        return sums.emplace(node, std::move(result)).first->second;
+    }
+
+    const auto l = static_cast<std::size_t>(level);
+    result.ones.assign(l + 1, 0.);
+    for (std::size_t b = 0; b < 2; ++b) {
+        const auto& e = node->e.at(b);
+        if (e.w.approximatelyZero()) {
+            continue;
+        }
+        const auto  p     = probability(e.w);
+        const auto& child = accumulate(e.p, static_cast<dd::Qubit>(level - 1), terms, sums);
+        result.mass += p * child.mass;
+        result.cost += p * child.cost;
+        for (std::size_t k = 0; k < l; ++k) {
+            result.ones.at(k) += p * child.ones.at(k);
+        }
+        if (b == 1) {
+            // the terms of this level are only paid by the outcomes setting it to 1
+            auto cost = terms.at(l).linear * child.mass;
+            for (const auto& [k, coefficient]: terms.at(l).couplings) {
+                cost += coefficient * child.ones.at(k);
+            }
+            result.cost += p * cost;
+            result.ones.at(l) = p * child.mass;
+        }
+    }
+    return sums.emplace(node, std::move(result)).first->second;
+}
+
+dd::fp DiagonalCost::maxProbability(dd::Package::vNode* node, const dd::Qubit level, std::unordered_map<dd::Package::vNode*, dd::fp>& maxima) {
+    if (level < 0) {
+        return 1.;
+    }
+    if (const auto it = maxima.find(node); it != maxima.end()) {
+        return it->second;
+    }
+    dd::fp result = 0.;
+    for (const auto& e: node->e) {
+        if (!e.w.approximatelyZero()) {
+            result = std::max(result, probability(e.w) * maxProbability(e.p, static_cast<dd::Qubit>(level - 1), maxima));
+        }
+    }
+    maxima.emplace(node, result);
+    return result;
+}
+
+std::string DiagonalCost::toOutcome(const std::vector<bool>& level_bits, const std::vector<dd::Qubit>& levels) const {
+    std::string outcome(nqubits, '0');
+    for (std::size_t q = 0; q < nqubits; ++q) {
+        const auto l                = levels.empty() ? q : static_cast<std::size_t>(levels.at(q));
+        outcome.at(nqubits - 1 - q) = level_bits.at(l) ? '1' : '0';
+    }
+    return outcome;
+}
+
+void DiagonalCost::checkQubit(const dd::Qubit qubit) const {
+    if (qubit < 0 || static_cast<std::size_t>(qubit) >= nqubits) {
+        throw std::runtime_error("Qubit " + std::to_string(qubit) + " is not part of the cost function.");
+    }
+}
+
+DiagonalCost::CVaR DiagonalCost::tail(std::vector<std::pair<dd::fp, dd::fp>>& outcomes, const dd::fp alpha) {
+    dd::fp covered = 0.;
+    for (const auto& [p, cost]: outcomes) {
+        covered += p;
+    }
+    std::sort(outcomes.begin(), outcomes.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+
+    // the lowest costs up to a probability of alpha (the last outcome only partially)
+    const auto target = alpha * covered;
+    dd::fp     mass   = 0.;
+    dd::fp     sum    = 0.;
+    for (const auto& [p, cost]: outcomes) {
+        const auto taken = std::min(p, target - mass);
+        mass += taken;
+        sum += taken * cost;
+        if (mass >= target) {
+            break;
+        }
+    }
+    return {sum / target, covered, outcomes.size()};
+}
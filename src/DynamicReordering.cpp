@@ -0,0 +1,123 @@
+#include "DynamicReordering.hpp"
+
+#include <algorithm>
+#include <array>
+
+void DynamicReordering::afterOperation(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels) {
+    if (root.isTerminal()) {
+        return;
+    }
+    // the state of n qubits has at least n nodes
+    baseline = std::max(baseline, static_cast<std::size_t>(root.p->v) + 1);
+    if (static_cast<double>(activeNodes()) > growth_factor * static_cast<double>(baseline)) {
+        sift(root, levels);
+        baseline = activeNodes();
+    }
+}
+
+void DynamicReordering::sift(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels) {
+    if (root.isTerminal()) {
+        return;
+    }
+    runs++;
+    const auto top = static_cast<dd::Qubit>(root.p->v);
+    for (std::size_t qubit = 0; qubit < levels.size(); ++qubit) {
+        auto        level     = levels.at(qubit);
+        std::size_t best_size = activeNodes();
+        auto        best      = level;
+
+        // move the variable to the bottom, then to the top and finally back to the best level found
+        while (level > 0) {
+            const auto size = swap(root, levels, --level);
+            if (size < best_size) {
+                best_size = size;
+                best      = level;
+            }
+        }
+        while (level < top) {
+            const auto size = swap(root, levels, level++);
+            if (size < best_size) {
+                best_size = size;
+                best      = level;
+            }
+        }
+        while (level > best) {
+            swap(root, levels, --level);
+        }
+    }
+}
+
+std::size_t DynamicReordering::swap(dd::Package::vEdge& root, std::vector<dd::Qubit>& levels, dd::Qubit level) {
+    auto swapped = swapLevels(dd, root, level);
+    dd->incRef(swapped);
+    dd->decRef(root);
+    root = swapped;
+    swaps++;
+
+    for (auto& l: levels) {
+        if (l == level) {
+            l = static_cast<dd::Qubit>(level + 1);
+        } else if (l == level + 1) {
+            l = level;
+        }
+    }
+    return activeNodes();
+}
+
+dd::Package::vEdge DynamicReordering::swapLevels(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, dd::Qubit level) {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    if (e.isTerminal() || e.p->v <= level) {
+        return e;
+    }
+    SwapCache cache{};
+    return scale(dd, swapNode(dd, e.p, level, cache), e.w);
+}
+
+dd::Package::vEdge DynamicReordering::swapNode(std::unique_ptr<dd::Package>& dd, dd::Package::vNode* p, dd::Qubit level, SwapCache& cache) {
+    const auto it = cache.find(p);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    std::array<dd::Package::vEdge, 2> edges{};
+    if (p->v > level + 1) {
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            const auto& c = p->e.at(i);
+            edges.at(i)   = c.w == dd::Complex::zero ? dd::Package::vEdge::zero : scale(dd, swapNode(dd, c.p, level, cache), c.w);
+        }
+        const auto r = dd->makeDDNode(p->v, edges);
+        cache.emplace(p, r);
+        return r;
+    }
+
+    // p is at level + 1: exchange the roles of the two levels, i.e., the grandchild reached via (a, b) is now reached via (b, a)
+    for (std::size_t b = 0; b < edges.size(); ++b) {
+        std::array<dd::Package::vEdge, 2> grandchildren{};
+        for (std::size_t a = 0; a < grandchildren.size(); ++a) {
+            const auto& c = p->e.at(a);
+            if (c.w == dd::Complex::zero || c.p->e.at(b).w == dd::Complex::zero) {
+                grandchildren.at(a) = dd::Package::vEdge::zero;
+            } else {
+                grandchildren.at(a) = scale(dd, c.p->e.at(b), c.w);
+            }
+        }
+        if (grandchildren.at(0).w == dd::Complex::zero && grandchildren.at(1).w == dd::Complex::zero) {
+            edges.at(b) = dd::Package::vEdge::zero;
+        } else {
+            edges.at(b) = dd->makeDDNode(level, grandchildren);
+        }
+    }
+    const auto r = dd->makeDDNode(static_cast<dd::Qubit>(level + 1), edges);
+    cache.emplace(p, r);
+    return r;
+}
+
+dd::Package::vEdge DynamicReordering::scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, const dd::Complex& w) {
+    const auto ar = dd::CTEntry::val(e.w.r);
+    const auto ai = dd::CTEntry::val(e.w.i);
+    const auto br = dd::CTEntry::val(w.r);
+    const auto bi = dd::CTEntry::val(w.i);
+    return {e.p, dd->cn.lookup(ar * br - ai * bi, ar * bi + ai * br)};
+}
@@ -0,0 +1,351 @@
+#include "EmulatedOperations.hpp"
+
+#include "dd/GateMatrixDefinitions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+dd::Package::mEdge EmulatedOperations::get(const dd::QubitCount n, const EmulatedOperation& operation) {
+    const auto operation_key = key(n, operation);
+    if (const auto it = cache.find(operation_key); it != cache.end()) {
+        hits++;
+        return it->second;
+    }
+    const auto e = build(n, operation);
+    dd->incRef(e);
+    cache.emplace(operation_key, e);
+    return e;
+}
+
+void EmulatedOperations::apply(const EmulatedOperation& operation, dd::Package::vEdge& state, const dd::QubitCount n) {
+    auto tmp = dd->multiply(get(n, operation), state);
+    dd->incRef(tmp);
+    dd->decRef(state);
+    state = tmp;
+}
+
+void EmulatedOperations::clear() {
+    for (const auto& [operation_key, e]: cache) {
+        dd->decRef(e);
+    }
+    cache.clear();
+}
+
+std::string EmulatedOperations::key(const dd::QubitCount n, const EmulatedOperation& operation) {
+    std::string k = std::to_string(static_cast<int>(operation.kind)) + ":" + std::to_string(n) + ":";
+    for (const auto q: operation.qubits) {
+        k += std::to_string(q) + ",";
+    }
+    k += ":";
+    for (const auto q: operation.other) {
+        k += std::to_string(q) + ",";
+    }
+    k += ":" + std::to_string(operation.constant) + ":" + std::to_string(operation.modulus) + ":";
+    for (const auto& control: operation.controls) {
+        k += std::to_string(control.qubit) + (control.type == dd::Control::Type::pos ? "+" : "-");
+    }
+    return k;
+}
+
+dd::Package::mEdge EmulatedOperations::build(const dd::QubitCount n, const EmulatedOperation& operation) {
+    const auto r = operation.qubits.size();
+    if (r == 0) {
+        throw std::runtime_error("Emulated operations require at least one register qubit.");
+    }
+    const auto bitOf = [](const unsigned long long value, const std::size_t k) {
+        return k < std::numeric_limits<unsigned long long>::digits && ((value >> k) & 1U) != 0;
+    };
+
+    switch (operation.kind) {
+        case EmulatedOperation::Kind::QFT:
+            if (r > MAX_PERMUTATION_QUBITS) {
+                throw std::runtime_error("The emulated QFT acts on at most " + std::to_string(MAX_PERMUTATION_QUBITS) + " register qubits.");
+            }
+            return qft(n, operation.qubits, operation.controls);
+        case EmulatedOperation::Kind::InverseQFT: {
+            auto forward = operation;
+            forward.kind = EmulatedOperation::Kind::QFT;
+            return dd->conjugateTranspose(get(n, forward));
+        }
+        case EmulatedOperation::Kind::AddConstant: {
+            std::vector<Cell> cells{};
+            for (std::size_t k = 0; k < r; ++k) {
+                const auto a = bitOf(operation.constant, k);
+                cells.push_back(adderCell(operation.qubits.at(k), k, r, {}, [a](const Assignment&) { return a; }));
+            }
+            return carryPermutation(n, cells, r - 1, operation.controls);
+        }
+        case EmulatedOperation::Kind::AddRegister: {
+            if (operation.other.size() != r) {
+                throw std::runtime_error("The registers of an addition must have the same size.");
+            }
+            // wire r - 1 + k passes bit k of x to the qubit of the sum
+            std::vector<Cell> cells{};
+            for (std::size_t k = 0; k < r; ++k) {
+                const auto x = r - 1 + k;
+                cells.push_back({operation.qubits.at(k), {x}, [x](const bool out, const bool in, const Assignment& wire) { return out == in && wire.at(x) == in; }});
+                cells.push_back(adderCell(operation.other.at(k), k, r, {x}, [x](const Assignment& wire) { return wire.at(x); }));
+            }
+            return carryPermutation(n, cells, 2 * r - 1, operation.controls);
+        }
+        case EmulatedOperation::Kind::MultiplyModulo: {
+            if (r > MAX_PERMUTATION_QUBITS) {
+                throw std::runtime_error("Emulated multiplications act on at most " + std::to_string(MAX_PERMUTATION_QUBITS) + " register qubits.");
+            }
+            const auto modulus = operation.modulus;
+            if (modulus == 0 || modulus > (1ULL << r)) {
+                throw std::runtime_error("The modulus " + std::to_string(modulus) + " does not fit into the register.");
+            }
+            const auto a = operation.constant % modulus;
+            if (std::gcd(a, modulus) != 1) {
+                throw std::runtime_error("Multiplication by " + std::to_string(operation.constant) + " modulo " + std::to_string(modulus) + " is not invertible.");
+            }
+            return permutation(n, operation.qubits, operation.controls, [&](const auto x) { return x < modulus ? (a * x) % modulus : x; });
+        }
+        case EmulatedOperation::Kind::LessThan: {
+            if (operation.other.size() != 1) {
+                throw std::runtime_error("A comparison requires a single target qubit.");
+            }
+            const auto c = operation.constant;
+            if (r < std::numeric_limits<unsigned long long>::digits && (c >> r) != 0) {
+                // every register value is smaller
+                std::vector<Cell> cells{{operation.other.front(), {}, [](const bool out, const bool in, const Assignment&) { return out != in; }}};
+                for (const auto q: operation.qubits) {
+                    cells.push_back({q, {}, [](const bool out, const bool in, const Assignment&) { return out == in; }});
+                }
+                return carryPermutation(n, cells, 0, operation.controls);
+            }
+            // wire k tells whether the k + 1 least significant bits of the register are smaller than those of the constant
+            std::vector<Cell> cells{{operation.other.front(), {r - 1}, [r](const bool out, const bool in, const Assignment& wire) { return out == (in != wire.at(r - 1)); }}};
+            for (std::size_t k = 0; k < r; ++k) {
+                const auto ck    = bitOf(c, k);
+                auto       wires = k > 0 ? std::vector<std::size_t>{k - 1, k} : std::vector<std::size_t>{k};
+                cells.push_back({operation.qubits.at(k), wires, [k, ck](const bool out, const bool in, const Assignment& wire) {
+                                     const bool borrow = k > 0 && wire.at(k - 1);
+                                     return out == in && wire.at(k) == ((!in && ck) || (in == ck && borrow));
+                                 }});
+            }
+            return carryPermutation(n, cells, r, operation.controls);
+        }
+        default:
+            throw std::runtime_error("Unknown emulated operation.");
+    }
+}
+
+dd::Package::mEdge EmulatedOperations::qft(const dd::QubitCount n, const std::vector<dd::Qubit>& qubits, const dd::Controls& controls) {
+    std::vector<bool> used(n, false);
+    auto              all_qubits = qubits;
+    for (const auto& control: controls) {
+        all_qubits.push_back(control.qubit);
+    }
+    for (const auto q: all_qubits) {
+        if (q < 0 || q >= static_cast<dd::Qubit>(n) || used.at(static_cast<std::size_t>(q))) {
+            throw std::runtime_error("The qubits of an emulated operation must be distinct qubits of the circuit.");
+        }
+        used.at(static_cast<std::size_t>(q)) = true;
+    }
+
+    auto u = dd->makeIdent(n);
+
+    const auto applyGate = [&](const dd::GateMatrix& mat, dd::Controls gate_controls, const dd::Qubit target) {
+        gate_controls.insert(controls.begin(), controls.end());
+        u = dd->multiply(dd->makeGateDD(mat, n, gate_controls, target), u);
+    };
+
+    // qubits.back() is the most significant qubit of the register
+    for (auto j = qubits.size(); j-- > 0;) {
+        applyGate(dd::Hmat, {}, qubits.at(j));
+        for (auto k = j; k-- > 0;) {
+            applyGate(dd::Phasemat(dd::PI / static_cast<dd::fp>(1ULL << (j - k))), {dd::Control{qubits.at(k)}}, qubits.at(j));
+        }
+    }
+    for (std::size_t i = 0; i < qubits.size() / 2; ++i) {
+        const auto a = qubits.at(i);
+        const auto b = qubits.at(qubits.size() - 1 - i);
+        applyGate(dd::Xmat, {dd::Control{a}}, b);
+        applyGate(dd::Xmat, {dd::Control{b}}, a);
+        applyGate(dd::Xmat, {dd::Control{a}}, b);
+    }
+    return u;
+}
+
+dd::Package::mEdge EmulatedOperations::permutation(const dd::QubitCount n, std::vector<dd::Qubit> qubits, const dd::Controls& controls, const std::function<unsigned long long(unsigned long long)>& f) {
+    const auto register_mask = (1ULL << qubits.size()) - 1;
+
+    // the controls are additional bits above the register, on which the permutation acts as the identity
+    unsigned long long control_mask  = 0;
+    unsigned long long control_value = 0;
+    for (const auto& control: controls) {
+        control_mask |= 1ULL << qubits.size();
+        if (control.type == dd::Control::Type::pos) {
+            control_value |= 1ULL << qubits.size();
+        }
+        qubits.push_back(control.qubit);
+    }
+    if (qubits.size() > MAX_PERMUTATION_QUBITS) {
+        throw std::runtime_error("Emulated permutations act on at most " + std::to_string(MAX_PERMUTATION_QUBITS) + " qubits (including controls).");
+    }
+
+    std::vector<int> bit_of_level(n, -1);
+    for (std::size_t b = 0; b < qubits.size(); ++b) {
+        const auto q = qubits.at(b);
+        if (q < 0 || q >= static_cast<dd::Qubit>(n) || bit_of_level.at(static_cast<std::size_t>(q)) != -1) {
+            throw std::runtime_error("The qubits of an emulated operation must be distinct qubits of the circuit.");
+        }
+        bit_of_level.at(static_cast<std::size_t>(q)) = static_cast<int>(b);
+    }
+
+    const auto        values = 1ULL << qubits.size();
+    Mapping           mapping{};
+    std::vector<bool> images(values, false);
+    mapping.reserve(values);
+    for (unsigned long long z = 0; z < values; ++z) {
+        auto image = z;
+        if ((z & control_mask) == control_value) {
+            const auto y = f(z & register_mask);
+            if (y > register_mask) {
+                throw std::runtime_error("The emulated operation maps a basis state outside of its register.");
+            }
+            image = (z & ~register_mask) | y;
+        }
+        if (images.at(image)) {
+            throw std::runtime_error("The emulated operation is not a permutation of the basis states.");
+        }
+        images.at(image) = true;
+        mapping.emplace_back(z, image);
+    }
+    return buildPermutation(static_cast<dd::Qubit>(n - 1), bit_of_level, mapping);
+}
+
+dd::Package::mEdge EmulatedOperations::buildPermutation(const dd::Qubit level, const std::vector<int>& bit_of_level, const Mapping& mapping) {
+    if (mapping.empty()) {
+        return dd::Package::mEdge::zero;
+    }
+    if (level < 0) {
+        return dd::Package::mEdge::one;
+    }
+
+    std::array<dd::Package::mEdge, dd::NEDGE> edges{dd::Package::mEdge::zero, dd::Package::mEdge::zero, dd::Package::mEdge::zero, dd::Package::mEdge::zero};
+    const auto                                bit = bit_of_level.at(static_cast<std::size_t>(level));
+    if (bit < 0) {
+        edges[0] = edges[3] = buildPermutation(static_cast<dd::Qubit>(level - 1), bit_of_level, mapping);
+    } else {
+        // edge 2 * i + j leads to the entries with output bit i and input bit j
+        std::array<Mapping, dd::NEDGE> parts{};
+        for (const auto& [x, y]: mapping) {
+            parts.at(2 * ((y >> bit) & 1U) + ((x >> bit) & 1U)).emplace_back(x, y);
+        }
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            edges.at(i) = buildPermutation(static_cast<dd::Qubit>(level - 1), bit_of_level, parts.at(i));
+        }
+    }
+    return dd->makeDDNode(level, edges);
+}
+
+EmulatedOperations::Cell EmulatedOperations::adderCell(const dd::Qubit qubit, const std::size_t k, const std::size_t r, std::vector<std::size_t> wires, const std::function<bool(const Assignment&)>& addend) {
+    // the carry out of the most significant bit is dropped
+    if (k > 0) {
+        wires.push_back(k - 1);
+    }
+    if (k + 1 < r) {
+        wires.push_back(k);
+    }
+    return {qubit, wires, [k, r, addend](const bool out, const bool in, const Assignment& wire) {
+                const bool b     = addend(wire);
+                const bool carry = k > 0 && wire.at(k - 1);
+                if (out != ((in != b) != carry)) {
+                    return false;
+                }
+                return k + 1 == r || wire.at(k) == ((in && b) || (carry && (in || b)));
+            }};
+}
+
+dd::Package::mEdge EmulatedOperations::carryPermutation(const dd::QubitCount n, std::vector<Cell> cells, std::size_t wires, const dd::Controls& controls) {
+    if (!controls.empty()) {
+        // wire `wires + j` tells whether one of the first j + 1 controls is not satisfied, the last one turns the cells into the identity
+        const auto inactive = wires + controls.size() - 1;
+        for (auto& cell: cells) {
+            cell.wires.push_back(inactive);
+            cell.allows = [inactive, allows = std::move(cell.allows)](const bool out, const bool in, const Assignment& wire) {
+                return wire.at(inactive) ? out == in : allows(out, in, wire);
+            };
+        }
+        const auto first_failed = wires;
+        for (const auto& control: controls) {
+            const auto failed    = wires++;
+            const bool first     = failed == first_failed;
+            const bool satisfied = control.type == dd::Control::Type::pos;
+            auto       reads     = first ? std::vector<std::size_t>{failed} : std::vector<std::size_t>{failed - 1, failed};
+            cells.push_back({control.qubit, reads, [failed, first, satisfied](const bool out, const bool in, const Assignment& wire) {
+                                 return out == in && wire.at(failed) == ((!first && wire.at(failed - 1)) || in != satisfied);
+                             }});
+        }
+    }
+
+    CarryChain chain{std::vector<std::optional<Cell>>(n), std::vector<dd::Qubit>(wires, static_cast<dd::Qubit>(n))};
+    for (auto& cell: cells) {
+        const auto q = cell.qubit;
+        if (q < 0 || q >= static_cast<dd::Qubit>(n) || chain.cell_of_level.at(static_cast<std::size_t>(q))) {
+            throw std::runtime_error("The qubits of an emulated operation must be distinct qubits of the circuit.");
+        }
+        for (const auto w: cell.wires) {
+            chain.last_level.at(w) = std::min(chain.last_level.at(w), q);
+        }
+        chain.cell_of_level.at(static_cast<std::size_t>(q)) = std::move(cell);
+    }
+    return buildCarryChain(static_cast<dd::Qubit>(n - 1), chain, {Assignment{}});
+}
+
+dd::Package::mEdge EmulatedOperations::buildCarryChain(const dd::Qubit level, CarryChain& chain, const std::set<Assignment>& open) {
+    if (level < 0) {
+        return dd::Package::mEdge::one;
+    }
+    if (const auto it = chain.built.find({level, open}); it != chain.built.end()) {
+        return it->second;
+    }
+
+    std::array<dd::Package::mEdge, dd::NEDGE> edges{dd::Package::mEdge::zero, dd::Package::mEdge::zero, dd::Package::mEdge::zero, dd::Package::mEdge::zero};
+    const auto&                               cell = chain.cell_of_level.at(static_cast<std::size_t>(level));
+    if (!cell) {
+        edges[0] = edges[3] = buildCarryChain(static_cast<dd::Qubit>(level - 1), chain, open);
+    } else {
+        // edge 2 * i + j leads to the entries with output bit i and input bit j
+        for (std::size_t i = 0; i < dd::NEDGE; ++i) {
+            const bool            out = i / 2 == 1;
+            const bool            in  = i % 2 == 1;
+            std::set<Assignment> next{};
+            for (const auto& assignment: open) {
+                std::vector<std::size_t> fresh{};
+                for (const auto w: cell->wires) {
+                    if (assignment.count(w) == 0) {
+                        fresh.push_back(w);
+                    }
+                }
+                for (unsigned long long values = 0; values < (1ULL << fresh.size()); ++values) {
+                    auto extended = assignment;
+                    for (std::size_t b = 0; b < fresh.size(); ++b) {
+                        extended[fresh.at(b)] = ((values >> b) & 1U) != 0;
+                    }
+                    if (!cell->allows(out, in, extended)) {
+                        continue;
+                    }
+                    for (const auto w: cell->wires) {
+                        if (chain.last_level.at(w) == level) {
+                            extended.erase(w);
+                        }
+                    }
+                    next.insert(extended);
+                }
+            }
+            if (!next.empty()) {
+                edges.at(i) = buildCarryChain(static_cast<dd::Qubit>(level - 1), chain, next);
+            }
+        }
+    }
+    const auto e = dd->makeDDNode(level, edges);
+    chain.built.emplace(std::pair{level, open}, e);
+    return e;
+}
@@ -0,0 +1,248 @@
+#include "EngineSelector.hpp"
+
+#include "DenseState.hpp"
+#include "LightconePass.hpp"
+#include "QubitOrdering.hpp"
+#include "StabilizerTableau.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <vector>
+
+EngineSelector::Features EngineSelector::analyze(const qc::QuantumComputation& qc) {
+    Features features{};
+    features.nqubits = qc.getNqubits();
+
+    std::vector<std::size_t> qubit_depth(features.nqubits, 0);
+    std::size_t              two_qubit_gates = 0;
+    std::size_t              clifford_gates  = 0;
+    bool                     in_prefix       = true;
+    for (const auto& op: qc) {
+        const auto type = op->getType();
+        if (type == qc::Barrier || type == qc::Snapshot || type == qc::ShowProbabilities) {
+            continue;
+        }
+        if (type == qc::Measure) {
+            if (features.measurements == MeasurementStructure::None) {
+                features.measurements = MeasurementStructure::Final;
+            }
+            in_prefix = false;
+            continue;
+        }
+        if (op->isClassicControlledOperation() || op->isNonUnitaryOperation() || features.measurements != MeasurementStructure::None) {
+            // resets, classically-controlled operations and gates after measurements require one simulation per shot
+            features.measurements = MeasurementStructure::MidCircuit;
+        }
+        if (!op->isStandardOperation()) {
+            features.only_standard_operations = false;
+        }
+
+        std::set<dd::Qubit> qubits{};
+        LightconePass::collectQubits(*op, qubits);
+        std::size_t layer = 0;
+        for (const auto q: qubits) {
+            layer = std::max(layer, qubit_depth.at(static_cast<std::size_t>(q)) + 1);
+        }
+        for (const auto q: qubits) {
+            qubit_depth.at(static_cast<std::size_t>(q)) = layer;
+        }
+        features.depth = std::max(features.depth, layer);
+
+        features.ngates++;
+        if (qubits.size() > 1) {
+            two_qubit_gates++;
+        }
+        const bool clifford = op->isStandardOperation() && StabilizerTableau::isClifford(*op);
+        if (clifford) {
+            clifford_gates++;
+        }
+        in_prefix = in_prefix && clifford;
+        if (in_prefix) {
+            features.clifford_prefix++;
+        }
+    }
+    if (features.ngates > 0) {
+        features.two_qubit_fraction = static_cast<dd::fp>(two_qubit_gates) / static_cast<dd::fp>(features.ngates);
+        features.clifford_fraction  = static_cast<dd::fp>(clifford_gates) / static_cast<dd::fp>(features.ngates);
+    }
+
+    // the crossing operations are counted for the candidate splits in the original and the reordered qubit order
+    std::set<dd::Qubit> splits{};
+    for (const auto split: {features.nqubits / 4, features.nqubits / 2, 3 * features.nqubits / 4}) {
+        if (split > 0 && split < features.nqubits) {
+            splits.insert(static_cast<dd::Qubit>(split));
+        }
+    }
+    const auto middle = static_cast<dd::Qubit>(features.nqubits / 2);
+
+    std::vector<dd::Qubit> identity(features.nqubits);
+    std::iota(identity.begin(), identity.end(), 0);
+    features.cut_decisions = countDecisions(qc, identity, splits);
+
+    const auto reordered = countDecisions(qc, QubitOrdering::compute(qc), splits);
+    const auto maximum   = [](const std::map<dd::Qubit, std::size_t>& decisions) {
+        std::size_t result = 0;
+        for (const auto& [split, count]: decisions) {
+            result = std::max(result, count);
+        }
+        return result;
+    };
+    const auto at = [](const std::map<dd::Qubit, std::size_t>& decisions, const dd::Qubit split) {
+        const auto it = decisions.find(split);
+        return it == decisions.end() ? 0 : it->second;
+    };
+    // the widest cut bounds the DD, the middle one determines the slices of the hybrid simulator
+    if (std::pair{maximum(reordered), at(reordered, middle)} < std::pair{maximum(features.cut_decisions), at(features.cut_decisions, middle)}) {
+        features.cut_decisions = reordered;
+        features.reorder       = true;
+    }
+    features.decisions     = at(features.cut_decisions, middle);
+    features.max_decisions = maximum(features.cut_decisions);
+    return features;
+}
+
+EngineSelector::Prediction EngineSelector::predict(const Features& features, std::size_t nthreads, dd::QubitCount max_dense_qubits) {
+    constexpr auto infinity = std::numeric_limits<dd::fp>::infinity();
+
+    const auto n       = static_cast<dd::fp>(features.nqubits);
+    const auto log_n   = std::log2(std::max(n, 1.));
+    const auto gates   = std::max<std::size_t>(features.ngates, 1);
+    const auto threads = std::log2(static_cast<dd::fp>(std::max<std::size_t>(nthreads, 1)));
+    // the number of nodes on a level of the state DD is bounded by the operations crossing it (and the depth)
+    const auto bond     = static_cast<dd::fp>(std::min({features.max_decisions, features.depth, static_cast<std::size_t>(features.nqubits / 2)}));
+    const bool hybrid   = features.only_standard_operations && features.measurements != MeasurementStructure::MidCircuit && !features.initial_state;
+    const auto dense_ok = features.nqubits <= max_dense_qubits;
+
+    Prediction prediction{};
+
+    // leading Clifford gates cost O(n^2 / 64) word operations on the tableau
+    const auto tableau   = features.clifford_prefix > 0 ? std::log2(static_cast<dd::fp>(features.clifford_prefix)) + 2 * log_n - 6 : -infinity;
+    const auto remaining = features.ngates - features.clifford_prefix;
+    const auto dd_gates  = remaining > 0 ? std::log2(static_cast<dd::fp>(remaining)) + log_n + bond + DD_NODE_COST : -infinity;
+    prediction.log_costs[Engine::DD] = std::max(logSum(tableau, dd_gates), 0.);
+
+    if (dense_ok) {
+        const auto parallel                 = (1ULL << features.nqubits) >= DenseState::PARALLEL_THRESHOLD ? threads : 0.;
+        prediction.log_costs[Engine::Dense] = std::log2(static_cast<dd::fp>(gates)) + n - parallel;
+    } else {
+        prediction.log_costs[Engine::Dense] = infinity;
+    }
+
+    if (hybrid && dense_ok && features.nqubits > 1) {
+        // every decision doubles the number of slices, each of which adds its product state to the amplitude vector
+        const auto half                      = std::floor(n / 2);
+        const auto slice                     = std::log2(static_cast<dd::fp>(gates)) + std::log2(half) + std::min(static_cast<dd::fp>(features.depth), std::floor(half / 2)) + DD_NODE_COST;
+        prediction.log_costs[Engine::Hybrid] = static_cast<dd::fp>(features.decisions) + logSum(slice, n) - threads;
+    } else {
+        prediction.log_costs[Engine::Hybrid] = infinity;
+    }
+
+    if (hybrid) {
+        // the matrix DDs of the contracted sub-circuits square the number of nodes across a level
+        prediction.log_costs[Engine::Path] = std::log2(static_cast<dd::fp>(gates)) + log_n + std::min(2 * bond, n) + DD_NODE_COST;
+    } else {
+        prediction.log_costs[Engine::Path] = infinity;
+    }
+
+    // the unitary simulator does not produce measurement outcomes
+    prediction.log_costs[Engine::Unitary] = infinity;
+
+    for (const auto engine: {Engine::Dense, Engine::Hybrid, Engine::Path}) {
+        if (prediction.log_costs.at(engine) < prediction.log_costs.at(prediction.engine)) {
+            prediction.engine = engine;
+        }
+    }
+
+    const auto crossing = std::to_string(features.decisions) + " of " + std::to_string(features.ngates) + " gates cross the middle of the register" +
+                          (features.reorder ? " (after reordering the qubits)" : "");
+    switch (prediction.engine) {
+        case Engine::DD:
+            prediction.reason = "the state DD is expected to stay compact with at most 2^" + std::to_string(static_cast<std::size_t>(bond)) + " nodes per level since " + crossing;
+            if (features.clifford_prefix > 0) {
+                prediction.reason += ", and the first " + std::to_string(features.clifford_prefix) + " gates are simulated with a stabilizer tableau";
+            }
+            break;
+        case Engine::Dense:
+            prediction.reason = "the state DD is expected to grow to 2^" + std::to_string(static_cast<std::size_t>(bond)) + " nodes per level since " + crossing +
+                                ", while all 2^" + std::to_string(features.nqubits) + " amplitudes fit into memory";
+            break;
+        case Engine::Hybrid:
+            prediction.reason = "only " + crossing + ", so simulating 2^" + std::to_string(features.decisions) + " independent slices is cheaper than simulating the full state";
+            break;
+        default:
+            prediction.reason = "contracting the circuit is expected to be cheaper than simulating it gate by gate since " + crossing;
+            break;
+    }
+    return prediction;
+}
+
+std::map<std::string, std::string> EngineSelector::toStatistics(const Features& features, const Prediction& prediction) {
+    std::map<std::string, std::string> statistics{
+            {"engine", toString(prediction.engine)},
+            {"engine_reason", prediction.reason},
+            {"depth", std::to_string(features.depth)},
+            {"two_qubit_fraction", std::to_string(features.two_qubit_fraction)},
+            {"clifford_fraction", std::to_string(features.clifford_fraction)},
+            {"cut_decisions", std::to_string(features.decisions)},
+            {"max_cut_decisions", std::to_string(features.max_decisions)},
+    };
+    for (const auto& [engine, cost]: prediction.log_costs) {
+        statistics["predicted_log2_cost_" + toString(engine)] = std::isinf(cost) ? "n/a" : std::to_string(cost);
+    }
+    return statistics;
+}
+
+std::string EngineSelector::toString(Engine engine) {
+    switch (engine) {
+        case Engine::DD:
+            return "dd";
+        case Engine::Dense:
+            return "dense";
+        case Engine::Hybrid:
+            return "hybrid";
+        case Engine::Path:
+            return "path";
+        default:
+            return "unitary";
+    }
+}
+
+std::map<dd::Qubit, std::size_t> EngineSelector::countDecisions(const qc::QuantumComputation& qc, const std::vector<dd::Qubit>& levels, const std::set<dd::Qubit>& splits) {
+    std::map<dd::Qubit, std::size_t> decisions{};
+    for (const auto split: splits) {
+        decisions[split] = 0;
+    }
+    for (const auto& op: qc) {
+        const auto type = op->getType();
+        if (type == qc::Barrier || type == qc::Snapshot || type == qc::ShowProbabilities || type == qc::Measure) {
+            continue;
+        }
+        std::set<dd::Qubit> qubits{};
+        LightconePass::collectQubits(*op, qubits);
+        if (qubits.size() < 2) {
+            continue;
+        }
+        std::set<dd::Qubit> op_levels{};
+        for (const auto q: qubits) {
+            op_levels.insert(levels.at(static_cast<std::size_t>(q)));
+        }
+        // the operation crosses every split between its lowest and its highest level
+        for (auto it = decisions.upper_bound(*op_levels.begin()); it != decisions.end() && it->first <= *op_levels.rbegin(); ++it) {
+            it->second++;
+        }
+    }
+    return decisions;
+}
+
+dd::fp EngineSelector::logSum(dd::fp a, dd::fp b) {
+    if (std::isinf(a) && a < 0) {
+        return b;
+    }
+    if (std::isinf(b) && b < 0) {
+        return a;
+    }
+    return std::max(a, b) + std::log2(1 + std::exp2(-std::abs(a - b)));
+}
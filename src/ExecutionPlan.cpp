@@ -0,0 +1,94 @@
+#include "ExecutionPlan.hpp"
+
+#include "GateApplicator.hpp"
+
+#include <stdexcept>
+#include <string>
+
+ExecutionPlan::ExecutionPlan(const qc::QuantumComputation& qc, std::unique_ptr<dd::Package>& dd, bool directGates):
+    dd(dd), nqubits(qc.getNqubits()), ncbits(qc.getNcbits()) {
+    instructions.reserve(qc.getNops());
+
+    for (const auto& op: qc) {
+        Instruction instruction{};
+
+        if (op->isClassicControlledOperation()) {
+            auto* cc_op = dynamic_cast<qc::ClassicControlledOperation*>(op.get());
+            if (cc_op == nullptr) {
+                throw std::runtime_error("Dynamic cast to ClassicControlledOperation failed.");
+            }
+            const auto& [start, length] = cc_op->getControlRegister();
+            if (start + length > ncbits) {
+                throw std::runtime_error("Classical control register exceeds the classical bits of the circuit.");
+            }
+            instruction.op        = cc_op->getOperation();
+            instruction.condition = lowerCondition(start, length, cc_op->getExpectedValue());
+        } else if (op->isNonUnitaryOperation()) {
+            auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get());
+            if (nu_op == nullptr) {
+                throw std::runtime_error(std::string("Dynamic cast to NonUnitaryOperation failed for '") + op->getName() + "'.");
+            }
+            if (op->getType() == qc::Barrier) {
+                continue;
+            }
+            instruction.op     = nu_op;
+            instruction.qubits = nu_op->getTargets();
+            if (op->getType() == qc::Measure) {
+                instruction.kind     = Kind::Measure;
+                instruction.classics = nu_op->getClassics();
+                if (instruction.qubits.size() != instruction.classics.size()) {
+                    throw std::runtime_error("Measurement: Sizes of quantum and classic register mismatch.");
+                }
+            } else if (op->getType() == qc::Reset) {
+                instruction.kind = Kind::Reset;
+            } else {
+                throw std::runtime_error(std::string("Unsupported non-unitary functionality '") + op->getName() + "'.");
+            }
+            instructions.emplace_back(std::move(instruction));
+            continue;
+        } else {
+            instruction.op = op.get();
+        }
+
+        instruction.qubits = instruction.op->getTargets();
+        for (const auto& control: instruction.op->getControls()) {
+            instruction.qubits.push_back(control.qubit);
+        }
+        if (directGates) {
+            instruction.matrix = GateApplicator::getGateMatrix(*instruction.op);
+        }
+        if (!instruction.matrix) {
+            instruction.dd = instruction.op->getDD(dd);
+            dd->incRef(instruction.dd);
+            if (directGates && instruction.op->getTargets().size() == 2) {
+                const auto& targets           = instruction.op->getTargets();
+                instruction.two_target_matrix = DenseState::getTwoTargetMatrix(instruction.dd, targets.front(), targets.back(), instruction.op->getControls());
+            }
+        }
+        instructions.emplace_back(std::move(instruction));
+    }
+}
+
+ExecutionPlan::~ExecutionPlan() {
+    for (const auto& instruction: instructions) {
+        if (instruction.kind == Kind::Gate && !instruction.matrix) {
+            dd->decRef(instruction.dd);
+        }
+    }
+}
+
+std::vector<ExecutionPlan::Condition> ExecutionPlan::lowerCondition(std::size_t start, std::size_t length, unsigned int expectedValue) {
+    std::vector<Condition> condition{};
+    for (std::size_t i = 0; i < length; ++i) {
+        const std::size_t bit  = start + i;
+        const std::size_t word = bit / 64;
+        if (condition.empty() || condition.back().word != word) {
+            condition.push_back({word, 0, 0});
+        }
+        condition.back().mask |= 1ULL << (bit % 64);
+        if (i < 32 && ((expectedValue >> i) & 1U)) {
+            condition.back().expected |= 1ULL << (bit % 64);
+        }
+    }
+    return condition;
+}
@@ -0,0 +1,212 @@
+#include "FactorizedState.hpp"
+
+#include "LightconePass.hpp"
+#include "RegisterCompaction.hpp"
+#include "Simulator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+FactorizedState::FactorizedState(std::unique_ptr<dd::Package>& dd, dd::QubitCount nqubits, GateCache& gates):
+    dd(dd), nqubits(nqubits), gates(gates), componentOf(nqubits) {
+    components.reserve(nqubits);
+    for (dd::QubitCount q = 0; q < nqubits; ++q) {
+        Component component{{static_cast<dd::Qubit>(q)}, dd->makeZeroState(1)};
+        dd->incRef(component.state);
+        components.emplace_back(std::move(component));
+        componentOf.at(q) = q;
+    }
+}
+
+FactorizedState::~FactorizedState() {
+    for (const auto& component: components) {
+        dd->decRef(component.state);
+    }
+}
+
+void FactorizedState::apply(const ExecutionPlan::Instruction& instruction, GateApplicator& applicator) {
+    std::set<dd::Qubit> qubits{};
+    LightconePass::collectQubits(*instruction.op, qubits);
+    auto& component = components.at(join(qubits));
+
+    dd::Package::vEdge tmp{};
+    if (instruction.matrix) {
+        dd::Controls controls{};
+        for (const auto& control: instruction.op->getControls()) {
+            controls.insert({localIndex(component, control.qubit), control.type});
+        }
+        tmp = applicator.apply(*instruction.matrix, localIndex(component, instruction.qubits.front()), controls, component.state);
+    } else {
+        tmp = dd->multiply(gates.get(instruction, component.qubits, nqubits), component.state);
+    }
+    dd->incRef(tmp);
+    dd->decRef(component.state);
+    component.state = tmp;
+}
+
+dd::Package::mEdge FactorizedState::GateCache::get(const ExecutionPlan::Instruction& instruction, const std::vector<dd::Qubit>& qubits, dd::QubitCount nqubits) {
+    auto key = Key{&instruction, qubits};
+    if (const auto it = cache.find(key); it != cache.end()) {
+        hits++;
+        return it->second;
+    }
+
+    // build the gate on the register of the component
+    std::vector<dd::Qubit> position(nqubits, -1);
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        position.at(static_cast<std::size_t>(qubits.at(i))) = static_cast<dd::Qubit>(i);
+    }
+    auto op = instruction.op->clone();
+    RegisterCompaction::remap(*op, position, static_cast<dd::QubitCount>(qubits.size()));
+    const auto e = op->getDD(dd);
+    dd->incRef(e);
+    cache.emplace(std::move(key), e);
+    return e;
+}
+
+void FactorizedState::GateCache::clear() {
+    for (const auto& [key, e]: cache) {
+        dd->decRef(e);
+    }
+    cache.clear();
+}
+
+std::vector<bool> FactorizedState::measure(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    std::vector<bool> results(qubits.size());
+    for (const auto& [index, entry]: group(qubits)) {
+        const auto& [levels, positions] = entry;
+        const auto outcomes             = Simulator::MeasureCollapsing(dd, components.at(index).state, levels, generator);
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            results.at(positions.at(i)) = outcomes.at(i);
+        }
+    }
+    return results;
+}
+
+void FactorizedState::reset(const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    for (const auto& [index, entry]: group(qubits)) {
+        Simulator::ResetQubits(dd, components.at(index).state, entry.first, generator);
+    }
+}
+
+dd::fp FactorizedState::postSelect(const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes) {
+    dd::fp probability = 1.;
+    for (const auto& [index, entry]: group(qubits)) {
+        const auto&       [levels, positions] = entry;
+        std::vector<bool> values{};
+        for (const auto position: positions) {
+            values.push_back(outcomes.at(position));
+        }
+        probability *= Simulator::PostSelect(dd, components.at(index).state, levels, values);
+    }
+    return probability;
+}
+
+dd::Package::vEdge FactorizedState::assemble() {
+    if (components.empty()) {
+        return dd::Package::vEdge::one;
+    }
+    Component register_state = components.front();
+    for (std::size_t i = 1; i < components.size(); ++i) {
+        register_state = merge(register_state, components.at(i));
+    }
+    return register_state.state;
+}
+
+std::size_t FactorizedState::join(const std::set<dd::Qubit>& qubits) {
+    std::set<std::size_t> indices{};
+    for (const auto qubit: qubits) {
+        indices.insert(componentOf.at(static_cast<std::size_t>(qubit)));
+    }
+    if (indices.size() == 1) {
+        return *indices.begin();
+    }
+
+    Component joined = components.at(*indices.begin());
+    for (auto it = std::next(indices.begin()); it != indices.end(); ++it) {
+        joined = merge(joined, components.at(*it));
+    }
+    dd->incRef(joined.state);
+    // erase from the back so that the remaining indices stay valid
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+        dd->decRef(components.at(*it).state);
+        components.erase(components.begin() + static_cast<std::ptrdiff_t>(*it));
+    }
+    largest = std::max(largest, joined.qubits.size());
+    components.emplace_back(std::move(joined));
+
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        for (const auto qubit: components.at(i).qubits) {
+            componentOf.at(static_cast<std::size_t>(qubit)) = i;
+        }
+    }
+    return components.size() - 1;
+}
+
+FactorizedState::Component FactorizedState::merge(const Component& a, const Component& b) {
+    Component merged{};
+    std::merge(a.qubits.begin(), a.qubits.end(), b.qubits.begin(), b.qubits.end(), std::back_inserter(merged.qubits));
+
+    std::vector<bool> fromA(merged.qubits.size());
+    for (std::size_t i = 0; i < merged.qubits.size(); ++i) {
+        fromA.at(i) = std::binary_search(a.qubits.begin(), a.qubits.end(), merged.qubits.at(i));
+    }
+    ProductCache cache{};
+    merged.state = product(a.state, b.state, fromA, cache);
+    return merged;
+}
+
+std::map<std::size_t, std::pair<std::vector<dd::Qubit>, std::vector<std::size_t>>> FactorizedState::group(const std::vector<dd::Qubit>& qubits) const {
+    std::map<std::size_t, std::pair<std::vector<dd::Qubit>, std::vector<std::size_t>>> groups{};
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        const auto index = componentOf.at(static_cast<std::size_t>(qubits.at(i)));
+        auto&      entry = groups[index];
+        entry.first.push_back(localIndex(components.at(index), qubits.at(i)));
+        entry.second.push_back(i);
+    }
+    return groups;
+}
+
+dd::Qubit FactorizedState::localIndex(const Component& component, dd::Qubit qubit) const {
+    const auto it = std::lower_bound(component.qubits.begin(), component.qubits.end(), qubit);
+    return static_cast<dd::Qubit>(std::distance(component.qubits.begin(), it));
+}
+
+dd::Package::vEdge FactorizedState::product(const dd::Package::vEdge& a, const dd::Package::vEdge& b, const std::vector<bool>& fromA, ProductCache& cache) {
+    if (a.w == dd::Complex::zero || b.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    const auto w = multiply(a.w, b.w);
+    if (a.isTerminal() && b.isTerminal()) {
+        return dd::Package::vEdge::terminal(w);
+    }
+
+    const auto key = std::pair{a.p, b.p};
+    auto       it  = cache.find(key);
+    if (it == cache.end()) {
+        // the levels of both operands determine the level of the product
+        const auto levelA = a.isTerminal() ? -1 : static_cast<int>(a.p->v);
+        const auto levelB = b.isTerminal() ? -1 : static_cast<int>(b.p->v);
+        const auto level  = static_cast<dd::Qubit>(levelA + levelB + 1);
+
+        std::array<dd::Package::vEdge, 2> edges{};
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            if (fromA.at(static_cast<std::size_t>(level))) {
+                edges.at(i) = product(a.p->e.at(i), {b.p, dd::Complex::one}, fromA, cache);
+            } else {
+                edges.at(i) = product({a.p, dd::Complex::one}, b.p->e.at(i), fromA, cache);
+            }
+        }
+        it = cache.emplace(key, dd->makeDDNode(level, edges)).first;
+    }
+    return {it->second.p, multiply(it->second.w, w)};
+}
+
+dd::Complex FactorizedState::multiply(const dd::Complex& a, const dd::Complex& b) {
+    const auto ar = dd::CTEntry::val(a.r);
+    const auto ai = dd::CTEntry::val(a.i);
+    const auto br = dd::CTEntry::val(b.r);
+    const auto bi = dd::CTEntry::val(b.i);
+    return dd->cn.lookup(ar * br - ai * bi, ar * bi + ai * br);
+}
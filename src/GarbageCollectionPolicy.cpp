@@ -0,0 +1,69 @@
+#include "GarbageCollectionPolicy.hpp"
+
+#include <chrono>
+
+bool GarbageCollectionPolicy::afterOperation(std::unique_ptr<dd::Package>& dd, bool measurement) {
+    ops_since_collection++;
+
+    switch (info.collect_when) {
+        case GarbageCollectionInfo::Default:
+            return collect(dd, false);
+        case GarbageCollectionInfo::EveryK:
+            if (ops_since_collection >= info.every_k) {
+                return collect(dd, true);
+            }
+            return false;
+        case GarbageCollectionInfo::DeadRatio:
+            if (deadNodeRatio(dd) >= info.threshold) {
+                return collect(dd, true);
+            }
+            return false;
+        case GarbageCollectionInfo::Memory:
+            // the live state alone may exceed the threshold, so only collect again once the tables grew by it
+            if (estimatedMemory(dd) >= memory_after_collection + info.threshold) {
+                const bool collected    = collect(dd, true);
+                memory_after_collection = estimatedMemory(dd);
+                return collected;
+            }
+            return false;
+        case GarbageCollectionInfo::Measurements:
+            if (measurement) {
+                return collect(dd, true);
+            }
+            return false;
+        default:
+            throw std::runtime_error("Unknown garbage collection mode.");
+    }
+}
+
+bool GarbageCollectionPolicy::collect(std::unique_ptr<dd::Package>& dd, bool force) {
+    const auto t1        = std::chrono::steady_clock::now();
+    const bool collected = dd->garbageCollect(force);
+    const auto t2        = std::chrono::steady_clock::now();
+
+    gc_calls++;
+    gc_time += std::chrono::duration<double>(t2 - t1).count();
+    if (collected) {
+        gc_runs++;
+    }
+    if (force) {
+        ops_since_collection = 0;
+    }
+    return collected;
+}
+
+double GarbageCollectionPolicy::deadNodeRatio(const std::unique_ptr<dd::Package>& dd) {
+    const auto nodes = dd->vUniqueTable.getNodeCount() + dd->mUniqueTable.getNodeCount();
+    if (nodes == 0) {
+        return 0.;
+    }
+    const auto active = dd->vUniqueTable.getActiveNodeCount() + dd->mUniqueTable.getActiveNodeCount();
+    return static_cast<double>(nodes - active) / static_cast<double>(nodes);
+}
+
+double GarbageCollectionPolicy::estimatedMemory(const std::unique_ptr<dd::Package>& dd) {
+    const auto bytes = dd->vUniqueTable.getNodeCount() * sizeof(dd::Package::vNode) +
+                       dd->mUniqueTable.getNodeCount() * sizeof(dd::Package::mNode) +
+                       dd->cn.complexTable.getCount() * sizeof(dd::CTEntry);
+    return static_cast<double>(bytes) / (1024. * 1024.);
+}
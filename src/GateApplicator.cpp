@@ -0,0 +1,159 @@
+#include "GateApplicator.hpp"
+
+#include <stdexcept>
+#include <string>
+
+dd::Package::vEdge GateApplicator::apply(const dd::GateMatrix& mat, dd::Qubit t, const dd::Controls& controls, const dd::Package::vEdge& e) {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    if (e.isTerminal() || t > e.p->v) {
+        throw std::runtime_error("Target qubit " + std::to_string(t) + " is not contained in the state.");
+    }
+
+    matrix        = mat;
+    target        = t;
+    lowestControl = -1;
+    controlType.assign(static_cast<std::size_t>(e.p->v) + 1, 0);
+    for (const auto& control: controls) {
+        if (control.qubit == target || control.qubit > e.p->v) {
+            throw std::runtime_error("Invalid control qubit " + std::to_string(control.qubit) + ".");
+        }
+        controlType.at(control.qubit) = (control.type == dd::Control::Type::pos) ? 1 : -1;
+        if (control.qubit < target && (lowestControl < 0 || control.qubit < lowestControl)) {
+            lowestControl = control.qubit;
+        }
+    }
+
+    // the caches refer to nodes of the current state only, which may be collected afterwards
+    aboveCache.clear();
+    mixCache.clear();
+
+    const auto r = applyAbove(e.p);
+    if (r.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    return scale(r, toValue(e.w));
+}
+
+dd::Package::vEdge GateApplicator::applyAbove(dd::Package::vNode* p) {
+    const dd::Qubit level = p->v;
+
+    if (level == target) {
+        const auto [x, y] = mix(p->e[0], p->e[1], static_cast<dd::Qubit>(level - 1));
+        return dd->makeDDNode(level, std::array{x, y});
+    }
+
+    const auto it = aboveCache.find(p);
+    if (it != aboveCache.end()) {
+        return it->second;
+    }
+
+    std::array<dd::Package::vEdge, dd::RADIX> edges{};
+    for (std::size_t i = 0; i < dd::RADIX; ++i) {
+        const auto& c = p->e[i];
+        if (c.w == dd::Complex::zero || !isActive(level, i)) {
+            // untouched subtree
+            edges[i] = c;
+            continue;
+        }
+        const auto r = applyAbove(c.p);
+        edges[i]     = (r.w == dd::Complex::zero) ? dd::Package::vEdge::zero : scale(r, toValue(c.w));
+    }
+    const auto r  = dd->makeDDNode(level, edges);
+    aboveCache[p] = r;
+    return r;
+}
+
+std::pair<dd::Package::vEdge, dd::Package::vEdge> GateApplicator::mix(const dd::Package::vEdge& x, const dd::Package::vEdge& y, dd::Qubit level) {
+    if (level < lowestControl || lowestControl < 0) {
+        // no more controls below, i.e., the gate acts on the whole remaining subtrees
+        return {combine(matrix[0], x, matrix[1], y), combine(matrix[2], x, matrix[3], y)};
+    }
+    if (x.w == dd::Complex::zero && y.w == dd::Complex::zero) {
+        return {dd::Package::vEdge::zero, dd::Package::vEdge::zero};
+    }
+
+    const MixKey key{x.p, x.w.r, x.w.i, y.p, y.w.r, y.w.i};
+    const auto   it = mixCache.find(key);
+    if (it != mixCache.end()) {
+        return it->second;
+    }
+
+    std::array<dd::Package::vEdge, dd::RADIX> xEdges{};
+    std::array<dd::Package::vEdge, dd::RADIX> yEdges{};
+    for (std::size_t i = 0; i < dd::RADIX; ++i) {
+        xEdges[i] = child(x, i);
+        yEdges[i] = child(y, i);
+        if (isActive(level, i)) {
+            std::tie(xEdges[i], yEdges[i]) = mix(xEdges[i], yEdges[i], static_cast<dd::Qubit>(level - 1));
+        }
+    }
+    const auto r  = std::pair{dd->makeDDNode(level, xEdges), dd->makeDDNode(level, yEdges)};
+    mixCache[key] = r;
+    return r;
+}
+
+dd::Package::vEdge GateApplicator::combine(const dd::ComplexValue& a, const dd::Package::vEdge& x, const dd::ComplexValue& b, const dd::Package::vEdge& y) {
+    const auto ax = scale(x, a);
+    const auto by = scale(y, b);
+    if (ax.w == dd::Complex::zero) {
+        return by;
+    }
+    if (by.w == dd::Complex::zero) {
+        return ax;
+    }
+    return dd->add(ax, by);
+}
+
+dd::Package::vEdge GateApplicator::scale(const dd::Package::vEdge& e, const dd::ComplexValue& c) {
+    if (e.w == dd::Complex::zero || c.approximatelyZero()) {
+        return dd::Package::vEdge::zero;
+    }
+    if (c.approximatelyOne()) {
+        return e;
+    }
+    const auto wr = dd::CTEntry::val(e.w.r);
+    const auto wi = dd::CTEntry::val(e.w.i);
+    const auto w  = dd->cn.lookup(c.r * wr - c.i * wi, c.r * wi + c.i * wr);
+    if (w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    return {e.p, w};
+}
+
+dd::Package::vEdge GateApplicator::child(const dd::Package::vEdge& e, std::size_t i) {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    return scale(e.p->e[i], toValue(e.w));
+}
+
+std::optional<dd::GateMatrix> GateApplicator::getGateMatrix(const qc::Operation& op) {
+    if (!op.isStandardOperation() || op.getTargets().size() != 1) {
+        return std::nullopt;
+    }
+    const auto& p = op.getParameter();
+    switch (op.getType()) {
+        case qc::I: return dd::Imat;
+        case qc::H: return dd::Hmat;
+        case qc::X: return dd::Xmat;
+        case qc::Y: return dd::Ymat;
+        case qc::Z: return dd::Zmat;
+        case qc::S: return dd::Smat;
+        case qc::Sdag: return dd::Sdagmat;
+        case qc::T: return dd::Tmat;
+        case qc::Tdag: return dd::Tdagmat;
+        case qc::V: return dd::Vmat;
+        case qc::Vdag: return dd::Vdagmat;
+        case qc::U3: return dd::U3mat(p[0], p[1], p[2]);
+        case qc::U2: return dd::U2mat(p[0], p[1]);
+        case qc::Phase: return dd::Phasemat(p[0]);
+        case qc::SX: return dd::SXmat;
+        case qc::SXdg: return dd::SXdagmat;
+        case qc::RX: return dd::RXmat(p[0]);
+        case qc::RY: return dd::RYmat(p[0]);
+        case qc::RZ: return dd::RZmat(p[0]);
+        default: return std::nullopt;
+    }
+}
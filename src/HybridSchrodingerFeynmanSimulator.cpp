@@ -119,11 +119,26 @@ bool HybridSchrodingerFeynmanSimulator::Slice::apply(std::unique_ptr<dd::Package
 std::map<std::string, std::size_t> HybridSchrodingerFeynmanSimulator::Simulate(unsigned int shots) {
     auto nqubits    = getNumberOfQubits();
     auto splitQubit = static_cast<dd::Qubit>(nqubits / 2);
+    if (reorder_qubits && qubit_levels.empty()) {
+        ReorderQubits(splitQubit);
+    }
     if (mode == Mode::DD) {
         SimulateHybridTaskflow(splitQubit);
         return MeasureAllNonCollapsing(shots);
     } else {
         SimulateHybridAmplitudes(splitQubit);
+        if (!qubit_levels.empty()) {
+            // the amplitudes are indexed by levels
+            std::vector<std::complex<dd::fp>> amplitudes(finalAmplitudes.size());
+            for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+                std::size_t index = 0;
+                for (std::size_t q = 0; q < qubit_levels.size(); ++q) {
+                    index |= ((i >> q) & 1U) << static_cast<std::size_t>(qubit_levels.at(q));
+                }
+                amplitudes.at(i) = finalAmplitudes.at(index);
+            }
+            finalAmplitudes = std::move(amplitudes);
+        }
 
         if (shots > 0) {
             return SampleFromAmplitudeVectorInPlace(finalAmplitudes, shots);
@@ -134,6 +149,20 @@ std::map<std::string, std::size_t> HybridSchrodingerFeynmanSimulator::Simulate(u
     }
 }
 
+void HybridSchrodingerFeynmanSimulator::ReorderQubits(dd::Qubit split_qubit) {
+    const auto levels   = QubitOrdering::compute(*qc);
+    auto       permuted = QubitOrdering::permute(*qc, levels);
+
+    // the order is only kept if it reduces the number of operations crossing the split
+    const auto ndecisions = getNDecisions(split_qubit);
+    std::swap(qc, permuted);
+    if (getNDecisions(split_qubit) < ndecisions) {
+        qubit_levels = levels;
+    } else {
+        std::swap(qc, permuted);
+    }
+}
+
 void HybridSchrodingerFeynmanSimulator::SimulateHybridTaskflow(const dd::Qubit split_qubit) {
     const auto         ndecisions          = getNDecisions(split_qubit);
     const std::int64_t max_control         = 1LL << ndecisions;
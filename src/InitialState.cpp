@@ -0,0 +1,194 @@
+#include "InitialState.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+InitialState InitialState::fromAmplitudes(std::vector<std::complex<dd::fp>> amplitudes) {
+    if (amplitudes.empty() || (amplitudes.size() & (amplitudes.size() - 1)) != 0) {
+        throw std::runtime_error("The number of amplitudes of an initial state must be a power of two.");
+    }
+    dd::fp norm = 0;
+    for (const auto& amplitude: amplitudes) {
+        norm += std::norm(amplitude);
+    }
+    if (norm <= 0) {
+        throw std::runtime_error("The initial state must not be the zero vector.");
+    }
+    for (auto& amplitude: amplitudes) {
+        amplitude /= std::sqrt(norm);
+    }
+
+    InitialState state{};
+    state.kind = Kind::Dense;
+    while ((1ULL << state.nqubits) < amplitudes.size()) {
+        state.nqubits++;
+    }
+    state.dense = std::move(amplitudes);
+    return state;
+}
+
+InitialState InitialState::fromSparseAmplitudes(const dd::QubitCount nqubits, const std::map<std::size_t, std::complex<dd::fp>>& amplitudes) {
+    dd::fp norm = 0;
+    for (const auto& [index, amplitude]: amplitudes) {
+        if (nqubits < 64 && (index >> nqubits) != 0) {
+            throw std::runtime_error("Basis index " + std::to_string(index) + " exceeds the " + std::to_string(nqubits) + " qubits of the initial state.");
+        }
+        norm += std::norm(amplitude);
+    }
+    if (norm <= 0) {
+        throw std::runtime_error("The initial state must not be the zero vector.");
+    }
+
+    InitialState state{};
+    state.kind    = Kind::Sparse;
+    state.nqubits = nqubits;
+    for (const auto& [index, amplitude]: amplitudes) {
+        if (amplitude != std::complex<dd::fp>{0, 0}) {
+            state.sparse.emplace_back(index, amplitude / std::sqrt(norm));
+        }
+    }
+    return state;
+}
+
+InitialState InitialState::fromBasisString(const std::string& basis) {
+    if (basis.empty()) {
+        throw std::runtime_error("The basis string of an initial state must not be empty.");
+    }
+    InitialState state{};
+    state.kind    = Kind::Basis;
+    state.nqubits = static_cast<dd::QubitCount>(basis.size());
+    // the string starts with qubit n-1
+    for (auto it = basis.rbegin(); it != basis.rend(); ++it) {
+        switch (*it) {
+            case '0': state.basis.push_back(dd::BasisStates::zero); break;
+            case '1': state.basis.push_back(dd::BasisStates::one); break;
+            case '+': state.basis.push_back(dd::BasisStates::plus); break;
+            case '-': state.basis.push_back(dd::BasisStates::minus); break;
+            case 'r': state.basis.push_back(dd::BasisStates::right); break;
+            case 'l': state.basis.push_back(dd::BasisStates::left); break;
+            default:
+                throw std::runtime_error(std::string("Unknown basis state '") + *it + "' (expected one of 0, 1, +, -, r, l).");
+        }
+    }
+    return state;
+}
+
+dd::Package::vEdge InitialState::toDD(std::unique_ptr<dd::Package>& dd, const dd::QubitCount n, const std::vector<dd::Qubit>& levels) const {
+    checkQubits(n);
+    switch (kind) {
+        case Kind::Zero:
+            return dd->makeZeroState(n);
+        case Kind::Basis: {
+            std::vector<dd::BasisStates> level_states(n);
+            for (std::size_t q = 0; q < basis.size(); ++q) {
+                level_states.at(levels.empty() ? q : static_cast<std::size_t>(levels.at(q))) = basis.at(q);
+            }
+            return dd->makeBasisState(n, level_states);
+        }
+        case Kind::Dense: {
+            // the leaves, which are merged pairwise level by level
+            std::vector<dd::Package::vEdge> edges(dense.size(), dd::Package::vEdge::zero);
+            for (std::size_t i = 0; i < dense.size(); ++i) {
+                edges.at(levels.empty() ? i : toLevelIndex(i, levels)) = terminal(dd, dense.at(i));
+            }
+            for (dd::Qubit level = 0; level < static_cast<dd::Qubit>(n); ++level) {
+                for (std::size_t j = 0; j < edges.size() / 2; ++j) {
+                    edges.at(j) = dd->makeDDNode(level, std::array{edges.at(2 * j), edges.at(2 * j + 1)});
+                }
+                edges.resize(edges.size() / 2);
+            }
+            return edges.front();
+        }
+        case Kind::Sparse: {
+            if (levels.empty()) {
+                return buildSparse(dd, static_cast<dd::Qubit>(n - 1), sparse.begin(), sparse.end());
+            }
+            auto permuted = sparse;
+            for (auto& entry: permuted) {
+                entry.first = toLevelIndex(entry.first, levels);
+            }
+            std::sort(permuted.begin(), permuted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            return buildSparse(dd, static_cast<dd::Qubit>(n - 1), permuted.begin(), permuted.end());
+        }
+        default:
+            throw std::runtime_error("Unknown kind of initial state.");
+    }
+}
+
+std::vector<std::complex<dd::fp>> InitialState::toVector(const dd::QubitCount n) const {
+    checkQubits(n);
+    std::vector<std::complex<dd::fp>> values(1ULL << n);
+    switch (kind) {
+        case Kind::Zero:
+            values.front() = 1;
+            break;
+        case Kind::Dense:
+            values = dense;
+            break;
+        case Kind::Sparse:
+            for (const auto& [index, amplitude]: sparse) {
+                values.at(index) = amplitude;
+            }
+            break;
+        case Kind::Basis: {
+            const auto s = static_cast<dd::fp>(dd::SQRT2_2);
+            values.front() = 1;
+            // the tensor product, starting with qubit 0
+            for (std::size_t q = 0; q < basis.size(); ++q) {
+                std::array<std::complex<dd::fp>, 2> single{};
+                switch (basis.at(q)) {
+                    case dd::BasisStates::zero: single = {1, 0}; break;
+                    case dd::BasisStates::one: single = {0, 1}; break;
+                    case dd::BasisStates::plus: single = {s, s}; break;
+                    case dd::BasisStates::minus: single = {s, -s}; break;
+                    case dd::BasisStates::right: single = {s, std::complex<dd::fp>{0, s}}; break;
+                    case dd::BasisStates::left: single = {s, std::complex<dd::fp>{0, -s}}; break;
+                }
+                const auto half = 1ULL << q;
+                for (std::size_t i = 0; i < half; ++i) {
+                    values.at(i + half) = values.at(i) * single[1];
+                    values.at(i)        = values.at(i) * single[0];
+                }
+            }
+            break;
+        }
+    }
+    return values;
+}
+
+void InitialState::checkQubits(const dd::QubitCount n) const {
+    if (kind != Kind::Zero && nqubits != n) {
+        throw std::runtime_error("The initial state has " + std::to_string(nqubits) + " qubits, but the circuit has " + std::to_string(n) + ".");
+    }
+}
+
+std::size_t InitialState::toLevelIndex(const std::size_t index, const std::vector<dd::Qubit>& levels) {
+    std::size_t level_index = 0;
+    for (std::size_t q = 0; q < levels.size(); ++q) {
+        if ((index >> q) & 1U) {
+            level_index |= 1ULL << static_cast<std::size_t>(levels.at(q));
+        }
+    }
+    return level_index;
+}
+
+dd::Package::vEdge InitialState::terminal(std::unique_ptr<dd::Package>& dd, const std::complex<dd::fp>& amplitude) {
+    if (std::abs(amplitude) < dd::ComplexTable<>::tolerance()) {
+        return dd::Package::vEdge::zero;
+    }
+    return dd::Package::vEdge::terminal(dd->cn.lookup(amplitude.real(), amplitude.imag()));
+}
+
+dd::Package::vEdge InitialState::buildSparse(std::unique_ptr<dd::Package>& dd, const dd::Qubit level, const SparseAmplitudes::const_iterator first, const SparseAmplitudes::const_iterator last) {
+    if (first == last) {
+        return dd::Package::vEdge::zero;
+    }
+    if (level < 0) {
+        return terminal(dd, first->second);
+    }
+    // all entries of the range agree on the higher bits, hence those with a 0 at this level come first
+    const auto mid = std::partition_point(first, last, [&](const auto& entry) { return ((entry.first >> static_cast<std::size_t>(level)) & 1U) == 0; });
+    return dd->makeDDNode(level, std::array{buildSparse(dd, static_cast<dd::Qubit>(level - 1), first, mid), buildSparse(dd, static_cast<dd::Qubit>(level - 1), mid, last)});
+}
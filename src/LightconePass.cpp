@@ -0,0 +1,85 @@
+#include "LightconePass.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+std::vector<bool> LightconePass::analyze(const qc::QuantumComputation& qc) {
+    const std::size_t nops = qc.getNops();
+    std::vector<bool> keep(nops, true);
+
+    const bool has_measurements = std::any_of(qc.begin(), qc.end(), [](const auto& op) { return op->getType() == qc::Measure; });
+    if (!has_measurements) {
+        return keep;
+    }
+
+    std::set<dd::Qubit> cone{};
+    for (std::size_t i = nops; i-- > 0;) {
+        const auto& op = *qc.at(i);
+
+        if (op.getType() == qc::Measure) {
+            cone.insert(op.getTargets().begin(), op.getTargets().end());
+            continue;
+        }
+        if (op.getType() == qc::Reset) {
+            // the state of a reset qubit does not depend on anything that happened to it before
+            bool in_cone = false;
+            for (const auto target: op.getTargets()) {
+                in_cone |= cone.erase(target) > 0;
+            }
+            keep[i] = in_cone;
+            continue;
+        }
+        if (op.isNonUnitaryOperation()) {
+            // barriers, snapshots, etc. do not change the state
+            continue;
+        }
+
+        std::set<dd::Qubit> qubits{};
+        collectQubits(op, qubits);
+        const bool in_cone = std::any_of(qubits.begin(), qubits.end(), [&cone](const auto qubit) { return cone.count(qubit) > 0; });
+        if (in_cone) {
+            cone.insert(qubits.begin(), qubits.end());
+        } else {
+            keep[i] = false;
+        }
+    }
+    return keep;
+}
+
+std::size_t LightconePass::apply(qc::QuantumComputation& qc) {
+    const auto  keep    = analyze(qc);
+    std::size_t removed = 0;
+    // erase from the back so that the remaining indices stay valid
+    for (std::size_t i = keep.size(); i-- > 0;) {
+        if (!keep[i]) {
+            qc.erase(qc.begin() + static_cast<std::ptrdiff_t>(i));
+            removed++;
+        }
+    }
+    return removed;
+}
+
+void LightconePass::collectQubits(const qc::Operation& op, std::set<dd::Qubit>& qubits) {
+    if (op.isCompoundOperation()) {
+        const auto* comp_op = dynamic_cast<const qc::CompoundOperation*>(&op);
+        if (comp_op == nullptr) {
+            throw std::runtime_error("Dynamic cast to CompoundOperation failed.");
+        }
+        for (const auto& sub_op: *comp_op) {
+            collectQubits(*sub_op, qubits);
+        }
+        return;
+    }
+    if (op.isClassicControlledOperation()) {
+        const auto* cc_op = dynamic_cast<const qc::ClassicControlledOperation*>(&op);
+        if (cc_op == nullptr) {
+            throw std::runtime_error("Dynamic cast to ClassicControlledOperation failed.");
+        }
+        collectQubits(*cc_op->getOperation(), qubits);
+        return;
+    }
+    qubits.insert(op.getTargets().begin(), op.getTargets().end());
+    for (const auto& control: op.getControls()) {
+        qubits.insert(control.qubit);
+    }
+}
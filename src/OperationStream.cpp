@@ -0,0 +1,156 @@
+#include "OperationStream.hpp"
+
+#include "QuantumComputation.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+std::unique_ptr<OperationStream> OperationStream::fromGenerator(const dd::QubitCount nqubits, const std::size_t ncbits, std::function<std::unique_ptr<qc::Operation>()> generator) {
+    return std::make_unique<GeneratorStream>(nqubits, ncbits, std::move(generator));
+}
+
+std::unique_ptr<OperationStream> OperationStream::fromQasm(const std::string& filename) {
+    auto is = std::make_unique<std::ifstream>(filename);
+    if (!is->good()) {
+        throw std::runtime_error("Could not open circuit file " + filename + ".");
+    }
+    return fromQasm(std::move(is), filename);
+}
+
+std::unique_ptr<OperationStream> OperationStream::fromQasm(std::unique_ptr<std::istream>&& is, const std::string& name) {
+    return std::make_unique<QasmStream>(std::move(is), name);
+}
+
+OperationStream::Chunk GeneratorStream::nextChunk(const std::size_t max_ops) {
+    Chunk chunk{};
+    while (!exhausted && chunk.size() < max_ops) {
+        auto op = generator();
+        if (op == nullptr) {
+            exhausted = true;
+        } else {
+            chunk.push_back(std::move(op));
+        }
+    }
+    return chunk;
+}
+
+QasmStream::QasmStream(std::unique_ptr<std::istream>&& is_, const std::string& name):
+    OperationStream(0, 0, name), is(std::move(is_)) {
+    std::string statement{};
+    while (readStatement(statement)) {
+        if (!isDeclaration(statement)) {
+            pending = statement;
+            break;
+        }
+        declarations += statement + "\n";
+    }
+
+    qc::QuantumComputation header{};
+    header.import(std::istringstream(declarations), qc::OpenQASM);
+    nqubits = header.getNqubits();
+    ncbits  = header.getNcbits();
+}
+
+OperationStream::Chunk QasmStream::nextChunk(const std::size_t max_ops) {
+    std::string statements{};
+    std::size_t nstatements = 0;
+    std::string statement{};
+    if (!pending.empty()) {
+        statements += pending + "\n";
+        nstatements++;
+        pending.clear();
+    }
+    while (nstatements < max_ops && readStatement(statement)) {
+        if (isRegisterDeclaration(statement)) {
+            throw std::runtime_error("Streamed circuits must declare all registers before the first operation.");
+        }
+        if (isDeclaration(statement)) {
+            // gate definitions are needed by all following chunks
+            declarations += statement + "\n";
+            continue;
+        }
+        statements += statement + "\n";
+        nstatements++;
+    }
+
+    Chunk chunk{};
+    if (nstatements == 0) {
+        return chunk;
+    }
+    qc::QuantumComputation part{};
+    part.import(std::istringstream(declarations + statements), qc::OpenQASM);
+    if (part.getNqubits() != nqubits) {
+        throw std::runtime_error("A chunk of the streamed circuit does not match its declarations.");
+    }
+    chunk.reserve(part.getNops());
+    for (auto& op: part) {
+        chunk.push_back(std::move(op));
+    }
+    return chunk;
+}
+
+bool QasmStream::readStatement(std::string& statement) {
+    statement.clear();
+    std::size_t depth = 0;
+    char        c     = 0;
+    while (is->get(c)) {
+        if (c == '/' && is->peek() == '/') {
+            std::string comment{};
+            std::getline(*is, comment);
+            if (isLayoutComment(comment)) {
+                throw std::runtime_error("Streamed circuits do not support layout comments ('// i' and '// o').");
+            }
+            continue;
+        }
+        if (statement.empty() && std::isspace(static_cast<unsigned char>(c)) != 0) {
+            continue;
+        }
+        statement += c;
+        if (c == '{') {
+            depth++;
+        } else if (c == '}' && depth > 0) {
+            // the closing brace of a gate definition terminates the statement
+            if (--depth == 0) {
+                return true;
+            }
+        } else if (c == ';' && depth == 0) {
+            return true;
+        }
+    }
+    if (!statement.empty()) {
+        throw std::runtime_error("The streamed circuit ends with an incomplete statement '" + statement + "'.");
+    }
+    return false;
+}
+
+bool QasmStream::isLayoutComment(const std::string& comment) {
+    // the comment still starts with the second slash
+    std::size_t start = 1;
+    while (start < comment.size() && std::isspace(static_cast<unsigned char>(comment[start])) != 0) {
+        start++;
+    }
+    if (start >= comment.size() || (comment[start] != 'i' && comment[start] != 'o')) {
+        return false;
+    }
+    return start + 1 == comment.size() || std::isspace(static_cast<unsigned char>(comment[start + 1])) != 0;
+}
+
+bool QasmStream::isDeclaration(const std::string& statement) {
+    const auto k = keyword(statement);
+    return k == "OPENQASM" || k == "include" || k == "gate" || k == "opaque" || isRegisterDeclaration(statement);
+}
+
+bool QasmStream::isRegisterDeclaration(const std::string& statement) {
+    const auto k = keyword(statement);
+    return k == "qreg" || k == "creg";
+}
+
+std::string QasmStream::keyword(const std::string& statement) {
+    std::size_t end = 0;
+    while (end < statement.size() && (std::isalnum(static_cast<unsigned char>(statement[end])) != 0 || statement[end] == '_')) {
+        end++;
+    }
+    return statement.substr(0, end);
+}
@@ -107,6 +107,10 @@ std::map<std::string, std::size_t> PathSimulator::Simulate(unsigned int shots) {
     executor.run(taskflow).wait();
 
     // measure resulting DD
+    if (!measurement_map.empty()) {
+        // the unmeasured qubits are in an unspecified state after pruning the circuit to its lightcone
+        return toClassicalCounts(MeasureAllNonCollapsing(shots), measurement_map, qc->getNqubits(), qc->getNcbits());
+    }
     return MeasureAllNonCollapsing(shots);
 }
 
@@ -385,7 +389,7 @@ void PathSimulator::addSimulationTask(std::size_t leftID, std::size_t rightID, s
             dd->decRef(rightMatrix);
             results.emplace(resultID, resultDD);
         }
-        dd->garbageCollect();
+        gc_policy.afterOperation(dd);
         results.erase(leftID);
         results.erase(rightID);
     };
@@ -0,0 +1,161 @@
+#include "PauliExpectation.hpp"
+
+#include "taskflow/taskflow.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+PauliExpectation::PauliExpectation(const dd::QubitCount nqubits, const std::vector<PauliTerm>& pauli_terms, const std::vector<dd::Qubit>& levels):
+    nqubits(nqubits) {
+    std::map<std::pair<std::size_t, char>, std::size_t> suffix_ids{};
+    terms.reserve(pauli_terms.size());
+    for (const auto& [coefficient, pauli]: pauli_terms) {
+        if (pauli.size() != nqubits) {
+            throw std::runtime_error("The Pauli string '" + pauli + "' does not have one operator per qubit.");
+        }
+        Term term{coefficient, std::vector<char>(nqubits, 'I'), std::vector<std::size_t>(nqubits, 0)};
+        for (std::size_t q = 0; q < nqubits; ++q) {
+            const auto op = pauli.at(nqubits - 1 - q);
+            if (op != 'I' && op != 'X' && op != 'Y' && op != 'Z') {
+                throw std::runtime_error("Unknown Pauli operator '" + std::string(1, op) + "'.");
+            }
+            term.operators.at(levels.empty() ? q : static_cast<std::size_t>(levels.at(q))) = op;
+        }
+        // identifier 0 is the empty string below level 0
+        std::size_t suffix = 0;
+        for (std::size_t l = 0; l < nqubits; ++l) {
+            suffix                = suffix_ids.try_emplace({suffix, term.operators.at(l)}, suffix_ids.size() + 1).first->second;
+            term.suffixes.at(l) = suffix;
+        }
+        terms.push_back(std::move(term));
+    }
+    // terms with common suffixes end up next to each other and, hence, in the same cache
+    std::sort(terms.begin(), terms.end(), [](const Term& a, const Term& b) { return a.operators < b.operators; });
+}
+
+dd::fp PauliExpectation::compute(const dd::Package::vEdge& state, const std::size_t nthreads) const {
+    if (state.w.approximatelyZero()) {
+        return 0.;
+    }
+    if (state.isTerminal() ? nqubits != 0 : static_cast<std::size_t>(state.p->v) + 1 != nqubits) {
+        throw std::runtime_error("The observable does not match the number of qubits of the state.");
+    }
+    const auto norm = std::norm(toComplex(state.w));
+
+    const auto evaluate = [&](const std::size_t first, const std::size_t last) {
+        Cache  cache{};
+        dd::fp sum = 0.;
+        for (auto i = first; i < last; ++i) {
+            const auto& term = terms.at(i);
+            sum += term.coefficient * norm * innerProduct(term, state.p, state.p, static_cast<dd::Qubit>(nqubits - 1), cache).real();
+        }
+        return sum;
+    };
+
+    const auto chunks = std::min(std::max<std::size_t>(nthreads, 1), terms.size());
+    if (chunks <= 1) {
+        return evaluate(0, terms.size());
+    }
+    std::vector<dd::fp> sums(chunks, 0.);
+    tf::Executor        executor(chunks);
+    tf::Taskflow        taskflow;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        taskflow.emplace([&, chunk]() { sums.at(chunk) = evaluate(chunk * terms.size() / chunks, (chunk + 1) * terms.size() / chunks); });
+    }
+    executor.run(taskflow).wait();
+    return std::accumulate(sums.begin(), sums.end(), 0.);
+}
+
+dd::fp PauliExpectation::compute(const DenseState::Amplitudes& amplitudes, const std::size_t nthreads) const {
+    if (amplitudes.size() != (1ULL << nqubits)) {
+        throw std::runtime_error("The observable does not match the number of qubits of the state.");
+    }
+
+    const auto evaluate = [&](const Term& term, const std::size_t first, const std::size_t last) {
+        // P|j> = i^(#Y) (-1)^|j & zmask| |j ^ xmask>
+        std::size_t xmask = 0;
+        std::size_t zmask = 0;
+        std::size_t ny    = 0;
+        for (std::size_t l = 0; l < nqubits; ++l) {
+            const auto op = term.operators.at(l);
+            if (op == 'X' || op == 'Y') {
+                xmask |= 1ULL << l;
+            }
+            if (op == 'Z' || op == 'Y') {
+                zmask |= 1ULL << l;
+            }
+            ny += op == 'Y' ? 1 : 0;
+        }
+        std::complex<dd::fp> sum = 0.;
+        for (auto j = first; j < last; ++j) {
+            const auto product = std::conj(amplitudes[j ^ xmask]) * amplitudes[j];
+            sum += (__builtin_popcountll(j & zmask) % 2 == 0) ? product : -product;
+        }
+        static constexpr std::array<std::complex<dd::fp>, 4> PHASES{std::complex<dd::fp>{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+        return term.coefficient * (PHASES.at(ny % 4) * sum).real();
+    };
+
+    const auto chunks = amplitudes.size() < DenseState::PARALLEL_THRESHOLD ? 1 : std::max<std::size_t>(nthreads, 1);
+    if (chunks <= 1) {
+        dd::fp sum = 0.;
+        for (const auto& term: terms) {
+            sum += evaluate(term, 0, amplitudes.size());
+        }
+        return sum;
+    }
+    std::vector<dd::fp> sums(chunks, 0.);
+    tf::Executor        executor(chunks);
+    tf::Taskflow        taskflow;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        taskflow.emplace([&, chunk]() {
+            for (const auto& term: terms) {
+                sums.at(chunk) += evaluate(term, chunk * amplitudes.size() / chunks, (chunk + 1) * amplitudes.size() / chunks);
+            }
+        });
+    }
+    executor.run(taskflow).wait();
+    return std::accumulate(sums.begin(), sums.end(), 0.);
+}
+
+std::complex<dd::fp> PauliExpectation::innerProduct(const Term& term, dd::Package::vNode* u, dd::Package::vNode* v, const dd::Qubit level, Cache& cache) {
+    if (level < 0) {
+        return 1.;
+    }
+    const auto key = std::tuple{u, v, term.suffixes.at(static_cast<std::size_t>(level))};
+    if (const auto it = cache.find(key); it != cache.end()) {
+        return it->second;
+    }
+
+    // <u_a| c P' |v_b> for the branches a of u, which are paired with the branches b of v by the operator at this level
+    const auto op = term.operators.at(static_cast<std::size_t>(level));
+    std::array<std::tuple<std::size_t, std::size_t, std::complex<dd::fp>>, 2> pairs{};
+    switch (op) {
+        case 'X':
+            pairs = {std::tuple{0, 1, std::complex<dd::fp>{1., 0.}}, std::tuple{1, 0, std::complex<dd::fp>{1., 0.}}};
+            break;
+        case 'Y':
+            pairs = {std::tuple{0, 1, std::complex<dd::fp>{0., -1.}}, std::tuple{1, 0, std::complex<dd::fp>{0., 1.}}};
+            break;
+        case 'Z':
+            pairs = {std::tuple{0, 0, std::complex<dd::fp>{1., 0.}}, std::tuple{1, 1, std::complex<dd::fp>{-1., 0.}}};
+            break;
+        default:
+            pairs = {std::tuple{0, 0, std::complex<dd::fp>{1., 0.}}, std::tuple{1, 1, std::complex<dd::fp>{1., 0.}}};
+            break;
+    }
+
+    std::complex<dd::fp> result = 0.;
+    for (const auto& [a, b, c]: pairs) {
+        const auto& x = u->e.at(a);
+        const auto& y = v->e.at(b);
+        if (x.w.approximatelyZero() || y.w.approximatelyZero()) {
+            continue;
+        }
+        result += c * std::conj(toComplex(x.w)) * toComplex(y.w) * innerProduct(term, x.p, y.p, static_cast<dd::Qubit>(level - 1), cache);
+    }
+    cache.emplace(key, result);
+    return result;
+}
@@ -0,0 +1,213 @@
+#include "PermutationEmulator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+std::optional<dd::Package::vEdge> PermutationEmulator::apply(const std::vector<dd::Qubit>& qubits, const std::function<unsigned long long(unsigned long long)>& f, const dd::Package::vEdge& e) {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    if (e.isTerminal() || qubits.empty() || qubits.size() > MAX_REGISTER_QUBITS) {
+        throw std::runtime_error("Permutations act on between 1 and " + std::to_string(MAX_REGISTER_QUBITS) + " qubits of the state.");
+    }
+
+    bit_of_level.assign(static_cast<std::size_t>(e.p->v) + 1, -1);
+    for (std::size_t b = 0; b < qubits.size(); ++b) {
+        const auto q = qubits.at(b);
+        if (q < 0 || q > e.p->v || bit_of_level.at(static_cast<std::size_t>(q)) != -1) {
+            throw std::runtime_error("The qubits of a permutation must be distinct qubits of the state.");
+        }
+        bit_of_level.at(static_cast<std::size_t>(q)) = static_cast<int>(b);
+    }
+
+    // the caches refer to nodes of the current state only, which may be collected afterwards
+    slice_cache.clear();
+    created_slices = 0;
+
+    const auto& top = slices(e.p);
+    if (created_slices > max_slices) {
+        slice_cache.clear();
+        return std::nullopt;
+    }
+
+    std::vector<dd::Package::vEdge>        images{};
+    std::unordered_set<unsigned long long> occupied{};
+    for (const auto& [x, slice]: top) {
+        const auto y = f(x);
+        if ((qubits.size() < MAX_REGISTER_QUBITS && (y >> qubits.size()) != 0) || !occupied.insert(y).second) {
+            throw std::runtime_error("The function is not a permutation of the basis states of the register.");
+        }
+        if (y == x) {
+            images.push_back(slice);
+        } else {
+            relabel_cache.clear();
+            images.push_back(relabel(slice, y));
+        }
+    }
+    slice_cache.clear();
+    relabel_cache.clear();
+
+    // the images have disjoint supports, hence they are added up exactly (pairwise, so that the operands stay balanced)
+    while (images.size() > 1) {
+        std::vector<dd::Package::vEdge> sums{};
+        sums.reserve((images.size() + 1) / 2);
+        for (std::size_t i = 0; i + 1 < images.size(); i += 2) {
+            sums.push_back(dd->add(images.at(i), images.at(i + 1)));
+        }
+        if (images.size() % 2 == 1) {
+            sums.push_back(images.back());
+        }
+        images = std::move(sums);
+    }
+    return scale(images.front(), e.w);
+}
+
+std::optional<dd::Package::vEdge> PermutationEmulator::apply(const Netlist& netlist, const dd::Package::vEdge& e) {
+    const auto qubits = registerOf(netlist);
+    if (qubits.empty()) {
+        return e;
+    }
+
+    // the gates as bit operations on the register values
+    std::vector<unsigned long long> bit(static_cast<std::size_t>(qubits.back()) + 1, 0);
+    for (std::size_t b = 0; b < qubits.size(); ++b) {
+        bit.at(static_cast<std::size_t>(qubits.at(b))) = 1ULL << b;
+    }
+    struct BitGate {
+        unsigned long long control_mask;
+        unsigned long long control_value;
+        unsigned long long first;
+        unsigned long long second;
+    };
+    std::vector<BitGate> gates{};
+    gates.reserve(netlist.size());
+    for (const auto& gate: netlist) {
+        BitGate bit_gate{0, 0, bit.at(static_cast<std::size_t>(gate.targets.front())), gate.targets.size() == 2 ? bit.at(static_cast<std::size_t>(gate.targets.back())) : 0};
+        for (const auto& control: gate.controls) {
+            bit_gate.control_mask |= bit.at(static_cast<std::size_t>(control.qubit));
+            if (control.type == dd::Control::Type::pos) {
+                bit_gate.control_value |= bit.at(static_cast<std::size_t>(control.qubit));
+            }
+        }
+        gates.push_back(bit_gate);
+    }
+
+    const auto f = [&](unsigned long long x) {
+        for (const auto& gate: gates) {
+            if ((x & gate.control_mask) != gate.control_value) {
+                continue;
+            }
+            if (gate.second == 0) {
+                x ^= gate.first;
+            } else if (((x & gate.first) == 0) != ((x & gate.second) == 0)) {
+                x ^= gate.first | gate.second;
+            }
+        }
+        return x;
+    };
+    return apply(qubits, f, e);
+}
+
+bool PermutationEmulator::isReversibleGate(const qc::Operation& op) {
+    return op.isStandardOperation() && ((op.getType() == qc::X && op.getTargets().size() == 1) || (op.getType() == qc::SWAP && op.getTargets().size() == 2));
+}
+
+PermutationEmulator::ReversibleGate PermutationEmulator::toReversibleGate(const qc::Operation& op) {
+    if (!isReversibleGate(op)) {
+        throw std::runtime_error(std::string("'") + op.getName() + "' is not a classical reversible gate.");
+    }
+    return {op.getControls(), op.getTargets()};
+}
+
+std::vector<dd::Qubit> PermutationEmulator::registerOf(const Netlist& netlist) {
+    std::set<dd::Qubit> qubits{};
+    for (const auto& gate: netlist) {
+        qubits.insert(gate.targets.begin(), gate.targets.end());
+        for (const auto& control: gate.controls) {
+            qubits.insert(control.qubit);
+        }
+    }
+    return {qubits.begin(), qubits.end()};
+}
+
+const PermutationEmulator::Slices& PermutationEmulator::slices(dd::Package::vNode* p) {
+    if (created_slices > max_slices) {
+        return no_slices;
+    }
+    const auto it = slice_cache.find(p);
+    if (it != slice_cache.end()) {
+        return it->second;
+    }
+
+    const dd::Qubit level = p->v;
+    const auto      bit   = bit_of_level.at(static_cast<std::size_t>(level));
+
+    // edges of the slice for each register value (below and including this level)
+    std::map<unsigned long long, std::array<dd::Package::vEdge, dd::RADIX>> edges{};
+    for (std::size_t i = 0; i < dd::RADIX; ++i) {
+        const auto& c = p->e[i];
+        if (c.w == dd::Complex::zero) {
+            continue;
+        }
+        for (const auto& [x, slice]: c.isTerminal() ? terminal_slices : slices(c.p)) {
+            const auto value = bit < 0 ? x : x | (static_cast<unsigned long long>(i) << static_cast<unsigned>(bit));
+            auto&      entry = edges.try_emplace(value, std::array{dd::Package::vEdge::zero, dd::Package::vEdge::zero}).first->second;
+            entry.at(i)      = scale(slice, c.w);
+        }
+    }
+
+    created_slices += edges.size();
+    if (created_slices > max_slices) {
+        return no_slices;
+    }
+    Slices result{};
+    for (const auto& [x, slice_edges]: edges) {
+        result.emplace_hint(result.end(), x, dd->makeDDNode(level, slice_edges));
+    }
+    return slice_cache.emplace(p, std::move(result)).first->second;
+}
+
+dd::Package::vEdge PermutationEmulator::relabel(const dd::Package::vEdge& e, const unsigned long long y) {
+    if (e.w == dd::Complex::zero || e.isTerminal()) {
+        return e;
+    }
+
+    auto it = relabel_cache.find(e.p);
+    if (it == relabel_cache.end()) {
+        const dd::Qubit level = e.p->v;
+        const auto      bit   = bit_of_level.at(static_cast<std::size_t>(level));
+
+        // the levels of the register only keep a single branch, which is moved to the bit of y
+        std::array<dd::Package::vEdge, dd::RADIX> edges{dd::Package::vEdge::zero, dd::Package::vEdge::zero};
+        for (std::size_t i = 0; i < dd::RADIX; ++i) {
+            const auto& c = e.p->e[i];
+            if (c.w == dd::Complex::zero) {
+                continue;
+            }
+            edges.at(bit < 0 ? i : static_cast<std::size_t>((y >> static_cast<unsigned>(bit)) & 1U)) = relabel(c, y);
+        }
+        it = relabel_cache.emplace(e.p, dd->makeDDNode(level, edges)).first;
+    }
+    return scale(it->second, e.w);
+}
+
+dd::Package::vEdge PermutationEmulator::scale(const dd::Package::vEdge& e, const dd::Complex& c) {
+    const dd::ComplexValue value{dd::CTEntry::val(c.r), dd::CTEntry::val(c.i)};
+    if (e.w == dd::Complex::zero || value.approximatelyZero()) {
+        return dd::Package::vEdge::zero;
+    }
+    if (value.approximatelyOne()) {
+        return e;
+    }
+    const auto wr = dd::CTEntry::val(e.w.r);
+    const auto wi = dd::CTEntry::val(e.w.i);
+    const auto w  = dd->cn.lookup(value.r * wr - value.i * wi, value.r * wi + value.i * wr);
+    if (w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    return {e.p, w};
+}
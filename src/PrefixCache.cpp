@@ -0,0 +1,118 @@
+#include "PrefixCache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+std::vector<std::size_t> PrefixCache::prefixHashes(const ExecutionPlan& plan, dd::QubitCount nqubits) {
+    std::vector<std::size_t> hashes;
+    std::size_t              hash = std::hash<std::size_t>{}(nqubits);
+    for (const auto& instruction: plan) {
+        // the state after measurements, resets and classically-controlled operations is not determined by the prefix
+        if (instruction.kind != ExecutionPlan::Kind::Gate || instruction.isConditional() || instruction.op->isCompoundOperation()) {
+            break;
+        }
+        const auto& op = *instruction.op;
+        hashCombine(hash, static_cast<std::size_t>(op.getType()));
+        for (const auto target: op.getTargets()) {
+            hashCombine(hash, static_cast<std::size_t>(target));
+        }
+        hashCombine(hash, op.getTargets().size());
+        for (const auto& control: op.getControls()) {
+            hashCombine(hash, static_cast<std::size_t>(control.qubit));
+            hashCombine(hash, control.type == dd::Control::Type::pos ? 1U : 0U);
+        }
+        hashCombine(hash, op.getControls().size());
+        for (const auto parameter: op.getParameter()) {
+            hashCombine(hash, std::hash<dd::fp>{}(parameter));
+        }
+        hashes.push_back(hash);
+    }
+    return hashes;
+}
+
+std::optional<std::pair<std::size_t, dd::Package::vEdge>> PrefixCache::lookup(const std::vector<std::size_t>& hashes, const ExecutionPlan& plan) {
+    for (std::size_t depth = hashes.size(); depth > 0; --depth) {
+        const auto it = entries.find(hashes.at(depth - 1));
+        if (it != entries.end() && it->second.gates.size() == depth && matches(it->second.gates, plan)) {
+            it->second.last_use = ++use_counter;
+            hits++;
+            reused_ops += depth;
+            return std::pair{depth, it->second.state};
+        }
+    }
+    misses++;
+    return std::nullopt;
+}
+
+bool PrefixCache::isCheckpoint(std::size_t depth, std::size_t prefix_length) const {
+    if (depth == 0 || depth > prefix_length) {
+        return false;
+    }
+    if (depth == prefix_length) {
+        return true;
+    }
+    // automatically place about eight checkpoints along the prefix
+    const auto interval = checkpoint_interval > 0 ? checkpoint_interval : std::max<std::size_t>(1, prefix_length / 8);
+    return depth % interval == 0;
+}
+
+void PrefixCache::insert(std::size_t hash, const ExecutionPlan& plan, std::size_t depth, const dd::Package::vEdge& state) {
+    if (entries.count(hash) > 0) {
+        return;
+    }
+    const std::size_t nodes = dd->size(state);
+    if (nodes > max_nodes) {
+        return;
+    }
+    std::vector<Gate> gates{};
+    gates.reserve(depth);
+    for (std::size_t i = 0; i < depth; ++i) {
+        gates.emplace_back(describe(*plan.at(i).op));
+    }
+    dd->incRef(state);
+    entries.emplace(hash, Entry{std::move(gates), state, nodes, ++use_counter});
+    total_nodes += nodes;
+    evict();
+}
+
+void PrefixCache::evict() {
+    while (total_nodes > max_nodes && !entries.empty()) {
+        auto lru = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.last_use < lru->second.last_use) {
+                lru = it;
+            }
+        }
+        dd->decRef(lru->second.state);
+        total_nodes -= lru->second.nodes;
+        entries.erase(lru);
+    }
+}
+
+void PrefixCache::clear() {
+    for (const auto& [hash, entry]: entries) {
+        dd->decRef(entry.state);
+    }
+    entries.clear();
+    total_nodes = 0;
+}
+
+PrefixCache::Gate PrefixCache::describe(const qc::Operation& op) {
+    const auto& parameters = op.getParameter();
+    return {op.getType(), op.getTargets(), op.getControls(), {parameters.begin(), parameters.end()}};
+}
+
+bool PrefixCache::matches(const std::vector<Gate>& gates, const ExecutionPlan& plan) {
+    if (gates.size() > plan.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < gates.size(); ++i) {
+        const auto& gate = gates.at(i);
+        const auto& op   = *plan.at(i).op;
+        if (gate.type != op.getType() || gate.targets != op.getTargets() || gate.controls != op.getControls() ||
+            !std::equal(gate.parameters.begin(), gate.parameters.end(), op.getParameter().begin(), op.getParameter().end())) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+#include "QubitOrdering.hpp"
+
+#include "LightconePass.hpp"
+#include "RegisterCompaction.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <set>
+
+std::vector<dd::Qubit> QubitOrdering::compute(const qc::QuantumComputation& qc) {
+    const std::size_t      nqubits = qc.getNqubits();
+    std::vector<dd::Qubit> identity(nqubits);
+    std::iota(identity.begin(), identity.end(), 0);
+
+    const auto weights = interactionWeights(qc);
+    auto       order   = greedyOrder(weights);
+    improveOrder(weights, order);
+
+    std::vector<dd::Qubit> levels(nqubits);
+    for (std::size_t i = 0; i < nqubits; ++i) {
+        levels.at(order.at(i)) = static_cast<dd::Qubit>(i);
+    }
+    if (arrangementCost(weights, levels) < arrangementCost(weights, identity)) {
+        return levels;
+    }
+    return identity;
+}
+
+std::unique_ptr<qc::QuantumComputation> QubitOrdering::permute(const qc::QuantumComputation& qc, const std::vector<dd::Qubit>& levels) {
+    auto permuted = std::make_unique<qc::QuantumComputation>();
+    permuted->addQubitRegister(qc.getNqubits());
+    if (qc.getNcbits() > 0) {
+        permuted->addClassicalRegister(qc.getNcbits());
+    }
+    for (const auto& op: qc) {
+        auto cloned = op->clone();
+        RegisterCompaction::remap(*cloned, levels, qc.getNqubits());
+        permuted->emplace_back(cloned);
+    }
+    return permuted;
+}
+
+QubitOrdering::Weights QubitOrdering::interactionWeights(const qc::QuantumComputation& qc) {
+    const std::size_t nqubits = qc.getNqubits();
+    Weights           weights(nqubits, std::vector<std::size_t>(nqubits, 0));
+    for (const auto& op: qc) {
+        if (!op->isUnitary() && !op->isClassicControlledOperation()) {
+            continue;
+        }
+        std::set<dd::Qubit> qubits{};
+        LightconePass::collectQubits(*op, qubits);
+        for (const auto a: qubits) {
+            for (const auto b: qubits) {
+                if (a != b) {
+                    weights.at(static_cast<std::size_t>(a)).at(static_cast<std::size_t>(b))++;
+                }
+            }
+        }
+    }
+    return weights;
+}
+
+std::size_t QubitOrdering::arrangementCost(const Weights& weights, const std::vector<dd::Qubit>& levels) {
+    std::size_t cost = 0;
+    for (std::size_t a = 0; a < weights.size(); ++a) {
+        for (std::size_t b = a + 1; b < weights.size(); ++b) {
+            const auto distance = std::abs(levels.at(a) - levels.at(b));
+            cost += weights.at(a).at(b) * static_cast<std::size_t>(distance);
+        }
+    }
+    return cost;
+}
+
+std::vector<std::size_t> QubitOrdering::greedyOrder(const Weights& weights) {
+    const std::size_t        nqubits = weights.size();
+    std::vector<std::size_t> degree(nqubits, 0);
+    for (std::size_t q = 0; q < nqubits; ++q) {
+        degree.at(q) = std::accumulate(weights.at(q).begin(), weights.at(q).end(), std::size_t{0});
+    }
+
+    std::vector<std::size_t> order{};
+    std::vector<bool>        placed(nqubits, false);
+    while (order.size() < nqubits) {
+        // prefer qubits interacting with recently placed ones, otherwise start a new group with the busiest qubit
+        std::size_t best       = nqubits;
+        std::size_t best_score = 0;
+        for (std::size_t q = 0; q < nqubits; ++q) {
+            if (placed.at(q)) {
+                continue;
+            }
+            std::size_t score = 0;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                score += weights.at(q).at(order.at(i)) * (i + 1);
+            }
+            if (best == nqubits || score > best_score || (score == best_score && score == 0 && degree.at(q) > degree.at(best))) {
+                best       = q;
+                best_score = score;
+            }
+        }
+        placed.at(best) = true;
+        order.push_back(best);
+    }
+    return order;
+}
+
+void QubitOrdering::improveOrder(const Weights& weights, std::vector<std::size_t>& order) {
+    const std::size_t nqubits = order.size();
+    bool              improved = true;
+    for (std::size_t pass = 0; improved && pass < nqubits; ++pass) {
+        improved = false;
+        for (std::size_t i = 0; i + 1 < nqubits; ++i) {
+            const auto a = order.at(i);
+            const auto b = order.at(i + 1);
+            // a moves up by one position and b moves down by one position
+            long long delta = 0;
+            for (std::size_t p = 0; p < nqubits; ++p) {
+                if (p == i || p == i + 1) {
+                    continue;
+                }
+                const auto c    = order.at(p);
+                const auto wa   = static_cast<long long>(weights.at(a).at(c));
+                const auto wb   = static_cast<long long>(weights.at(b).at(c));
+                const auto sign = p > i + 1 ? -1LL : 1LL;
+                delta += sign * (wa - wb);
+            }
+            if (delta < 0) {
+                std::swap(order.at(i), order.at(i + 1));
+                improved = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include "RegisterCompaction.hpp"
+
+#include "LightconePass.hpp"
+
+#include <array>
+#include <set>
+#include <stdexcept>
+
+RegisterCompaction::RegisterCompaction(const qc::QuantumComputation& qc):
+    nqubits(qc.getNqubits()), position(qc.getNqubits(), -1) {
+    std::set<dd::Qubit> used{};
+    for (const auto& op: qc) {
+        if (op->getType() == qc::Barrier || op->getType() == qc::Reset) {
+            continue;
+        }
+        LightconePass::collectQubits(*op, used);
+    }
+    // keep at least one qubit so that the compacted register is not empty
+    if (used.empty() && nqubits > 0) {
+        used.insert(0);
+    }
+    for (const auto qubit: used) {
+        position.at(static_cast<std::size_t>(qubit)) = static_cast<dd::Qubit>(active.size());
+        active.push_back(qubit);
+    }
+}
+
+std::unique_ptr<qc::QuantumComputation> RegisterCompaction::compact(const qc::QuantumComputation& qc) const {
+    auto compacted = std::make_unique<qc::QuantumComputation>();
+    compacted->addQubitRegister(active.size());
+    if (qc.getNcbits() > 0) {
+        compacted->addClassicalRegister(qc.getNcbits());
+    }
+
+    for (const auto& op: qc) {
+        if (op->getType() == qc::Barrier || op->getType() == qc::Reset) {
+            // barriers and resets of idle qubits are dropped
+            std::vector<dd::Qubit> targets{};
+            for (const auto target: op->getTargets()) {
+                if (position.at(static_cast<std::size_t>(target)) >= 0) {
+                    targets.push_back(target);
+                }
+            }
+            if (targets.empty()) {
+                continue;
+            }
+            compacted->emplace_back<qc::NonUnitaryOperation>(nqubits, targets, op->getType());
+        } else {
+            auto cloned = op->clone();
+            compacted->emplace_back(cloned);
+        }
+        remap(*compacted->back(), position, getNactive());
+    }
+    return compacted;
+}
+
+void RegisterCompaction::remap(qc::Operation& op, const std::vector<dd::Qubit>& position, dd::QubitCount nqubits) {
+    if (op.isCompoundOperation()) {
+        auto* comp_op = dynamic_cast<qc::CompoundOperation*>(&op);
+        if (comp_op == nullptr) {
+            throw std::runtime_error("Dynamic cast to CompoundOperation failed.");
+        }
+        for (auto& sub_op: *comp_op) {
+            remap(*sub_op, position, nqubits);
+        }
+    } else if (op.isClassicControlledOperation()) {
+        auto* cc_op = dynamic_cast<qc::ClassicControlledOperation*>(&op);
+        if (cc_op == nullptr) {
+            throw std::runtime_error("Dynamic cast to ClassicControlledOperation failed.");
+        }
+        remap(*cc_op->getOperation(), position, nqubits);
+    } else {
+        qc::Targets targets{};
+        for (const auto target: op.getTargets()) {
+            targets.push_back(position.at(static_cast<std::size_t>(target)));
+        }
+        dd::Controls controls{};
+        for (const auto& control: op.getControls()) {
+            controls.insert({position.at(static_cast<std::size_t>(control.qubit)), control.type});
+        }
+        op.setTargets(targets);
+        op.setControls(controls);
+    }
+    op.setNqubits(nqubits);
+}
+
+dd::Package::vEdge RegisterCompaction::expand(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e) const {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    std::unordered_map<dd::Package::vNode*, dd::Package::vEdge> cache{};
+
+    const auto top = e.isTerminal() ? static_cast<dd::Qubit>(-1) : active.at(static_cast<std::size_t>(e.p->v));
+    return pad(dd, scale(dd, expandNode(dd, e, cache), e.w), top, static_cast<dd::Qubit>(nqubits));
+}
+
+dd::Package::vEdge RegisterCompaction::expandNode(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>& cache) const {
+    if (e.isTerminal()) {
+        return dd::Package::vEdge::one;
+    }
+    auto*      p  = e.p;
+    const auto it = cache.find(p);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    const auto                        level = active.at(static_cast<std::size_t>(p->v));
+    std::array<dd::Package::vEdge, 2> edges{};
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        const auto& c = p->e.at(i);
+        if (c.w == dd::Complex::zero) {
+            edges.at(i) = dd::Package::vEdge::zero;
+            continue;
+        }
+        const auto below = c.isTerminal() ? static_cast<dd::Qubit>(-1) : active.at(static_cast<std::size_t>(c.p->v));
+        edges.at(i)      = pad(dd, scale(dd, expandNode(dd, c, cache), c.w), below, level);
+    }
+    const auto r = dd->makeDDNode(level, edges);
+    cache.emplace(p, r);
+    return r;
+}
+
+dd::Package::vEdge RegisterCompaction::pad(std::unique_ptr<dd::Package>& dd, dd::Package::vEdge e, dd::Qubit lower, dd::Qubit upper) {
+    // all levels strictly between two active qubits belong to idle qubits
+    for (auto level = static_cast<dd::Qubit>(lower + 1); level < upper; ++level) {
+        e = dd->makeDDNode(level, std::array{e, dd::Package::vEdge::zero});
+    }
+    return e;
+}
+
+dd::Package::vEdge RegisterCompaction::scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, const dd::Complex& w) {
+    const auto ar = dd::CTEntry::val(e.w.r);
+    const auto ai = dd::CTEntry::val(e.w.i);
+    const auto br = dd::CTEntry::val(w.r);
+    const auto bi = dd::CTEntry::val(w.i);
+    return {e.p, dd->cn.lookup(ar * br - ai * bi, ar * bi + ai * br)};
+}
@@ -0,0 +1,110 @@
+#include "RepeatedBlocks.hpp"
+
+void RepeatedBlocks::analyze(const ExecutionPlan& plan) {
+    clear();
+
+    std::size_t i = 0;
+    while (i < plan.size()) {
+        Run best{i, 0, 0};
+        for (std::size_t length = 1; length <= max_length && i + MIN_REPETITIONS * length <= plan.size(); ++length) {
+            // longer blocks would contain the non-gate as well
+            if (!isBlockGate(plan.at(i + length - 1))) {
+                break;
+            }
+            std::size_t repetitions = 1;
+            while (i + (repetitions + 1) * length <= plan.size() && sameBlock(plan, i, i + repetitions * length, length)) {
+                repetitions++;
+            }
+            if (repetitions >= MIN_REPETITIONS && repetitions * length > best.repetitions * best.length) {
+                best = {i, length, repetitions};
+            }
+        }
+        if (best.repetitions > 0) {
+            run_index[i] = runs.size();
+            runs.push_back(best);
+            i += best.length * best.repetitions;
+        } else {
+            ++i;
+        }
+    }
+}
+
+const RepeatedBlocks::Run* RepeatedBlocks::runAt(std::size_t start) const {
+    const auto it = run_index.find(start);
+    return it == run_index.end() ? nullptr : &runs.at(it->second);
+}
+
+bool RepeatedBlocks::apply(const ExecutionPlan& plan, const Run& run, dd::Package::vEdge& state) {
+    auto it = powers.find(run.start);
+    if (it == powers.end()) {
+        it = powers.emplace(run.start, computePowers(plan, run)).first;
+    }
+    const auto& block_powers = it->second;
+    if (block_powers.empty()) {
+        return false;
+    }
+
+    auto remaining = run.repetitions;
+    for (auto j = block_powers.size(); j-- > 0;) {
+        const std::size_t repetitions = 1ULL << j;
+        while (remaining >= repetitions) {
+            auto next = dd->multiply(block_powers.at(j), state);
+            dd->incRef(next);
+            dd->decRef(state);
+            state = next;
+            remaining -= repetitions;
+        }
+    }
+    applied_runs++;
+    return true;
+}
+
+void RepeatedBlocks::clear() {
+    for (const auto& [start, block_powers]: powers) {
+        for (const auto& power: block_powers) {
+            dd->decRef(power);
+        }
+    }
+    powers.clear();
+    runs.clear();
+    run_index.clear();
+}
+
+bool RepeatedBlocks::sameBlock(const ExecutionPlan& plan, std::size_t first, std::size_t second, std::size_t length) {
+    for (std::size_t k = 0; k < length; ++k) {
+        const auto& a = plan.at(first + k);
+        const auto& b = plan.at(second + k);
+        if (!isBlockGate(a) || !isBlockGate(b) || !a.op->equals(*b.op)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<dd::Package::mEdge> RepeatedBlocks::computePowers(const ExecutionPlan& plan, const Run& run) {
+    // gates applied directly by the GateApplicator do not have a DD in the plan
+    const auto gateDD = [&](const ExecutionPlan::Instruction& instruction) {
+        return instruction.matrix ? instruction.op->getDD(dd) : instruction.dd;
+    };
+
+    auto block = gateDD(plan.at(run.start));
+    for (std::size_t k = 1; k < run.length; ++k) {
+        block = dd->multiply(gateDD(plan.at(run.start + k)), block);
+    }
+    if (dd->size(block) > max_nodes) {
+        return {};
+    }
+    dd->incRef(block);
+
+    std::vector<dd::Package::mEdge> block_powers{block};
+    while ((1ULL << block_powers.size()) <= run.repetitions) {
+        auto square = dd->multiply(block_powers.back(), block_powers.back());
+        if (dd->size(square) > max_nodes) {
+            break;
+        }
+        dd->incRef(square);
+        block_powers.push_back(square);
+        squarings++;
+    }
+    return block_powers;
+}
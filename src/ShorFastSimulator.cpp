@@ -330,8 +330,7 @@ dd::Package::mEdge ShorFastSimulator::addConstMod(unsigned long long a) {
 
 void ShorFastSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target) {
     number_of_operations++;
-    dd::Edge gate = dd->makeGateDD(matrix, n_qubits, target);
-    dd::Edge tmp  = dd->multiply(gate, root_edge);
+    dd::Edge tmp = applicator.apply(matrix, target, {}, root_edge);
     dd->incRef(tmp);
     dd->decRef(root_edge);
     root_edge = tmp;
@@ -677,8 +677,7 @@ void ShorSimulator::u_a(unsigned long long a, int N, int c) {
 }
 
 void ShorSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target) {
-    dd::Edge gate = dd->makeGateDD(matrix, n_qubits, target);
-    dd::Edge tmp  = dd->multiply(gate, root_edge);
+    dd::Edge tmp = applicator.apply(matrix, target, {}, root_edge);
     dd->incRef(tmp);
     dd->decRef(root_edge);
     root_edge = tmp;
@@ -687,8 +686,7 @@ void ShorSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target) {
 }
 
 void ShorSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target, dd::Control control) {
-    dd::Edge gate = dd->makeGateDD(matrix, n_qubits, control, target);
-    dd::Edge tmp  = dd->multiply(gate, root_edge);
+    dd::Edge tmp = applicator.apply(matrix, target, dd::Controls{control}, root_edge);
     dd->incRef(tmp);
     dd->decRef(root_edge);
     root_edge = tmp;
@@ -697,8 +695,7 @@ void ShorSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target, dd::Contr
 }
 
 void ShorSimulator::ApplyGate(dd::GateMatrix matrix, dd::Qubit target, const dd::Controls& controls) {
-    dd::Edge gate = dd->makeGateDD(matrix, n_qubits, controls, target);
-    dd::Edge tmp  = dd->multiply(gate, root_edge);
+    dd::Edge tmp = applicator.apply(matrix, target, controls, root_edge);
     dd->incRef(tmp);
     dd->decRef(root_edge);
     root_edge = tmp;
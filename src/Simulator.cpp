@@ -33,12 +33,191 @@ std::map<std::string, std::size_t> Simulator::SampleFromAmplitudeVectorInPlace(s
     return results;
 }
 
+std::vector<bool> Simulator::MeasureCollapsing(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    if (qubits.empty()) {
+        return {};
+    }
+    auto outcomes = InvolvedLevels(edge, qubits);
+    const auto probability = SelectOutcome(edge, outcomes, &generator);
+    Project(localDD, edge, outcomes, false, probability);
+
+    std::vector<bool> result;
+    result.reserve(qubits.size());
+    for (const auto qubit: qubits) {
+        result.push_back(outcomes.at(qubit) == 1);
+    }
+    return result;
+}
+
+void Simulator::ResetQubits(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, std::mt19937_64& generator) {
+    if (qubits.empty()) {
+        return;
+    }
+    auto outcomes = InvolvedLevels(edge, qubits);
+    const auto probability = SelectOutcome(edge, outcomes, &generator);
+    Project(localDD, edge, outcomes, true, probability);
+}
+
+dd::fp Simulator::PostSelect(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits, const std::vector<bool>& outcomes) {
+    if (qubits.size() != outcomes.size()) {
+        throw std::runtime_error("Post-selection: Sizes of qubits and outcomes mismatch.");
+    }
+    if (qubits.empty()) {
+        return 1.;
+    }
+    auto levels = InvolvedLevels(edge, qubits);
+    for (std::size_t i = 0; i < qubits.size(); ++i) {
+        levels.at(qubits.at(i)) = outcomes.at(i) ? 1 : 0;
+    }
+    const auto probability = SelectOutcome(edge, levels, nullptr);
+    Project(localDD, edge, levels, false, probability);
+    return probability;
+}
+
+std::vector<signed char> Simulator::InvolvedLevels(const dd::Package::vEdge& edge, const std::vector<dd::Qubit>& qubits) {
+    if (edge.isTerminal()) {
+        throw std::runtime_error("Cannot measure or reset qubits of a terminal edge.");
+    }
+    std::vector<signed char> outcomes(static_cast<std::size_t>(edge.p->v) + 1, NOT_INVOLVED);
+    for (const auto qubit: qubits) {
+        if (qubit < 0 || qubit > edge.p->v) {
+            throw std::runtime_error("Qubit " + std::to_string(qubit) + " is not contained in the state.");
+        }
+        if (outcomes.at(qubit) != NOT_INVOLVED) {
+            throw std::runtime_error("Qubit " + std::to_string(qubit) + " occurs more than once.");
+        }
+        outcomes.at(qubit) = TO_SAMPLE;
+    }
+    return outcomes;
+}
+
+dd::fp Simulator::SelectOutcome(const dd::Package::vEdge& edge, std::vector<signed char>& outcomes, std::mt19937_64* generator) {
+    const dd::fp total = CN::mag2(edge.w);
+    if (edge.w.approximatelyZero()) {
+        throw std::runtime_error("Numerical instabilities led to a 0-vector! Abort simulation!");
+    }
+
+    dd::Qubit lowest = edge.p->v;
+    for (dd::Qubit level = 0; level <= edge.p->v; ++level) {
+        if (outcomes.at(level) != NOT_INVOLVED) {
+            lowest = level;
+            break;
+        }
+    }
+
+    // probability mass (squared norm of the paths from the root) arriving at each node of the current level
+    std::uniform_real_distribution<dd::fp>          dist(0.0L, 1.0L);
+    std::unordered_map<dd::Package::vNode*, dd::fp> current{{edge.p, total}};
+    for (dd::Qubit level = edge.p->v; level >= lowest; --level) {
+        auto& outcome = outcomes.at(level);
+        if (outcome == TO_SAMPLE) {
+            if (generator == nullptr) {
+                throw std::runtime_error("Sampling outcomes requires a random number generator.");
+            }
+            std::array<dd::fp, dd::RADIX> probs{};
+            for (const auto& [node, mass]: current) {
+                for (std::size_t i = 0; i < dd::RADIX; ++i) {
+                    probs.at(i) += mass * CN::mag2(node->e.at(i).w);
+                }
+            }
+            outcome = (dist(*generator) * (probs[0] + probs[1]) < probs[0]) ? 0 : 1;
+        }
+
+        std::unordered_map<dd::Package::vNode*, dd::fp> next;
+        for (const auto& [node, mass]: current) {
+            for (std::size_t i = 0; i < dd::RADIX; ++i) {
+                const auto& e = node->e.at(i);
+                if ((outcome != NOT_INVOLVED && outcome != static_cast<signed char>(i)) || e.w.approximatelyZero()) {
+                    continue;
+                }
+                next[e.p] += mass * CN::mag2(e.w);
+            }
+        }
+        current = std::move(next);
+    }
+
+    // the remaining nodes are normalized, i.e., their incoming mass is the probability of the outcome
+    dd::fp selected = 0;
+    for (const auto& [node, mass]: current) {
+        selected += mass;
+    }
+    return selected / total;
+}
+
+void Simulator::Project(std::unique_ptr<dd::Package>& localDD, dd::Package::vEdge& edge, const std::vector<signed char>& outcomes, bool moveToZero, dd::fp probability) {
+    if (probability <= 0) {
+        throw std::runtime_error("Cannot project onto an outcome with probability zero (e.g., an impossible post-selection).");
+    }
+
+    dd::Qubit lowest = 0;
+    while (outcomes.at(lowest) == NOT_INVOLVED) {
+        ++lowest;
+    }
+
+    std::unordered_map<dd::Package::vNode*, dd::Package::vEdge> computed;
+    dd::Package::vEdge                                          r = ProjectNode(localDD, edge, outcomes, moveToZero, lowest, computed);
+
+    dd::Complex c = localDD->cn.getTemporary(std::sqrt(CN::mag2(edge.w) * probability), 0);
+    CN::div(c, r.w, c);
+    r.w = localDD->cn.lookup(c);
+
+    localDD->incRef(r);
+    localDD->decRef(edge);
+    edge = r;
+}
+
+dd::Package::vEdge Simulator::ProjectNode(std::unique_ptr<dd::Package>& localDD, const dd::Package::vEdge& e, const std::vector<signed char>& outcomes, bool moveToZero, dd::Qubit lowest,
+                                          std::unordered_map<dd::Package::vNode*, dd::Package::vEdge>& computed) {
+    if (e.w.approximatelyZero()) {
+        return dd::Package::vEdge::zero;
+    }
+    if (e.isTerminal() || e.p->v < lowest) {
+        return e;
+    }
+
+    dd::Package::vEdge r{};
+    const auto         it = computed.find(e.p);
+    if (it != computed.end()) {
+        r = it->second;
+    } else {
+        const dd::Qubit                           level   = e.p->v;
+        const auto                                outcome = outcomes.at(level);
+        std::array<dd::Package::vEdge, dd::RADIX> edges{dd::Package::vEdge::zero, dd::Package::vEdge::zero};
+        if (outcome == NOT_INVOLVED) {
+            for (std::size_t i = 0; i < dd::RADIX; ++i) {
+                edges.at(i) = ProjectNode(localDD, e.p->e.at(i), outcomes, moveToZero, lowest, computed);
+            }
+        } else {
+            edges.at(moveToZero ? 0 : outcome) = ProjectNode(localDD, e.p->e.at(outcome), outcomes, moveToZero, lowest, computed);
+        }
+        r             = localDD->makeDDNode(level, edges, false);
+        computed[e.p] = r;
+    }
+
+    if (r.w.approximatelyZero()) {
+        return dd::Package::vEdge::zero;
+    }
+    dd::Complex c = localDD->cn.getTemporary();
+    CN::mul(c, e.w, r.w);
+    r.w = localDD->cn.lookup(c);
+    return r;
+}
+
 std::vector<dd::ComplexValue> Simulator::getVector() const {
+    if (dense_state) {
+        const auto&                   amplitudes = dense_state->getAmplitudes();
+        std::vector<dd::ComplexValue> results(amplitudes.size());
+        for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+            const auto& a = amplitudes[toLevelIndex(i)];
+            results[i]    = dd::ComplexValue{a.real(), a.imag()};
+        }
+        return results;
+    }
     assert(getNumberOfQubits() < 60); // On 64bit system the vector can hold up to (2^60)-1 elements, if memory permits
     std::string                   path(getNumberOfQubits(), '0');
     std::vector<dd::ComplexValue> results(1ull << getNumberOfQubits(), dd::complex_zero);
     for (unsigned long long i = 0; i < 1ull << getNumberOfQubits(); ++i) {
-        const std::string corrected_path{path.rbegin(), path.rend()};
+        const std::string corrected_path = toLevelPath({path.rbegin(), path.rend()});
         results[i] = dd->getValueByPath(root_edge, corrected_path);
         NextPath(path);
     }
@@ -46,12 +225,21 @@ std::vector<dd::ComplexValue> Simulator::getVector() const {
 }
 
 std::vector<std::pair<dd::fp, dd::fp>> Simulator::getVectorPair() const {
+    if (dense_state) {
+        const auto&                            amplitudes = dense_state->getAmplitudes();
+        std::vector<std::pair<dd::fp, dd::fp>> results(amplitudes.size());
+        for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+            const auto& a = amplitudes[toLevelIndex(i)];
+            results[i]    = std::make_pair(a.real(), a.imag());
+        }
+        return results;
+    }
     assert(getNumberOfQubits() < 60); // On 64bit system the vector can hold up to (2^60)-1 elements, if memory permits
     std::string                            path(getNumberOfQubits(), '0');
     std::vector<std::pair<dd::fp, dd::fp>> results{1ull << getNumberOfQubits()};
 
     for (unsigned long long i = 0; i < 1ull << getNumberOfQubits(); ++i) {
-        const std::string      corrected_path{path.rbegin(), path.rend()};
+        const std::string      corrected_path = toLevelPath({path.rbegin(), path.rend()});
         const dd::ComplexValue cv = dd->getValueByPath(root_edge, corrected_path);
         results[i]                = std::make_pair(cv.r, cv.i);
         NextPath(path);
@@ -60,12 +248,21 @@ std::vector<std::pair<dd::fp, dd::fp>> Simulator::getVectorPair() const {
 }
 
 std::vector<std::complex<dd::fp>> Simulator::getVectorComplex() const {
+    if (dense_state) {
+        const auto&                       amplitudes = dense_state->getAmplitudes();
+        std::vector<std::complex<dd::fp>> results(amplitudes.size());
+        for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+            const auto& a = amplitudes[toLevelIndex(i)];
+            results[i]    = a;
+        }
+        return results;
+    }
     assert(getNumberOfQubits() < 60); // On 64bit system the vector can hold up to (2^60)-1 elements, if memory permits
     std::string                       path(getNumberOfQubits(), '0');
     std::vector<std::complex<dd::fp>> results(1ull << getNumberOfQubits());
 
     for (unsigned long long i = 0; i < 1ull << getNumberOfQubits(); ++i) {
-        const std::string      corrected_path{path.rbegin(), path.rend()};
+        const std::string      corrected_path = toLevelPath({path.rbegin(), path.rend()});
         const dd::ComplexValue cv = dd->getValueByPath(root_edge, corrected_path);
         results[i]                = std::complex<dd::fp>(cv.r, cv.i);
         NextPath(path);
@@ -73,6 +270,115 @@ std::vector<std::complex<dd::fp>> Simulator::getVectorComplex() const {
     return results;
 }
 
+dd::fp Simulator::expectationValue(const std::vector<PauliTerm>& observable, const std::size_t nthreads) const {
+    const PauliExpectation expectation(getNumberOfQubits(), observable, qubit_levels);
+    if (dense_state) {
+        return expectation.compute(dense_state->getAmplitudes(), nthreads);
+    }
+    if (root_edge.p == nullptr) {
+        throw std::runtime_error("There is no state to compute the expectation value of.");
+    }
+    return expectation.compute(root_edge, nthreads);
+}
+
+dd::fp Simulator::expectationValue(const DiagonalCost& cost) const {
+    if (cost.getNqubits() != getNumberOfQubits()) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the simulator.");
+    }
+    if (dense_state) {
+        return cost.expectation(dense_state->getAmplitudes(), qubit_levels);
+    }
+    if (root_edge.p == nullptr) {
+        throw std::runtime_error("There is no state to compute the expectation value of.");
+    }
+    return cost.expectation(root_edge, qubit_levels);
+}
+
+DiagonalCost::CVaR Simulator::conditionalValueAtRisk(const DiagonalCost& cost, const dd::fp alpha, const std::size_t max_outcomes) const {
+    if (cost.getNqubits() != getNumberOfQubits()) {
+        throw std::runtime_error("The cost function does not match the number of qubits of the simulator.");
+    }
+    if (dense_state) {
+        return cost.cvar(dense_state->getAmplitudes(), alpha, qubit_levels);
+    }
+    if (root_edge.p == nullptr) {
+        throw std::runtime_error("There is no state to compute the CVaR of.");
+    }
+    return cost.cvar(root_edge, alpha, qubit_levels, max_outcomes);
+}
+
+Simulator::MeasurementInfo Simulator::analyzeMeasurements(const qc::QuantumComputation& qc) {
+    MeasurementInfo info{};
+    for (const auto& op: qc) {
+        if (op->isClassicControlledOperation() || (op->isNonUnitaryOperation() && op->getType() != qc::Measure && op->getType() != qc::Barrier)) {
+            info.has_nonmeasurement_nonunitary = true;
+        }
+        if (op->getType() == qc::Measure) {
+            const auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get());
+            if (nu_op == nullptr) {
+                throw std::runtime_error("Op with type Measurement could not be casted to NonUnitaryOperation");
+            }
+            info.has_measurements = true;
+
+            const auto& quantum = nu_op->getTargets();
+            const auto& classic = nu_op->getClassics();
+
+            if (quantum.size() != classic.size()) {
+                throw std::runtime_error("Measurement: Sizes of quantum and classic register mismatch.");
+            }
+
+            for (unsigned int i = 0; i < quantum.size(); ++i) {
+                info.measurement_map[quantum.at(i)] = classic.at(i);
+            }
+        }
+        if (info.has_measurements && op->isUnitary()) {
+            info.measurements_last = false;
+        }
+    }
+    return info;
+}
+
+std::map<std::string, std::size_t> Simulator::runShots(const MeasurementInfo& info, const std::size_t n_qubits, const std::size_t n_cbits, const unsigned int shots, const std::function<ExecutionPlan::ClassicalBits(bool)>& single_shot) {
+    // easiest case: all gates are unitary --> simulate once and sample away on all qubits
+    if (!info.has_nonmeasurement_nonunitary && !info.has_measurements) {
+        single_shot(false);
+        return MeasureAllNonCollapsing(shots);
+    }
+
+    // single shot is enough, but the sampling should only return actually measured qubits
+    if (info.singleRun()) {
+        single_shot(true);
+        // MeasureAllNonCollapsing returns a map from measurement over all qubits to the number of occurrences
+        return toClassicalCounts(MeasureAllNonCollapsing(shots), info.measurement_map, n_qubits, n_cbits);
+    }
+
+    // there are nonunitaries (or intermediate measurements) and we have to actually do multiple single shots :(
+    std::map<std::string, std::size_t> m_counter;
+    for (unsigned int i = 0; i < shots; i++) {
+        const auto result = single_shot(false);
+
+        // result holds the classical bits packed into words
+        std::string result_string(n_cbits, '0');
+        for (std::size_t j = 0; j < n_cbits; ++j) {
+            result_string[n_cbits - j - 1] = ExecutionPlan::getBit(result, j) ? '1' : '0';
+        }
+        m_counter[result_string]++;
+    }
+    return m_counter;
+}
+
+std::map<std::string, std::size_t> Simulator::toClassicalCounts(const std::map<std::string, std::size_t>& counts, const std::map<unsigned int, unsigned int>& measurement_map, const std::size_t n_qubits, const std::size_t n_cbits) {
+    std::map<std::string, std::size_t> classical_counts{};
+    for (const auto& [outcome, count]: counts) {
+        std::string result_string(n_cbits, '0');
+        for (const auto& [qubit, bit]: measurement_map) {
+            result_string[n_cbits - bit - 1] = outcome[n_qubits - qubit - 1];
+        }
+        classical_counts[result_string] += count;
+    }
+    return classical_counts;
+}
+
 void Simulator::NextPath(std::string& s) {
     std::string::reverse_iterator iter = s.rbegin(), end = s.rend();
     int                           carry = 1;
@@ -352,5 +658,53 @@ std::pair<dd::ComplexValue, std::string> Simulator::getPathOfLeastResistance() c
     }
 
     return {{dd::CTEntry::val(path_value.r), dd::CTEntry::val(path_value.i)},
-            std::string{result.rbegin(), result.rend()}};
+            fromLevelString(std::string{result.rbegin(), result.rend()})};
+}
+
+std::vector<dd::Qubit> Simulator::toLevels(const std::vector<dd::Qubit>& qubits) const {
+    if (qubit_levels.empty()) {
+        return qubits;
+    }
+    std::vector<dd::Qubit> levels{};
+    levels.reserve(qubits.size());
+    for (const auto qubit: qubits) {
+        levels.push_back(toLevel(qubit));
+    }
+    return levels;
+}
+
+std::size_t Simulator::toLevelIndex(std::size_t index) const {
+    if (qubit_levels.empty()) {
+        return index;
+    }
+    std::size_t level_index = 0;
+    for (std::size_t q = 0; q < qubit_levels.size(); ++q) {
+        if ((index >> q) & 1ULL) {
+            level_index |= 1ULL << qubit_levels.at(q);
+        }
+    }
+    return level_index;
+}
+
+std::string Simulator::toLevelPath(const std::string& qubit_path) const {
+    if (qubit_levels.empty()) {
+        return qubit_path;
+    }
+    std::string level_path(qubit_path.size(), '0');
+    for (std::size_t q = 0; q < qubit_path.size(); ++q) {
+        level_path.at(static_cast<std::size_t>(qubit_levels.at(q))) = qubit_path.at(q);
+    }
+    return level_path;
+}
+
+std::string Simulator::fromLevelString(const std::string& level_string) const {
+    if (qubit_levels.empty()) {
+        return level_string;
+    }
+    const std::size_t n = level_string.size();
+    std::string       qubit_string(n, '0');
+    for (std::size_t q = 0; q < n; ++q) {
+        qubit_string.at(n - q - 1) = level_string.at(n - static_cast<std::size_t>(qubit_levels.at(q)) - 1);
+    }
+    return qubit_string;
 }
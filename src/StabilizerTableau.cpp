@@ -0,0 +1,494 @@
+#include "StabilizerTableau.hpp"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+StabilizerTableau::StabilizerTableau(dd::QubitCount nqubits):
+    nqubits(nqubits),
+    xs(2 * nqubits + 1, std::vector<bool>(nqubits, false)),
+    zs(2 * nqubits + 1, std::vector<bool>(nqubits, false)),
+    rs(2 * nqubits + 1, false),
+    pivots(nqubits, 2 * static_cast<std::size_t>(nqubits)),
+    reference(nqubits, false) {
+    for (std::size_t i = 0; i < nqubits; ++i) {
+        xs.at(i).at(i)           = true;
+        zs.at(nqubits + i).at(i) = true;
+    }
+}
+
+bool StabilizerTableau::isClifford(const qc::Operation& op) {
+    if (!op.isStandardOperation()) {
+        return false;
+    }
+    for (const auto& control: op.getControls()) {
+        if (control.type != dd::Control::Type::pos) {
+            return false;
+        }
+    }
+    const auto ncontrols = op.getControls().size();
+    const auto ntargets  = op.getTargets().size();
+    switch (op.getType()) {
+        case qc::I:
+        case qc::H:
+        case qc::S:
+        case qc::Sdag:
+        case qc::V:
+        case qc::Vdag:
+        case qc::SX:
+        case qc::SXdg:
+            return ncontrols == 0 && ntargets == 1;
+        case qc::X:
+        case qc::Y:
+        case qc::Z:
+            return ncontrols <= 1 && ntargets == 1;
+        case qc::SWAP:
+            return ncontrols == 0 && ntargets == 2;
+        case qc::Phase: {
+            // controlled phase gates are only Clifford for the angles 0 and pi
+            const auto k = quarterTurns(op.getParameter().at(0));
+            return ntargets == 1 && ((ncontrols == 0 && k >= 0) || (ncontrols == 1 && k % 2 == 0));
+        }
+        case qc::RZ:
+            return ncontrols == 0 && ntargets == 1 && quarterTurns(op.getParameter().at(0)) >= 0;
+        default:
+            return false;
+    }
+}
+
+int StabilizerTableau::quarterTurns(const dd::fp angle) {
+    const auto turns   = angle / dd::PI_2;
+    const auto rounded = std::round(turns);
+    if (std::abs(turns - rounded) > dd::ComplexTable<>::tolerance()) {
+        return -1;
+    }
+    return static_cast<int>(((static_cast<long long>(rounded) % 4) + 4) % 4);
+}
+
+void StabilizerTableau::apply(const qc::Operation& op) {
+    if (!isClifford(op)) {
+        throw std::runtime_error("Operation is not supported by the stabilizer tableau.");
+    }
+    const auto& targets = op.getTargets();
+    const auto  t       = targets.front();
+    if (!op.getControls().empty()) {
+        const auto c = op.getControls().begin()->qubit;
+        switch (op.getType()) {
+            case qc::X:
+                cx(c, t);
+                break;
+            case qc::Y:
+                sdg(t);
+                cx(c, t);
+                s(t);
+                break;
+            case qc::Phase:
+                if (quarterTurns(op.getParameter().at(0)) == 2) {
+                    h(t);
+                    cx(c, t);
+                    h(t);
+                }
+                break;
+            default: // Z
+                h(t);
+                cx(c, t);
+                h(t);
+                break;
+        }
+        return;
+    }
+    switch (op.getType()) {
+        case qc::H:
+            h(t);
+            break;
+        case qc::S:
+            s(t);
+            break;
+        case qc::Sdag:
+            sdg(t);
+            break;
+        case qc::X:
+            x(t);
+            break;
+        case qc::Y:
+            y(t);
+            break;
+        case qc::Z:
+            z(t);
+            break;
+        case qc::V:
+            // H S H = e^(i pi/4) V
+            h(t);
+            s(t);
+            h(t);
+            phase *= std::polar(1., -dd::PI_4);
+            break;
+        case qc::SX:
+            h(t);
+            s(t);
+            h(t);
+            break;
+        case qc::Vdag:
+            h(t);
+            sdg(t);
+            h(t);
+            phase *= std::polar(1., dd::PI_4);
+            break;
+        case qc::SXdg:
+            h(t);
+            sdg(t);
+            h(t);
+            break;
+        case qc::Phase:
+        case qc::RZ: {
+            // RZ(theta) = e^(-i theta/2) P(theta)
+            const auto angle = op.getParameter().at(0);
+            switch (quarterTurns(angle)) {
+                case 1:
+                    s(t);
+                    break;
+                case 2:
+                    z(t);
+                    break;
+                case 3:
+                    sdg(t);
+                    break;
+                default:
+                    break;
+            }
+            if (op.getType() == qc::RZ) {
+                phase *= std::polar(1., -angle / 2.);
+            }
+            break;
+        }
+        case qc::SWAP:
+            cx(t, targets.at(1));
+            cx(targets.at(1), t);
+            cx(t, targets.at(1));
+            break;
+        default: // I
+            break;
+    }
+}
+
+void StabilizerTableau::h(dd::Qubit q) {
+    const auto a = static_cast<std::size_t>(q);
+
+    // the new reference is the one of the two basis states differing in q with the larger amplitude after H
+    const std::complex<dd::fp> flipped = relativeAmplitude(q);
+    const std::complex<dd::fp> same    = reference.at(a) ? flipped - 1. : 1. + flipped;
+    const std::complex<dd::fp> other   = reference.at(a) ? 1. + flipped : 1. - flipped;
+    if (std::abs(same) >= std::abs(other)) {
+        phase *= same / std::abs(same);
+    } else {
+        phase *= other / std::abs(other);
+        reference.at(a) = !reference.at(a);
+    }
+
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        const bool xa = xs.at(i).at(a);
+        const bool za = zs.at(i).at(a);
+        rs.at(i)      = rs.at(i) != (xa && za);
+        xs.at(i).at(a) = za;
+        zs.at(i).at(a) = xa;
+    }
+    restorePivots(a);
+}
+
+void StabilizerTableau::s(dd::Qubit q) {
+    const auto a = static_cast<std::size_t>(q);
+    if (reference.at(a)) {
+        phase *= std::complex<dd::fp>{0., 1.};
+    }
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        const bool xa  = xs.at(i).at(a);
+        const bool za  = zs.at(i).at(a);
+        rs.at(i)       = rs.at(i) != (xa && za);
+        zs.at(i).at(a) = za != xa;
+    }
+}
+
+void StabilizerTableau::sdg(dd::Qubit q) {
+    const auto a = static_cast<std::size_t>(q);
+    if (reference.at(a)) {
+        phase *= std::complex<dd::fp>{0., -1.};
+    }
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        const bool xa  = xs.at(i).at(a);
+        const bool za  = zs.at(i).at(a);
+        rs.at(i)       = rs.at(i) != (xa && !za);
+        zs.at(i).at(a) = za != xa;
+    }
+}
+
+void StabilizerTableau::x(dd::Qubit q) {
+    const auto a    = static_cast<std::size_t>(q);
+    reference.at(a) = !reference.at(a);
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        rs.at(i) = rs.at(i) != zs.at(i).at(a);
+    }
+}
+
+void StabilizerTableau::y(dd::Qubit q) {
+    const auto a = static_cast<std::size_t>(q);
+    // Y|0> = i|1> and Y|1> = -i|0>
+    phase *= std::complex<dd::fp>{0., reference.at(a) ? -1. : 1.};
+    reference.at(a) = !reference.at(a);
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        rs.at(i) = rs.at(i) != (xs.at(i).at(a) != zs.at(i).at(a));
+    }
+}
+
+void StabilizerTableau::z(dd::Qubit q) {
+    const auto a = static_cast<std::size_t>(q);
+    if (reference.at(a)) {
+        phase = -phase;
+    }
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        rs.at(i) = rs.at(i) != xs.at(i).at(a);
+    }
+}
+
+void StabilizerTableau::cx(dd::Qubit control, dd::Qubit target) {
+    const auto a = static_cast<std::size_t>(control);
+    const auto b = static_cast<std::size_t>(target);
+    if (reference.at(a)) {
+        reference.at(b) = !reference.at(b);
+    }
+    for (std::size_t i = 0; i < 2 * nqubits; ++i) {
+        const bool xa  = xs.at(i).at(a);
+        const bool za  = zs.at(i).at(a);
+        const bool xb  = xs.at(i).at(b);
+        const bool zb  = zs.at(i).at(b);
+        rs.at(i)       = rs.at(i) != (xa && zb && (xb == za));
+        xs.at(i).at(b) = xb != xa;
+        zs.at(i).at(a) = za != zb;
+    }
+    restorePivots(b);
+}
+
+bool StabilizerTableau::measure(dd::Qubit q, bool preferred) {
+    const auto a = static_cast<std::size_t>(q);
+    const auto n = static_cast<std::size_t>(nqubits);
+
+    auto p = pivots.at(a);
+    if (p == 2 * n) {
+        // only stabilizers with a pivot have an X part
+        for (std::size_t i = n; i < 2 * n; ++i) {
+            if (xs.at(i).at(a)) {
+                makePivot(i, a);
+                p = i;
+                break;
+            }
+        }
+    }
+    if (p < 2 * n) {
+        // the outcome is random; the stabilizer p maps the reference to a basis state with the preferred value and, as
+        // the pivot of the qubit, is the only stabilizer with an X part on it
+        if (reference.at(a) != preferred) {
+            phase *= rowPhase(p);
+            for (std::size_t j = 0; j < n; ++j) {
+                reference.at(j) = reference.at(j) != xs.at(p).at(j);
+            }
+        }
+        for (std::size_t i = 0; i < 2 * n; ++i) {
+            if (i != p && xs.at(i).at(a)) {
+                rowsum(i, p);
+            }
+        }
+        xs.at(p - n) = xs.at(p);
+        zs.at(p - n) = zs.at(p);
+        rs.at(p - n) = rs.at(p);
+        xs.at(p).assign(n, false);
+        zs.at(p).assign(n, false);
+        zs.at(p).at(a) = true;
+        rs.at(p)       = preferred;
+        pivots.at(a)   = 2 * n;
+        return preferred;
+    }
+
+    // the outcome is determined by the stabilizers
+    xs.at(2 * n).assign(n, false);
+    zs.at(2 * n).assign(n, false);
+    rs.at(2 * n) = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (xs.at(i).at(a)) {
+            rowsum(2 * n, i + n);
+        }
+    }
+    return rs.at(2 * n);
+}
+
+void StabilizerTableau::rowsum(std::size_t h, std::size_t i) {
+    // exponent of i picked up when multiplying the Paulis qubit by qubit
+    int sum = 2 * static_cast<int>(rs.at(h)) + 2 * static_cast<int>(rs.at(i));
+    for (std::size_t j = 0; j < nqubits; ++j) {
+        const int x1 = xs.at(i).at(j);
+        const int z1 = zs.at(i).at(j);
+        const int x2 = xs.at(h).at(j);
+        const int z2 = zs.at(h).at(j);
+        if (x1 == 1 && z1 == 1) {
+            sum += z2 - x2;
+        } else if (x1 == 1) {
+            sum += z2 * (2 * x2 - 1);
+        } else if (z1 == 1) {
+            sum += x2 * (1 - 2 * z2);
+        }
+        xs.at(h).at(j) = x1 != x2;
+        zs.at(h).at(j) = z1 != z2;
+    }
+    rs.at(h) = ((sum % 4) + 4) % 4 == 2;
+}
+
+void StabilizerTableau::combineStabilizers(std::size_t h, std::size_t i) {
+    const auto n = static_cast<std::size_t>(nqubits);
+    rowsum(h, i);
+    // the destabilizer of i has to commute with the new stabilizer h
+    rowsum(i - n, h - n);
+}
+
+std::size_t StabilizerTableau::pivotColumn(std::size_t row) const {
+    std::size_t col = 0;
+    while (col < nqubits && pivots.at(col) != row) {
+        ++col;
+    }
+    return col;
+}
+
+void StabilizerTableau::makePivot(std::size_t row, std::size_t col) {
+    const auto n   = static_cast<std::size_t>(nqubits);
+    const auto old = pivotColumn(row);
+    if (old < n) {
+        pivots.at(old) = 2 * n;
+    }
+    pivots.at(col) = row;
+    // the row has no X part on the other pivots, hence they are kept
+    for (std::size_t i = n; i < 2 * n; ++i) {
+        if (i != row && xs.at(i).at(col)) {
+            combineStabilizers(i, row);
+        }
+    }
+}
+
+void StabilizerTableau::restorePivots(std::size_t col) {
+    const auto n = static_cast<std::size_t>(nqubits);
+    const auto r = pivots.at(col);
+    if (r < 2 * n) {
+        if (xs.at(r).at(col)) {
+            makePivot(r, col);
+        } else {
+            pivots.at(col) = 2 * n;
+        }
+    }
+    // the stabilizers without a pivot have no X part on the pivots, but may have gained one elsewhere
+    for (std::size_t i = n; i < 2 * n; ++i) {
+        if (pivotColumn(i) < n) {
+            continue;
+        }
+        for (std::size_t j = 0; j < n; ++j) {
+            if (xs.at(i).at(j)) {
+                makePivot(i, j);
+                break;
+            }
+        }
+    }
+}
+
+dd::Package::vEdge StabilizerTableau::toDD(std::unique_ptr<dd::Package>& dd) const {
+    auto state = dd->makeBasisState(nqubits, reference);
+    dd->incRef(state);
+
+    // the state is proportional to prod_g (I + g) |basis>; stabilizers without X part leave the intermediate states unchanged
+    for (std::size_t row = nqubits; row < 2 * static_cast<std::size_t>(nqubits); ++row) {
+        bool has_x = false;
+        for (const auto b: xs.at(row)) {
+            has_x = has_x || b;
+        }
+        if (!has_x) {
+            continue;
+        }
+        PauliCache cache{};
+        auto       flipped = applyRow(dd, state, row, cache);
+        if (rs.at(row)) {
+            flipped = scale(dd, flipped, -1., 0.);
+        }
+        auto       sum     = dd->add(state, flipped);
+        dd->incRef(sum);
+        dd->decRef(state);
+        state = sum;
+    }
+
+    const auto norm = dd->innerProduct(state, state).r;
+    dd->decRef(state);
+    // the projection leaves the amplitude of the reference real and positive
+    return scale(dd, state, phase.real() / std::sqrt(norm), phase.imag() / std::sqrt(norm));
+}
+
+std::complex<dd::fp> StabilizerTableau::relativeAmplitude(dd::Qubit q) const {
+    const auto a = static_cast<std::size_t>(q);
+    const auto n = static_cast<std::size_t>(nqubits);
+
+    // the flipped reference is in the support iff some product of stabilizers has X part e_q, which can only be the
+    // stabilizer with the pivot q
+    const auto row = pivots.at(a);
+    if (row == 2 * n) {
+        return 0.;
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        if (xs.at(row).at(j) != (j == a)) {
+            return 0.;
+        }
+    }
+    // <reference ^ e_q|psi> = <reference ^ e_q|P|psi> = <reference ^ e_q|P|reference> <reference|psi>
+    return rowPhase(row);
+}
+
+std::complex<dd::fp> StabilizerTableau::rowPhase(std::size_t row) const {
+    std::complex<dd::fp> factor{rs.at(row) ? -1. : 1., 0.};
+    for (std::size_t j = 0; j < nqubits; ++j) {
+        const bool x = xs.at(row).at(j);
+        const bool z = zs.at(row).at(j);
+        if (z && reference.at(j)) {
+            factor = -factor;
+        }
+        if (x && z) {
+            // Y = i X Z
+            factor *= std::complex<dd::fp>{0., 1.};
+        }
+    }
+    return factor;
+}
+
+dd::Package::vEdge StabilizerTableau::applyRow(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, std::size_t row, PauliCache& cache) const {
+    if (e.w == dd::Complex::zero || e.isTerminal()) {
+        return e;
+    }
+    auto it = cache.find(e.p);
+    if (it == cache.end()) {
+        const auto                        q  = static_cast<std::size_t>(e.p->v);
+        const auto                        c0 = applyRow(dd, e.p->e.at(0), row, cache);
+        const auto                        c1 = applyRow(dd, e.p->e.at(1), row, cache);
+        std::array<dd::Package::vEdge, 2> edges{c0, c1};
+        const bool                        x = xs.at(row).at(q);
+        const bool                        z = zs.at(row).at(q);
+        if (x && z) {
+            // Y = [[0, -i], [i, 0]]
+            edges = {scale(dd, c1, 0., -1.), scale(dd, c0, 0., 1.)};
+        } else if (x) {
+            edges = {c1, c0};
+        } else if (z) {
+            edges = {c0, scale(dd, c1, -1., 0.)};
+        }
+        it = cache.emplace(e.p, dd->makeDDNode(e.p->v, edges)).first;
+    }
+    return scale(dd, it->second, dd::CTEntry::val(e.w.r), dd::CTEntry::val(e.w.i));
+}
+
+dd::Package::vEdge StabilizerTableau::scale(std::unique_ptr<dd::Package>& dd, const dd::Package::vEdge& e, dd::fp r, dd::fp i) {
+    if (e.w == dd::Complex::zero) {
+        return dd::Package::vEdge::zero;
+    }
+    const auto ar = dd::CTEntry::val(e.w.r);
+    const auto ai = dd::CTEntry::val(e.w.i);
+    return {e.p, dd->cn.lookup(ar * r - ai * i, ar * i + ai * r)};
+}
@@ -0,0 +1,44 @@
+#include "StateVectorSimulator.hpp"
+
+std::map<std::string, std::size_t> StateVectorSimulator::Simulate(const unsigned int shots) {
+    const auto          measurements = analyzeMeasurements(*qc);
+    const ExecutionPlan plan(*qc, dd, true);
+    return runShots(measurements, qc->getNqubits(), qc->getNcbits(), shots, [&](bool ignore_nonunitaries) { return single_shot(plan, ignore_nonunitaries); });
+}
+
+ExecutionPlan::ClassicalBits StateVectorSimulator::single_shot(const ExecutionPlan& plan, const bool ignore_nonunitaries) {
+    single_shots++;
+    if (initial_state.isZeroState()) {
+        dense_state = std::make_unique<DenseState>(plan.getNqubits());
+    } else {
+        dense_state = std::make_unique<DenseState>(initial_state.toVector(plan.getNqubits()));
+    }
+    dense_state->setExecutor(nthreads > 1 ? &executor : nullptr);
+
+    auto classic_values = plan.makeClassicalBits();
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        const auto& instruction = plan.at(i);
+        if (instruction.kind == ExecutionPlan::Kind::Gate) {
+            if (instruction.isConditional() && !ExecutionPlan::conditionHolds(instruction, classic_values)) {
+                continue;
+            }
+            if (instruction.matrix) {
+                dense_state->applyGate(*instruction.matrix, instruction.qubits.front(), instruction.op->getControls());
+            } else if (instruction.two_target_matrix) {
+                dense_state->applyTwoTargetGate(*instruction.two_target_matrix, instruction.qubits.at(0), instruction.qubits.at(1), instruction.op->getControls());
+            } else {
+                dense_state->applyMatrix(instruction.dd);
+            }
+        } else if (ignore_nonunitaries) {
+            continue;
+        } else if (instruction.kind == ExecutionPlan::Kind::Measure) {
+            const auto results = dense_state->measure(instruction.qubits, mt);
+            for (std::size_t j = 0; j < results.size(); ++j) {
+                ExecutionPlan::setBit(classic_values, instruction.classics.at(j), results.at(j));
+            }
+        } else {
+            dense_state->reset(instruction.qubits, mt);
+        }
+    }
+    return classic_values;
+}
@@ -12,93 +12,53 @@ std::map<std::string, std::size_t> StochasticNoiseSimulator::Simulate(unsigned i
         }
     }
 
+    const ExecutionPlan plan(*qc, dd);
+
     if (!has_nonunitary) {
-        perfect_simulation_run();
+        perfect_simulation_run(plan);
         return MeasureAllNonCollapsing(shots);
     }
 
     std::map<std::string, std::size_t> m_counter;
 
     for (unsigned int i = 0; i < shots; i++) {
-        perfect_simulation_run();
+        perfect_simulation_run(plan);
         m_counter[MeasureAll()]++;
     }
 
     return m_counter;
 }
 
-void StochasticNoiseSimulator::perfect_simulation_run() {
+void StochasticNoiseSimulator::perfect_simulation_run(const ExecutionPlan& plan) {
     const unsigned short n_qubits = qc->getNqubits();
 
     root_edge = dd->makeZeroState(n_qubits);
     dd->incRef(root_edge);
 
-    unsigned long       op_num = 0;
-    std::map<int, bool> classic_values;
-
-    for (auto& op: *qc) {
-        if (op->isNonUnitaryOperation()) {
-            if (auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get())) {
-                if (op->getType() == qc::Measure) {
-                    auto quantum = nu_op->getTargets();
-                    auto classic = nu_op->getClassics();
-
-                    assert(quantum.size() == classic.size()); // this should not happen do to check in Simulate
+    auto classic_values = plan.makeClassicalBits();
 
-                    for (unsigned int i = 0; i < quantum.size(); ++i) {
-                        auto result = MeasureOneCollapsing(quantum.at(i));
-                        assert(result == '0' || result == '1');
-                        classic_values[classic.at(i)] = (result == '1');
-                    }
-                } else if (op->getType() == qc::Reset) {
-                    // Reset qubit
-                    auto quantum = nu_op->getTargets();
-                    for (signed char i: quantum) {
-                        auto result = MeasureOneCollapsing(i, true);
-                        if (result == '1') {
-                            setMeasuredQubitToZero(quantum.at(i), root_edge, dd);
-                        }
-                    }
-                } else if (op->getType() == qc::Barrier) {
-                    continue;
-                } else {
-                    throw std::runtime_error(std::string("Unsupported non-unitary functionality '") + op->getName() + "'.");
-                }
-            } else {
-                throw std::runtime_error(std::string("Dynamic cast to NonUnitaryOperation failed for '") + op->getName() + "'.");
+    for (const auto& instruction: plan) {
+        if (instruction.kind == ExecutionPlan::Kind::Measure) {
+            const auto results = MeasureCollapsing(instruction.qubits);
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                ExecutionPlan::setBit(classic_values, instruction.classics.at(i), results.at(i));
             }
-            dd->garbageCollect();
+            gc_policy.afterOperation(dd, true);
+        } else if (instruction.kind == ExecutionPlan::Kind::Reset) {
+            ResetQubits(instruction.qubits);
+            gc_policy.afterOperation(dd, true);
         } else {
-            if (op->isClassicControlledOperation()) {
-                if (auto* cc_op = dynamic_cast<qc::ClassicControlledOperation*>(op.get())) {
-                    const auto         start_index    = static_cast<unsigned short>(cc_op->getParameter().at(0));
-                    const auto         length         = static_cast<unsigned short>(cc_op->getParameter().at(1));
-                    const unsigned int expected_value = cc_op->getExpectedValue();
-
-                    unsigned int actual_value = 0;
-                    for (unsigned int i = 0; i < length; i++) {
-                        actual_value |= (classic_values[start_index + i] ? 1u : 0u) << i;
-                    }
-
-                    //std::clog << "expected " << expected_value << " and actual value was " << actual_value << "\n";
-
-                    if (actual_value != expected_value) {
-                        continue;
-                    }
-                } else {
-                    throw std::runtime_error("Dynamic cast to ClassicControlledOperation failed.");
-                }
+            if (instruction.isConditional() && !ExecutionPlan::conditionHolds(instruction, classic_values)) {
+                continue;
             }
 
-            auto dd_op = op->getDD(dd);
-            auto tmp   = dd->multiply(dd_op, root_edge);
+            auto tmp = dd->multiply(instruction.dd, root_edge);
             dd->incRef(tmp);
             dd->decRef(root_edge);
             root_edge = tmp;
 
-            dd->garbageCollect();
+            gc_policy.afterOperation(dd);
         }
-        op_num++;
     }
 }
 
@@ -111,7 +71,10 @@ std::map<std::string, double> StochasticNoiseSimulator::StochSimulate() {
     }
     //std::clog << "Conducting perfect run...\n";
     const auto t1_perfect = std::chrono::steady_clock::now();
-    perfect_simulation_run();
+    {
+        const ExecutionPlan plan(*qc, dd);
+        perfect_simulation_run(plan);
+    }
     const auto t2_perfect = std::chrono::steady_clock::now();
     perfect_run_time      = std::chrono::duration<float>(t2_perfect - t1_perfect).count();
 
@@ -123,6 +86,9 @@ std::map<std::string, double> StochasticNoiseSimulator::StochSimulate() {
         recorded_properties_per_instance.emplace_back(std::vector<double>(recorded_properties.size(), 0));
     }
     //std::clog << "Conducting " << stochastic_runs << " runs using " << max_instances << " cores...\n";
+    // every thread decides on its own when to collect garbage in its package
+    std::vector<GarbageCollectionPolicy> gc_policy_per_instance(max_instances, GarbageCollectionPolicy(gc_policy.getInfo()));
+
     std::vector<std::thread> threadArray;
     // The stochastic runs are applied in parallel
     //std::clog << "Starting " << max_instances << " threads\n";
@@ -135,12 +101,16 @@ std::map<std::string, double> StochasticNoiseSimulator::StochSimulate() {
                                  noiseless_root_edge,
                                  std::ref(recorded_properties_per_instance[runID]),
                                  std::ref(recorded_properties),
+                                 std::ref(gc_policy_per_instance[runID]),
                                  static_cast<unsigned long long>(mt()));
     }
     // wait for threads to finish
     for (auto& thread: threadArray) {
         thread.join();
     }
+    for (const auto& policy: gc_policy_per_instance) {
+        gc_policy.merge(policy);
+    }
     const auto t2_stoch = std::chrono::steady_clock::now();
     stoch_run_time      = std::chrono::duration<float>(t2_stoch - t1_stoch).count();
     //std::clog <<"Calculating amplitudes from all runs...\n";
@@ -174,6 +144,7 @@ void StochasticNoiseSimulator::runStochSimulationForId(unsigned int
                                                        dd::Package::vEdge                          rootEdgePerfectRun,
                                                        std::vector<double>&                        recordedPropertiesStorage,
                                                        std::vector<std::tuple<long, std::string>>& recordedPropertiesList,
+                                                       GarbageCollectionPolicy&                    localGcPolicy,
                                                        unsigned long long                          localSeed) {
     std::mt19937_64                        generator(localSeed);
     std::uniform_real_distribution<dd::fp> dist(0.0, 1.0L);
@@ -183,90 +154,48 @@ void StochasticNoiseSimulator::runStochSimulationForId(unsigned int
 
     //        dd::NoiseOperationTable<dd::Package::mEdge> noiseOperationTable(getNumberOfQubits());
 
+    std::unique_ptr<dd::Package> localDD = std::make_unique<dd::Package>(getNumberOfQubits());
+
+    dd::Package::mEdge identity_DD = localDD->makeIdent(n_qubits);
+    localDD->incRef(identity_DD);
+
+    // the gate DDs are built once per thread and reused for all runs of this thread
+    const ExecutionPlan plan(*qc, localDD);
+
     //printf("Running %d times and using the dd at %p, using the cn object at %p\n", numberOfRuns, (void *) &localDD, (void *) &localDD->cn);
     for (unsigned long current_run = 0; current_run < numberOfRuns; current_run++) {
         const auto t1 = std::chrono::steady_clock::now();
 
-        std::unique_ptr<dd::Package> localDD = std::make_unique<dd::Package>(getNumberOfQubits());
-
-        std::map<unsigned int, bool> classic_values;
+        auto classic_values = plan.makeClassicalBits();
 
         unsigned int op_count     = 0;
         unsigned int approx_count = 0;
 
-        dd::Package::mEdge identity_DD = localDD->makeIdent(n_qubits);
-        localDD->incRef(identity_DD);
         dd::Package::vEdge localRootEdge = localDD->makeZeroState(n_qubits);
         localDD->incRef(localRootEdge);
 
-        for (auto& op: *qc) {
-            if (!op->isUnitary() && !(op->isClassicControlledOperation())) {
-                if (auto* nu_op = dynamic_cast<qc::NonUnitaryOperation*>(op.get())) {
-                    if (nu_op->getName()[0] == 'M') {
-                        auto quantum = nu_op->getTargets();
-                        auto classic = nu_op->getClassics();
-
-                        assert(quantum.size() == classic.size()); // this should not happen do to check in Simulate
-
-                        for (unsigned int i = 0; i < quantum.size(); ++i) {
-                            char result = localDD->measureOneCollapsing(localRootEdge, quantum.at(i), true, generator);
-                            assert(result == '0' || result == '1');
-                            classic_values[classic.at(i)] = (result == '1');
-                        }
-                    } else if (nu_op->getName()[0] == 'R' && nu_op->getName()[1] == 's' && nu_op->getName()[2] == 't') {
-                        // Reset qubit
-                        throw std::runtime_error("Warning: Reset is currently not supported");
-                    } else {
-                        //Skipping barrier
-                        if (op->getType() == qc::Barrier) {
-                            continue;
-                        }
-                        throw std::runtime_error("Unsupported non-unitary functionality.");
-                    }
-                } else {
-                    throw std::runtime_error("Dynamic cast to NonUnitaryOperation failed.");
+        for (const auto& instruction: plan) {
+            if (instruction.kind == ExecutionPlan::Kind::Measure) {
+                const auto results = MeasureCollapsing(localDD, localRootEdge, instruction.qubits, generator);
+                for (std::size_t i = 0; i < results.size(); ++i) {
+                    ExecutionPlan::setBit(classic_values, instruction.classics.at(i), results.at(i));
                 }
+            } else if (instruction.kind == ExecutionPlan::Kind::Reset) {
+                ResetQubits(localDD, localRootEdge, instruction.qubits, generator);
             } else {
-                dd::Package::mEdge dd_op{};
-                qc::Targets        targets;
-                dd::Controls       controls;
-                if (op->isClassicControlledOperation()) {
-                    // Check if the operation is controlled by a classical register
-                    auto* classic_op = dynamic_cast<qc::ClassicControlledOperation*>(op.get());
-                    bool  execute_op = true;
-                    auto  expValue   = classic_op->getExpectedValue();
-
-                    for (unsigned int i = classic_op->getControlRegister().first; i < classic_op->getControlRegister().second; i++) {
-                        if (classic_values[i] != (expValue % 2)) {
-                            execute_op = false;
-                            break;
-                        } else {
-                            expValue = expValue >> 1u;
-                        }
-                    }
-                    dd_op    = classic_op->getOperation()->getDD(localDD);
-                    targets  = classic_op->getOperation()->getTargets();
-                    controls = classic_op->getOperation()->getControls();
-                    if (!execute_op) {
-                        // applyNoiseOperation(targets.front(), controls, identity_DD, (std::unique_ptr<dd::Package> &) localDD, localRootEdge, generator, dist, line, identity_DD);
-                        continue;
-                    }
-                } else {
-                    dd_op    = op->getDD(localDD);
-                    targets  = op->getTargets();
-                    controls = op->getControls();
+                if (instruction.isConditional() && !ExecutionPlan::conditionHolds(instruction, classic_values)) {
+                    continue;
                 }
 
-                applyNoiseOperation(targets, controls, dd_op, localDD, localRootEdge, generator, dist, identity_DD);
+                applyNoiseOperation(instruction.qubits, instruction.dd, localDD, localRootEdge, generator, dist, identity_DD);
                 if (step_fidelity < 1 && (op_count + 1) % approx_mod == 0) {
                     ApproximateByFidelity(localDD, localRootEdge, step_fidelity, false, true);
                     approx_count++;
                 }
             }
-            localDD->garbageCollect();
+            localGcPolicy.afterOperation(localDD, instruction.kind == ExecutionPlan::Kind::Measure);
             op_count++;
         }
-        localDD->decRef(localRootEdge);
         const auto t2 = std::chrono::steady_clock::now();
 
         for (unsigned long i = 0; i < recordedPropertiesStorage.size(); i++) {
@@ -284,23 +213,20 @@ void StochasticNoiseSimulator::runStochSimulationForId(unsigned int
                 recordedPropertiesStorage[i] += prob;
             }
         }
+        localDD->decRef(localRootEdge);
+        // the state of the run is no longer needed
+        localGcPolicy.afterOperation(localDD, true);
     }
 }
 
-void StochasticNoiseSimulator::applyNoiseOperation(const qc::Targets&                      targets,
-                                                   const dd::Controls&                     control_qubits,
+void StochasticNoiseSimulator::applyNoiseOperation(const std::vector<dd::Qubit>&           usedQubits,
                                                    dd::Package::mEdge                      dd_op,
                                                    std::unique_ptr<dd::Package>&           localDD,
                                                    dd::Package::vEdge&                     localRootEdge,
                                                    std::mt19937_64&                        generator,
                                                    std::uniform_real_distribution<dd::fp>& dist,
                                                    dd::Package::mEdge                      identityDD) {
-    std::vector usedQubits = targets;
-    for (auto control: control_qubits) {
-        usedQubits.push_back(control.qubit);
-    }
-
-    for (auto& target: usedQubits) {
+    for (auto target: usedQubits) {
         auto operation = generateNoiseOperation(false, target, generator, dist, dd_op, localDD);
         auto tmp       = localDD->multiply(operation, localRootEdge);
 
@@ -481,19 +407,3 @@ std::string StochasticNoiseSimulator::intToString(long target_number) const {
     }
     return path;
 }
-void StochasticNoiseSimulator::setMeasuredQubitToZero(dd::Qubit& at, dd::Package::vEdge& e, std::unique_ptr<dd::Package>& localDD) {
-    auto f = dd::Package::mEdge::one;
-
-    for (std::size_t p = 0; p < getNumberOfQubits(); p++) {
-        if (static_cast<dd::Qubit>(p) == at) {
-            f = localDD->makeDDNode(static_cast<dd::Qubit>(p), std::array{f, f, dd::Package::mEdge::zero, dd::Package::mEdge::zero});
-            //                f = dd->makeDDNode(static_cast<dd::Qubit>(p), std::array{f, dd::Package::mEdge::zero, dd::Package::mEdge::zero, dd::Package::mEdge::zero});
-        } else {
-            f = localDD->makeDDNode(static_cast<dd::Qubit>(p), std::array{f, dd::Package::mEdge::zero, dd::Package::mEdge::zero, f});
-        }
-    }
-    auto tmp = localDD->multiply(f, e);
-    localDD->incRef(tmp);
-    localDD->decRef(e);
-    e = tmp;
-}
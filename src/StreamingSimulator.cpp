@@ -0,0 +1,92 @@
+#include "StreamingSimulator.hpp"
+
+#include "QuantumComputation.hpp"
+
+#include <chrono>
+#include <future>
+
+std::map<std::string, std::size_t> StreamingSimulator::Simulate(const unsigned int shots) {
+    if (consumed) {
+        throw std::runtime_error("The operation stream of '" + getName() + "' has already been simulated.");
+    }
+    consumed = true;
+
+    const auto n_qubits = stream->getNqubits();
+    measured.assign(n_qubits, false);
+    root_edge = initial_state.toDD(dd, n_qubits);
+    dd->incRef(root_edge);
+
+    const auto read = [this]() { return stream->nextChunk(chunk_size); };
+    auto       next = std::async(std::launch::async, read);
+    while (true) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto chunk = next.get();
+        wait_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (chunk.empty()) {
+            break;
+        }
+        // read the next chunk while this one is simulated
+        next = std::async(std::launch::async, read);
+        chunks++;
+        for (const auto& op: chunk) {
+            apply(*op);
+            nops++;
+        }
+    }
+    gc_policy.afterOperation(dd, true);
+
+    if (measurements.empty()) {
+        return MeasureAllNonCollapsing(shots);
+    }
+    std::map<std::string, std::size_t> m_counter;
+    const auto                         n_cbits = stream->getNcbits();
+    for (const auto& [outcome, count]: MeasureAllNonCollapsing(shots)) {
+        std::string result_string(n_cbits, '0');
+        for (const auto& [bit, qubit]: measurements) {
+            result_string[n_cbits - bit - 1] = outcome[n_qubits - static_cast<std::size_t>(qubit) - 1];
+        }
+        m_counter[result_string] += count;
+    }
+    return m_counter;
+}
+
+void StreamingSimulator::apply(const qc::Operation& op) {
+    if (op.getType() == qc::Barrier) {
+        return;
+    }
+    if (op.getType() == qc::Measure) {
+        const auto* nu_op = dynamic_cast<const qc::NonUnitaryOperation*>(&op);
+        if (nu_op == nullptr) {
+            throw std::runtime_error("Op with type Measurement could not be casted to NonUnitaryOperation");
+        }
+        const auto& quantum = nu_op->getTargets();
+        const auto& classic = nu_op->getClassics();
+        if (quantum.size() != classic.size()) {
+            throw std::runtime_error("Measurement: Sizes of quantum and classic register mismatch.");
+        }
+        for (std::size_t i = 0; i < quantum.size(); ++i) {
+            measurements[classic.at(i)]                          = quantum.at(i);
+            measured.at(static_cast<std::size_t>(quantum.at(i))) = true;
+        }
+        return;
+    }
+    if (!op.isUnitary() || op.isClassicControlledOperation()) {
+        throw std::runtime_error("Streaming simulation does not support resets and classically controlled operations.");
+    }
+    for (std::size_t q = 0; q < measured.size(); ++q) {
+        if (measured[q] && op.actsOn(static_cast<dd::Qubit>(q))) {
+            throw std::runtime_error("Streaming simulation does not support operations on qubits that have already been measured.");
+        }
+    }
+
+    dd::Package::vEdge tmp{};
+    if (const auto matrix = GateApplicator::getGateMatrix(op)) {
+        tmp = applicator.apply(*matrix, op.getTargets().front(), op.getControls(), root_edge);
+    } else {
+        tmp = dd->multiply(op.getDD(dd), root_edge);
+    }
+    dd->incRef(tmp);
+    dd->decRef(root_edge);
+    root_edge = tmp;
+    gc_policy.afterOperation(dd);
+}
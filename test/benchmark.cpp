@@ -1,6 +1,7 @@
 #include "CircuitSimulator.hpp"
 #include "QuantumComputation.hpp"
 #include "Simulator.hpp"
+#include "StateVectorSimulator.hpp"
 
 // clang format wants to put the following include to the top of the file
 // clang-format off
@@ -250,3 +251,27 @@ static void BM_extra_inst4x4_10_0(benchmark::State& state) {
 }
 
 BENCHMARK(BM_extra_inst4x4_10_0)->ComputeStatistics("min", min_estimator);
+
+static void dense_sim_QCBM(benchmark::State& state) {
+    const dd::QubitCount n_qubits = state.range(0);
+    const std::size_t    depth    = 9;
+    auto                 qc       = std::make_unique<qc::QuantumComputation>(n_qubits);
+    for (std::size_t d = 0; d < depth; d++) {
+        for (dd::Qubit i = 0; i < n_qubits; i++) {
+            qc->emplace_back<qc::StandardOperation>(n_qubits, i, qc::RZ, 1.0);
+            qc->emplace_back<qc::StandardOperation>(n_qubits, i, qc::RX, 1.0);
+            qc->emplace_back<qc::StandardOperation>(n_qubits, i, qc::RZ, 1.0);
+        }
+        for (dd::Qubit i = 0; i < n_qubits; i++) {
+            qc->emplace_back<qc::StandardOperation>(n_qubits, dd::Control{i}, (i + 1) % n_qubits, qc::X);
+        }
+    }
+    StateVectorSimulator sim(std::move(qc), 0, 1);
+    for (auto _: state) {
+        sim.Simulate(1);
+    }
+    state.SetLabel("QCBM (dense, " + DenseState::getSimdExtension() + ")");
+}
+
+// in-tree dense baseline for the QCBM instances above
+BENCHMARK(dense_sim_QCBM)->DenseRange(4, 24, 4)->ComputeStatistics("min", min_estimator);
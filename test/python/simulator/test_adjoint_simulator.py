@@ -0,0 +1,32 @@
+import math
+import unittest
+
+import numpy as np
+from qiskit import QuantumCircuit
+
+from mqt import ddsim
+
+
+class MQTAdjointSimulatorTest(unittest.TestCase):
+    def setUp(self):
+        circ = QuantumCircuit(2)
+        circ.ry(0.4, 0)
+        circ.rx(0.7, 1)
+        circ.cx(0, 1)
+        self.circuit = circ
+
+    def test_gradient(self):
+        sim = ddsim.AdjointCircuitSimulator(self.circuit, seed=42)
+        # Z on qubit 0 commutes with the CNOT, hence <Z_0> = cos(0.4) only depends on the first parameter
+        gradient = sim.gradient({'IZ': 1.0})
+        self.assertIsInstance(gradient, np.ndarray)
+        np.testing.assert_allclose(gradient, [-math.sin(0.4), 0.0], atol=1e-9)
+        self.assertAlmostEqual(sim.get_expectation_value(), math.cos(0.4))
+        self.assertEqual(sim.get_parameterized_operations(), [0, 1])
+
+    def test_set_parameters(self):
+        sim = ddsim.AdjointCircuitSimulator(self.circuit)
+        sim.set_parameters([1.0, 0.7])
+        gradient = sim.gradient([('IZ', 2.0)])
+        np.testing.assert_allclose(gradient, [-2.0 * math.sin(1.0), 0.0], atol=1e-9)
+        self.assertEqual(sim.statistics()['parameters'], '2')
@@ -0,0 +1,36 @@
+import unittest
+
+from qiskit import QuantumCircuit, execute
+
+from mqt import ddsim
+from mqt.ddsim.autosimulator import AutoSimulator
+
+
+class MQTAutoSimulatorTest(unittest.TestCase):
+    def setUp(self):
+        self.backend = AutoSimulator()
+        circ = QuantumCircuit(40)
+        circ.h(0)
+        for i in range(1, 40):
+            circ.cx(i - 1, i)
+        circ.measure_all()
+        circ.name = 'ghz'
+        self.circuit = circ
+
+    def test_auto_simulator_selects_dd_for_wide_circuits(self):
+        shots = 1000
+        result = execute(self.circuit, self.backend, shots=shots, seed=42).result()
+        self.assertEqual(result.success, True)
+        self.assertEqual(result.results[0].engine, 'dd')
+        counts = result.get_counts('ghz')
+        self.assertEqual(len(counts), 2)
+        self.assertIn('0' * 40, counts)
+        self.assertIn('1' * 40, counts)
+
+    def test_standalone_statistics(self):
+        sim = ddsim.AutoCircuitSimulator(self.circuit, seed=42)
+        sim.simulate(shots=10)
+        statistics = sim.statistics()
+        self.assertEqual(statistics['engine'], sim.get_engine())
+        self.assertIn('engine_reason', statistics)
+        self.assertEqual(statistics['predicted_log2_cost_dense'], 'n/a')
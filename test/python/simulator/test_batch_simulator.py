@@ -0,0 +1,32 @@
+import unittest
+
+from qiskit import QuantumCircuit
+
+from mqt import ddsim
+
+
+class MQTBatchSimulatorTest(unittest.TestCase):
+    def setUp(self):
+        circ = QuantumCircuit(2)
+        circ.cx(0, 1)
+        circ.measure_all()
+        self.circuit = circ
+
+    def test_per_input_counts(self):
+        sim = ddsim.BatchCircuitSimulator(self.circuit, seed=42)
+        for state in ['00', '01', '10', '11']:
+            sim.add_input(state)
+        counts = sim.simulate_batch(shots=10)
+        self.assertEqual(counts, [{'00': 10}, {'11': 10}, {'10': 10}, {'01': 10}])
+        self.assertEqual(sim.statistics()['batch_mode'], 'unitary')
+
+    def test_gate_by_gate_amplitudes(self):
+        sim = ddsim.BatchCircuitSimulator(self.circuit, seed=42)
+        sim.add_input('+0')
+        sim.add_input({1: 1.0})
+        sim.set_mode(ddsim.BatchMode.gate_by_gate)
+        sim.simulate_batch(shots=0)
+        self.assertEqual(sim.statistics()['batch_mode'], 'gate_by_gate')
+        self.assertAlmostEqual(abs(sim.get_amplitude(0, '10')), 2 ** -0.5)
+        self.assertAlmostEqual(abs(sim.get_amplitude(1, '11')), 1.0)
+        self.assertEqual(len(sim.get_vector(1)), 4)
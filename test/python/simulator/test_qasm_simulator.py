@@ -59,6 +59,71 @@ class JKQQasmSimulatorTest(unittest.TestCase):
             self.assertIn(key, counts)
             self.assertLess(abs(target[key] - counts[key]), threshold)
 
+    def test_qasm_simulator_reset(self):
+        """Test that reset (mid-circuit) is supported and returns the qubits to |0>."""
+        shots = 1024
+        circuit = QuantumCircuit(2, 2)
+        circuit.h(0)
+        circuit.cx(0, 1)
+        circuit.measure(0, 0)
+        circuit.reset(0)
+        circuit.reset(1)
+        circuit.measure(1, 1)
+        result = execute(circuit, self.backend, shots=shots).result()
+        counts = result.get_counts()
+        self.assertEqual(set(counts.keys()) - {'00', '01'}, set())
+        self.assertEqual(sum(counts.values()), shots)
+
+    def test_qasm_simulator_lightcone(self):
+        """Test that pruning to the lightcone of the measured qubits does not change the counts."""
+        shots = 1024
+        circuit = QuantumCircuit(3, 2)
+        circuit.h(0)
+        circuit.cx(0, 1)
+        circuit.h(2)
+        circuit.t(2)
+        circuit.measure(0, 0)
+        circuit.measure(1, 1)
+        result = execute(circuit, self.backend, shots=shots, lightcone=True).result()
+        counts = result.get_counts()
+        self.assertEqual(set(counts.keys()) - {'00', '11'}, set())
+        self.assertEqual(sum(counts.values()), shots)
+
+    def test_qasm_simulator_garbage_collection(self):
+        """Test that the garbage collection policy does not change the counts."""
+        shots = 1024
+        circuit = QuantumCircuit(2, 2)
+        circuit.h(0)
+        circuit.cx(0, 1)
+        circuit.measure(0, 0)
+        circuit.reset(0)
+        circuit.measure(1, 1)
+        for gc_mode in ['every', 'dead_ratio', 'memory', 'measurements']:
+            result = execute(circuit, self.backend, shots=shots, gc_mode=gc_mode, gc_every=2, gc_threshold=0.1).result()
+            counts = result.get_counts()
+            self.assertEqual(set(counts.keys()) - {'00', '11'}, set())
+            self.assertEqual(sum(counts.values()), shots)
+
+    def test_qasm_simulator_initial_state(self):
+        """Test that the simulation starts from the given basis state or amplitudes."""
+        shots = 1024
+        circuit = QuantumCircuit(2, 2)
+        circuit.cx(0, 1)
+        circuit.measure(0, 0)
+        circuit.measure(1, 1)
+        result = execute(circuit, self.backend, shots=shots, initial_state='01').result()
+        self.assertEqual(result.get_counts(), {'11': shots})
+
+        result = execute(circuit, self.backend, shots=shots, initial_state=[0, 1, 0, 0]).result()
+        self.assertEqual(result.get_counts(), {'11': shots})
+
+    def test_qasm_simulator_deadline(self):
+        """Test that a generous deadline does not approximate and is reported."""
+        shots = 1024
+        result = execute(self.circuit, self.backend, shots=shots, deadline=1000).result()
+        self.assertEqual(result.results[0].final_fidelity, 1.0)
+        self.assertFalse(result.results[0].deadline_forced_approximation)
+
     def test_basicaer_simulator(self):
         """Test data counts output for single circuit run against reference."""
         shots = 1024
@@ -29,3 +29,33 @@ class JKQStandaloneSimulatorTests(unittest.TestCase):
         self.assertEqual(len(result.keys()), 2)
         self.assertIn('000', result.keys())
         self.assertIn('111', result.keys())
+
+    def test_standalone_expectation_value(self):
+        circ = QuantumCircuit(3)
+        circ.h(0)
+        circ.cx(0, 1)
+        circ.cx(0, 2)
+
+        sim = ddsim.CircuitSimulator(circ, 1337)
+        sim.simulate(1)
+        self.assertAlmostEqual(sim.expectation_value({'ZZI': 1.0, 'XXX': 0.5, 'IIZ': 2.0}), 1.5)
+        self.assertAlmostEqual(sim.expectation_value([('YYX', 1.0), ('ZII', 3.0)], nthreads=2), -1.0)
+
+    def test_standalone_cost_expectation(self):
+        circ = QuantumCircuit(2)
+        circ.h(0)
+        circ.cx(0, 1)
+
+        # MaxCut on a single edge: cost -1 for the cut outcomes 01 and 10, which are never measured
+        cost = ddsim.DiagonalCost.from_ising(2, [], {(0, 1): 0.5}, -0.5)
+        self.assertAlmostEqual(cost.evaluate('01'), -1.0)
+        sim = ddsim.CircuitSimulator(circ, 1337)
+        sim.simulate(1)
+        self.assertAlmostEqual(sim.cost_expectation(cost), 0.0)
+
+        qubo = ddsim.DiagonalCost.from_qubo(2, {(0, 0): -1.0, (0, 1): 3.0})
+        self.assertAlmostEqual(sim.cost_expectation(qubo), 1.0)
+        cvar = sim.cost_cvar(qubo, 0.5)
+        self.assertAlmostEqual(cvar.value, 0.0)
+        self.assertAlmostEqual(cvar.covered_probability, 1.0)
+        self.assertEqual(cvar.outcomes, 2)
@@ -0,0 +1,114 @@
+#include "AdjointSimulator.hpp"
+#include "CircuitSimulator.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace dd::literals;
+
+static std::unique_ptr<qc::QuantumComputation> makeCircuit(const std::vector<dd::fp>& theta) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::RX, theta.at(0));
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::RY, theta.at(1));
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0_pc, 2, qc::RZ, theta.at(2));
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1_pc, 0, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2, qc::Phase, theta.at(3));
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Controls{0_pc, 2_nc}, 1, qc::RY, theta.at(4));
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::RX, theta.at(5));
+    return quantumComputation;
+}
+
+static const std::vector<PauliTerm> OBSERVABLE{{1., "ZZI"}, {0.5, "XIY"}, {-0.3, "IYX"}, {0.7, "ZXZ"}, {0.2, "III"}};
+
+static dd::fp expectation(const std::vector<dd::fp>& theta) {
+    CircuitSimulator ddsim(makeCircuit(theta));
+    ddsim.Simulate(1);
+    return ddsim.expectationValue(OBSERVABLE);
+}
+
+TEST(AdjointSimTest, GradientMatchesFiniteDifferences) {
+    const std::vector<dd::fp> theta{0.3, -1.2, 0.8, 2.1, 0.5, -0.4};
+
+    AdjointSimulator ddsim(makeCircuit(theta));
+    const auto       gradient = ddsim.gradient(OBSERVABLE);
+    ASSERT_EQ(gradient.size(), theta.size());
+    EXPECT_EQ(ddsim.getParameterizedOperations(), (std::vector<std::size_t>{0, 1, 3, 5, 6, 7}));
+    EXPECT_NEAR(ddsim.getExpectationValue(), expectation(theta), 1e-9);
+    EXPECT_NEAR(ddsim.expectationValue(OBSERVABLE), expectation(theta), 1e-9);
+    EXPECT_EQ(ddsim.AdditionalStatistics().at("parameters"), "6");
+
+    constexpr dd::fp h = 1e-4;
+    for (std::size_t i = 0; i < theta.size(); ++i) {
+        auto plus  = theta;
+        auto minus = theta;
+        plus.at(i) += h;
+        minus.at(i) -= h;
+        EXPECT_NEAR(gradient.at(i), (expectation(plus) - expectation(minus)) / (2. * h), 1e-6) << "parameter " << i;
+    }
+}
+
+TEST(AdjointSimTest, ParametersCanBeUpdated) {
+    const std::vector<dd::fp> theta{0.3, -1.2, 0.8, 2.1, 0.5, -0.4};
+    const std::vector<dd::fp> other{1.1, 0.2, -0.6, 0.4, 1.5, 0.9};
+
+    AdjointSimulator ddsim(makeCircuit(theta));
+    static_cast<void>(ddsim.gradient(OBSERVABLE));
+    ddsim.setParameters(other);
+    const auto gradient = ddsim.gradient(OBSERVABLE);
+    EXPECT_NEAR(ddsim.getExpectationValue(), expectation(other), 1e-9);
+
+    AdjointSimulator fresh(makeCircuit(other));
+    const auto       expected = fresh.gradient(OBSERVABLE);
+    for (std::size_t i = 0; i < other.size(); ++i) {
+        EXPECT_NEAR(gradient.at(i), expected.at(i), 1e-9);
+    }
+
+    EXPECT_THROW(ddsim.setParameters({1.}), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(ddsim.gradient({{1., "ZZ"}})), std::runtime_error);
+}
+
+TEST(AdjointSimTest, GradientOfMultiParameterGates) {
+    const auto makeGates = [](const std::vector<dd::fp>& p) {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::U3, p.at(0), p.at(1), p.at(2));
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::RY, p.at(3));
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 1_pc, 2, qc::U2, p.at(4), p.at(5));
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 2_pc, 0, qc::U3, p.at(6), p.at(7), p.at(8));
+        return quantumComputation;
+    };
+    const auto expectationOf = [&](const std::vector<dd::fp>& p) {
+        CircuitSimulator ddsim(makeGates(p));
+        ddsim.Simulate(1);
+        return ddsim.expectationValue(OBSERVABLE);
+    };
+    const std::vector<dd::fp> p{0.3, -1.2, 0.8, 2.1, 0.5, -0.4, 1.3, 0.7, -0.9};
+
+    AdjointSimulator ddsim(makeGates(p));
+    const auto       gradient = ddsim.gradient(OBSERVABLE);
+    ASSERT_EQ(gradient.size(), p.size());
+    EXPECT_EQ(ddsim.getParameterizedOperations(), (std::vector<std::size_t>{0, 0, 0, 1, 2, 2, 3, 3, 3}));
+
+    constexpr dd::fp h = 1e-4;
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        auto plus  = p;
+        auto minus = p;
+        plus.at(i) += h;
+        minus.at(i) -= h;
+        EXPECT_NEAR(gradient.at(i), (expectationOf(plus) - expectationOf(minus)) / (2. * h), 1e-6) << "parameter " << i;
+    }
+
+    // the values are assigned in the order of the gradient
+    const std::vector<dd::fp> other{1.1, 0.2, -0.6, 0.4, 1.5, 0.9, -0.3, 0.8, 0.1};
+    ddsim.setParameters(other);
+    static_cast<void>(ddsim.gradient(OBSERVABLE));
+    EXPECT_NEAR(ddsim.getExpectationValue(), expectationOf(other), 1e-9);
+}
+
+TEST(AdjointSimTest, UnsupportedOperations) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(1);
+    quantumComputation->emplace_back<qc::StandardOperation>(1, 0, qc::RX, 0.3);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(1, 0, 0);
+    AdjointSimulator ddsim(std::move(quantumComputation));
+    EXPECT_THROW(static_cast<void>(ddsim.gradient({{1., "Z"}})), std::runtime_error);
+}
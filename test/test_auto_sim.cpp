@@ -0,0 +1,151 @@
+#include "AutoSimulator.hpp"
+#include "CircuitSimulator.hpp"
+#include "EngineSelector.hpp"
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <memory>
+
+static std::unique_ptr<qc::QuantumComputation> makeGHZ(dd::QubitCount n) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(n);
+    quantumComputation->emplace_back<qc::StandardOperation>(n, 0, qc::H);
+    for (dd::Qubit q = 1; q < static_cast<dd::Qubit>(n); ++q) {
+        quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Control{static_cast<dd::Qubit>(q - 1)}, q, qc::X);
+    }
+    return quantumComputation;
+}
+
+/// layers of rotations followed by a ring of CNOTs, which crosses every cut of the register twice
+static std::unique_ptr<qc::QuantumComputation> makeUnstructured(dd::QubitCount n) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(n);
+    for (std::size_t layer = 0; layer < 4; ++layer) {
+        for (dd::Qubit q = 0; q < static_cast<dd::Qubit>(n); ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(n, q, qc::RY, 0.4 + q + layer);
+            quantumComputation->emplace_back<qc::StandardOperation>(n, q, qc::RZ, 1.3 * q + layer);
+        }
+        for (dd::Qubit q = 0; q < static_cast<dd::Qubit>(n); ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Control{q}, static_cast<dd::Qubit>((q + 1) % n), qc::X);
+        }
+    }
+    return quantumComputation;
+}
+
+TEST(AutoSimTest, FeaturesOfGHZ) {
+    auto quantumComputation = makeGHZ(6);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(6, std::vector<dd::Qubit>{0, 1, 2, 3, 4, 5}, std::vector<std::size_t>{0, 1, 2, 3, 4, 5});
+    const auto features = EngineSelector::analyze(*quantumComputation);
+
+    EXPECT_EQ(features.nqubits, 6);
+    EXPECT_EQ(features.ngates, 6);
+    EXPECT_EQ(features.depth, 6);
+    EXPECT_NEAR(features.two_qubit_fraction, 5. / 6., 1e-12);
+    EXPECT_NEAR(features.clifford_fraction, 1., 1e-12);
+    EXPECT_EQ(features.clifford_prefix, 6);
+    EXPECT_EQ(features.measurements, EngineSelector::MeasurementStructure::Final);
+    EXPECT_EQ(features.decisions, 1);
+    EXPECT_EQ(features.max_decisions, 1);
+    EXPECT_EQ(features.cut_decisions.size(), 3);
+}
+
+TEST(AutoSimTest, DecisionsAtSeveralSplits) {
+    qc::QuantumComputation quantumComputation(4);
+    quantumComputation.emplace_back<qc::StandardOperation>(4, dd::Control{0}, 3, qc::X);
+    quantumComputation.emplace_back<qc::StandardOperation>(4, dd::Control{0}, 1, qc::X);
+    quantumComputation.emplace_back<qc::StandardOperation>(4, dd::Control{0}, 1, qc::Z);
+    quantumComputation.emplace_back<qc::StandardOperation>(4, dd::Control{2}, 3, qc::X);
+
+    const auto decisions = EngineSelector::countDecisions(quantumComputation, {0, 1, 2, 3}, {1, 2, 3});
+    EXPECT_EQ(decisions.at(1), 3);
+    EXPECT_EQ(decisions.at(2), 1);
+    EXPECT_EQ(decisions.at(3), 2);
+
+    // swapping the levels of qubits 1 and 3 moves the two gates on qubits 0 and 1 across the middle
+    const auto swapped = EngineSelector::countDecisions(quantumComputation, {0, 3, 2, 1}, {1, 2, 3});
+    EXPECT_EQ(swapped.at(1), 3);
+    EXPECT_EQ(swapped.at(2), 3);
+    EXPECT_EQ(swapped.at(3), 2);
+}
+
+TEST(AutoSimTest, MidCircuitMeasurementsExcludeHybridAndPath) {
+    auto quantumComputation = makeGHZ(4);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{0}, std::vector<std::size_t>{0});
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    const auto features = EngineSelector::analyze(*quantumComputation);
+    EXPECT_EQ(features.measurements, EngineSelector::MeasurementStructure::MidCircuit);
+
+    const auto prediction = EngineSelector::predict(features);
+    EXPECT_TRUE(std::isinf(prediction.log_costs.at(EngineSelector::Engine::Hybrid)));
+    EXPECT_TRUE(std::isinf(prediction.log_costs.at(EngineSelector::Engine::Path)));
+    EXPECT_TRUE(std::isinf(prediction.log_costs.at(EngineSelector::Engine::Unitary)));
+}
+
+TEST(AutoSimTest, SelectsDDForWideStructuredCircuits) {
+    AutoSimulator ddsim(makeGHZ(60), 42);
+    EXPECT_EQ(ddsim.getPrediction().engine, EngineSelector::Engine::DD);
+
+    const auto m = ddsim.Simulate(1000);
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_NEAR(m.at(std::string(60, '0')), 500, 100);
+    EXPECT_NEAR(m.at(std::string(60, '1')), 500, 100);
+
+    const auto statistics = ddsim.AdditionalStatistics();
+    EXPECT_EQ(statistics.at("engine"), "dd");
+    EXPECT_EQ(statistics.at("predicted_log2_cost_dense"), "n/a");
+    EXPECT_FALSE(statistics.at("engine_reason").empty());
+}
+
+TEST(AutoSimTest, SelectsDenseForUnstructuredCircuits) {
+    const dd::QubitCount n = 12;
+    AutoSimulator        ddsim(makeUnstructured(n), 42);
+    EXPECT_EQ(ddsim.getPrediction().engine, EngineSelector::Engine::Dense);
+    ddsim.Simulate(1);
+
+    CircuitSimulator reference(makeUnstructured(n), 42);
+    reference.Simulate(1);
+
+    expectSameState(ddsim, reference);
+}
+
+TEST(AutoSimTest, EnginesReturnClassicalBits) {
+    for (const auto engine: {EngineSelector::Engine::DD, EngineSelector::Engine::Dense, EngineSelector::Engine::Hybrid, EngineSelector::Engine::Path}) {
+        auto quantumComputation = makeGHZ(4);
+        quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{0, 2}, std::vector<std::size_t>{1, 0});
+        AutoSimulator ddsim(std::move(quantumComputation), 42);
+        ddsim.setEngine(engine);
+        EXPECT_EQ(ddsim.getPrediction().engine, engine);
+
+        const auto m = ddsim.Simulate(1000);
+        ASSERT_EQ(m.size(), 2) << EngineSelector::toString(engine);
+        EXPECT_EQ(m.count("0000"), 1) << EngineSelector::toString(engine);
+        EXPECT_EQ(m.count("0011"), 1) << EngineSelector::toString(engine);
+    }
+    EXPECT_THROW(AutoSimulator(makeGHZ(2)).setEngine(EngineSelector::Engine::Unitary), std::runtime_error);
+}
+
+TEST(AutoSimTest, PathEngineUsesSeed) {
+    AutoSimulator first(makeUnstructured(6), 1337);
+    first.setEngine(EngineSelector::Engine::Path);
+    AutoSimulator second(makeUnstructured(6), 1337);
+    second.setEngine(EngineSelector::Engine::Path);
+    EXPECT_EQ(first.Simulate(1000), second.Simulate(1000));
+}
+
+TEST(AutoSimTest, InitialStateExcludesHybridAndPath) {
+    const auto state = InitialState::fromBasisString("1+0-");
+    for (const auto engine: {EngineSelector::Engine::Hybrid, EngineSelector::Engine::Path}) {
+        AutoSimulator ddsim(makeUnstructured(4), 42);
+        ddsim.setEngine(engine);
+        ddsim.setInitialState(state);
+        EXPECT_NE(ddsim.getPrediction().engine, EngineSelector::Engine::Hybrid);
+        EXPECT_NE(ddsim.getPrediction().engine, EngineSelector::Engine::Path);
+        EXPECT_THROW(ddsim.setEngine(engine), std::runtime_error);
+        ddsim.Simulate(1);
+
+        CircuitSimulator reference(makeUnstructured(4), 42);
+        reference.setInitialState(state);
+        reference.Simulate(1);
+        expectSameState(ddsim, reference);
+    }
+}
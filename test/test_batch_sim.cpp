@@ -0,0 +1,111 @@
+#include "BatchSimulator.hpp"
+#include "CircuitSimulator.hpp"
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace dd::literals;
+
+static std::unique_ptr<qc::QuantumComputation> makeCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0_pc, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2, qc::RY, 0.3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1_pc, 2, qc::T);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Controls{0_pc, 2_nc}, 1, qc::X);
+    return quantumComputation;
+}
+
+/// basis state x with qubit 2 first
+static std::string toBasisState(const std::size_t x) {
+    const auto bits = Simulator::toBinaryString(x, 3);
+    return {bits.rbegin(), bits.rend()};
+}
+
+static std::vector<InitialState> makeInputs() {
+    return {InitialState{}, InitialState::fromBasisString("101"), InitialState::fromBasisString("+-r"), InitialState::fromAmplitudes({0.5, 0, 0.5, 0, 0, 0.5, 0, 0.5})};
+}
+
+TEST(BatchSimTest, ModesMatchIndividualSimulations) {
+    const auto inputs = makeInputs();
+    for (const auto mode: {BatchSimulator::Mode::GateByGate, BatchSimulator::Mode::Unitary, BatchSimulator::Mode::Auto}) {
+        BatchSimulator batch(makeCircuit(), inputs, 1);
+        batch.setMode(mode);
+        const auto counts = batch.SimulateBatch(100);
+        ASSERT_EQ(counts.size(), inputs.size());
+        EXPECT_EQ(batch.usedUnitary(), mode != BatchSimulator::Mode::GateByGate);
+
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            CircuitSimulator reference(makeCircuit(), inputs.at(i), 1);
+            reference.Simulate(1);
+            const auto expected = reference.getVectorComplex();
+            for (std::size_t x = 0; x < expected.size(); ++x) {
+                EXPECT_NEAR(std::abs(batch.getAmplitude(i, toBasisState(x)) - expected.at(x)), 0., 1e-10);
+            }
+            batch.selectInput(i);
+            expectSameState(batch, reference);
+
+            std::size_t shots = 0;
+            for (const auto& [outcome, count]: counts.at(i)) {
+                EXPECT_GT(std::norm(expected.at(std::stoul(outcome, nullptr, 2))), 1e-10);
+                shots += count;
+            }
+            EXPECT_EQ(shots, 100);
+        }
+    }
+}
+
+TEST(BatchSimTest, ReversibleCircuitUsesUnitaryAndMapsMeasurements) {
+    // x1 ^= x0 and x2 ^= x0 & x1, measured into the reversed classical register
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0_pc, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Controls{0_pc, 1_pc}, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0, 1, 2}, std::vector<std::size_t>{2, 1, 0});
+
+    BatchSimulator batch(std::move(quantumComputation), 1);
+    // the circuit exceeds the qubit limit, but only consists of reversible gates
+    batch.setUnitaryLimits(2, 1U << 16U);
+    for (std::size_t x = 0; x < 8; ++x) {
+        batch.addInput(InitialState::fromBasisString(toBasisState(x)));
+    }
+    const auto counts = batch.SimulateBatch(10);
+    EXPECT_TRUE(batch.usedUnitary());
+    EXPECT_EQ(batch.AdditionalStatistics().at("batch_mode"), "unitary");
+
+    for (std::size_t x = 0; x < 8; ++x) {
+        auto output = x;
+        output ^= (output & 1U) << 1U;
+        output ^= ((output & 1U) & ((output >> 1U) & 1U)) << 2U;
+        // classical bit c holds qubit 2 - c, so the result string (bit 2 first) lists qubits 0, 1, 2
+        const std::string expected{(output & 1U) ? '1' : '0', (output & 2U) ? '1' : '0', (output & 4U) ? '1' : '0'};
+        ASSERT_EQ(counts.at(x).size(), 1);
+        EXPECT_EQ(counts.at(x).begin()->first, expected);
+        EXPECT_EQ(counts.at(x).begin()->second, 10);
+    }
+}
+
+TEST(BatchSimTest, AbortsUnitaryExceedingNodeLimit) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0_pc, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Controls{0_pc, 1_pc}, 2, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2_pc, 0, qc::X);
+
+    BatchSimulator batch(std::move(quantumComputation), makeInputs(), 1);
+    batch.setUnitaryLimits(2, 1);
+    batch.SimulateBatch(0);
+    EXPECT_FALSE(batch.usedUnitary());
+    // the construction stops at the first gate whose unitary exceeds the limit
+    EXPECT_EQ(batch.AdditionalStatistics().at("unitary_construction_ops"), "1");
+    EXPECT_EQ(batch.AdditionalStatistics().at("batch_mode"), "gate_by_gate");
+}
+
+TEST(BatchSimTest, RejectsInvalidCircuitsAndInputs) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, std::vector<dd::Qubit>{0}, std::vector<std::size_t>{0});
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::X);
+    BatchSimulator batch(std::move(quantumComputation), {InitialState{}}, 1);
+    EXPECT_THROW(batch.SimulateBatch(1), std::runtime_error);
+    EXPECT_THROW(batch.addInput(InitialState::fromBasisString("011")), std::runtime_error);
+    EXPECT_THROW(batch.selectInput(0), std::runtime_error);
+}
@@ -1,8 +1,25 @@
 #include "CircuitSimulator.hpp"
+#include "DiagonalCost.hpp"
+#include "DynamicReordering.hpp"
+#include "EmulatedOperations.hpp"
+#include "GateApplicator.hpp"
+#include "PauliExpectation.hpp"
+#include "PermutationEmulator.hpp"
+#include "PrefixCache.hpp"
+#include "QubitOrdering.hpp"
+#include "RegisterCompaction.hpp"
+#include "StabilizerTableau.hpp"
 #include "algorithms/Grover.hpp"
+#include "test_utils.hpp"
 
+#include <algorithm>
+#include <complex>
+#include <functional>
 #include <gtest/gtest.h>
 #include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
 
 TEST(CircuitSimTest, SingleOneQubitGateOnTwoQubitCircuit) {
     auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
@@ -99,6 +116,886 @@ TEST(CircuitSimTest, ClassicControlledOpAsNop) {
     ASSERT_EQ("01", m);
 }
 
+TEST(CircuitSimTest, ClassicControlledOpOnRegisterMultiShot) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::H);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0, 1}, std::vector<std::size_t>{0, 1});
+    std::unique_ptr<qc::Operation> op(new qc::StandardOperation(3, 2, qc::X));
+    quantumComputation->emplace_back<qc::ClassicControlledOperation>(op, std::pair<dd::Qubit, dd::QubitCount>{0, 2}, 3);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, 2, 2);
+
+    CircuitSimulator ddsim(std::move(quantumComputation), ApproximationInfo(), 1337);
+    auto             m = ddsim.Simulate(100);
+
+    ASSERT_EQ("100", ddsim.AdditionalStatistics().at("single_shots"));
+    for (const auto& [bits, count]: m) {
+        // the third bit is set iff both of the first two bits are set
+        EXPECT_EQ(bits[0], bits[1]);
+        EXPECT_EQ(bits[2], '1');
+    }
+}
+
+TEST(CircuitSimTest, ExecutionPlanLowering) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, std::vector<dd::Qubit>{0, 1}, qc::Barrier);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 0, 1);
+    std::unique_ptr<qc::Operation> op(new qc::StandardOperation(2, 1, qc::X));
+    quantumComputation->emplace_back<qc::ClassicControlledOperation>(op, std::pair<dd::Qubit, dd::QubitCount>{1, 1}, 1);
+
+    auto                dd = std::make_unique<dd::Package>(2);
+    const ExecutionPlan plan(*quantumComputation, dd);
+
+    ASSERT_EQ(plan.size(), 4); // the barrier is dropped
+    EXPECT_EQ(plan.at(0).kind, ExecutionPlan::Kind::Gate);
+    EXPECT_EQ(plan.at(1).qubits, (std::vector<dd::Qubit>{1, 0}));
+    EXPECT_EQ(plan.at(2).kind, ExecutionPlan::Kind::Measure);
+    EXPECT_EQ(plan.at(2).classics, (std::vector<std::size_t>{1}));
+    ASSERT_TRUE(plan.at(3).isConditional());
+    EXPECT_EQ(plan.at(3).condition.at(0).mask, 0b10U);
+    EXPECT_EQ(plan.at(3).condition.at(0).expected, 0b10U);
+
+    auto bits = plan.makeClassicalBits();
+    EXPECT_FALSE(ExecutionPlan::conditionHolds(plan.at(3), bits));
+    ExecutionPlan::setBit(bits, 1, true);
+    EXPECT_TRUE(ExecutionPlan::conditionHolds(plan.at(3), bits));
+}
+
+TEST(CircuitSimTest, GateApplicatorMatchesMultiply) {
+    auto           dd = std::make_unique<dd::Package>(4);
+    GateApplicator applicator(dd);
+
+    // some entangled state with non-trivial phases
+    auto state = dd->makeZeroState(4);
+    dd->incRef(state);
+    for (dd::Qubit q = 0; q < 4; ++q) {
+        state = dd->multiply(dd->makeGateDD(dd::Hmat, 4, q), state);
+    }
+    state = dd->multiply(dd->makeGateDD(dd::Tmat, 4, dd::Control{3}, 1), state);
+    state = dd->multiply(dd->makeGateDD(dd::RYmat(0.3), 4, 2), state);
+    dd->incRef(state);
+
+    const std::vector<std::pair<dd::Qubit, dd::Controls>> configurations{
+            {0, {}},
+            {3, {}},
+            {1, {dd::Control{3}}},
+            {2, {dd::Control{0}}},
+            {2, {dd::Control{0, dd::Control::Type::neg}, dd::Control{3}}},
+            {1, {dd::Control{0}, dd::Control{2, dd::Control::Type::neg}}},
+    };
+    for (const auto& mat: {dd::Hmat, dd::Xmat, dd::Ymat, dd::U3mat(0.1, 0.2, 0.3)}) {
+        for (const auto& [target, controls]: configurations) {
+            expectSameState(dd->getVector(applicator.apply(mat, target, controls, state)), dd->getVector(dd->multiply(dd->makeGateDD(mat, 4, controls, target), state)));
+        }
+    }
+}
+
+TEST(CircuitSimTest, GateApplicatorMatchesOperationDD) {
+    auto           dd = std::make_unique<dd::Package>(3);
+    GateApplicator applicator(dd);
+
+    auto state = dd->makeZeroState(3);
+    for (dd::Qubit q = 0; q < 3; ++q) {
+        state = dd->multiply(dd->makeGateDD(dd::RYmat(0.4 + q), 3, q), state);
+    }
+    state = dd->multiply(dd->makeGateDD(dd::Tmat, 3, dd::Control{0}, 2), state);
+    dd->incRef(state);
+
+    // distinct parameters, so that a mix-up of their order changes the result
+    std::vector<std::unique_ptr<qc::Operation>> ops{};
+    ops.emplace_back(std::make_unique<qc::StandardOperation>(3, 0, qc::U3, 0.1, 0.7, 1.3));
+    ops.emplace_back(std::make_unique<qc::StandardOperation>(3, dd::Controls{dd::Control{2}}, 1, qc::U3, -0.4, 2.1, 0.6));
+    ops.emplace_back(std::make_unique<qc::StandardOperation>(3, 2, qc::U2, 0.3, -1.1));
+    ops.emplace_back(std::make_unique<qc::StandardOperation>(3, dd::Controls{dd::Control{0, dd::Control::Type::neg}}, 1, qc::U2, 1.9, 0.2));
+    for (const auto& op: ops) {
+        const auto matrix = GateApplicator::getGateMatrix(*op);
+        ASSERT_TRUE(matrix.has_value());
+        SCOPED_TRACE(op->getName());
+        expectSameState(dd->getVector(applicator.apply(*matrix, op->getTargets().front(), op->getControls(), state)), dd->getVector(dd->multiply(op->getDD(dd), state)));
+    }
+}
+
+TEST(CircuitSimTest, MeasureRegisterJointly) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{1}, 0, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{1}, 2, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{2, 0}, std::vector<std::size_t>{0, 1});
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::H);
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+
+    const auto m = ddsim.Simulate(100);
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_TRUE(m.count("010") > 0);
+    EXPECT_TRUE(m.count("001") > 0);
+}
+
+TEST(CircuitSimTest, ResetCollapsesToZero) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, std::vector<dd::Qubit>{0}, qc::Reset);
+    CircuitSimulator ddsim(std::move(quantumComputation), 1337);
+
+    for (int i = 0; i < 10; ++i) {
+        ddsim.Simulate(1);
+        const auto v = ddsim.getVector();
+        // the first qubit is always |0>, the second one is entangled with the sampled value
+        EXPECT_NEAR(std::norm(std::complex<dd::fp>{v[0].r, v[0].i}) + std::norm(std::complex<dd::fp>{v[2].r, v[2].i}), 1., 1e-10);
+    }
+}
+
+TEST(CircuitSimTest, ResetKernelMovesBranch) {
+    CircuitSimulator ddsim(std::make_unique<qc::QuantumComputation>(2), 1);
+    ddsim.root_edge = ddsim.dd->makeBasisState(2, {dd::BasisStates::one, dd::BasisStates::plus});
+    ddsim.dd->incRef(ddsim.root_edge);
+
+    ddsim.ResetQubits({0});
+    const auto v = ddsim.getVector();
+    EXPECT_NEAR(v[0].r, dd::SQRT2_2, 1e-10);
+    EXPECT_NEAR(v[2].r, dd::SQRT2_2, 1e-10);
+    EXPECT_NEAR(v[1].r, 0., 1e-10);
+    EXPECT_NEAR(v[3].r, 0., 1e-10);
+}
+
+TEST(CircuitSimTest, PostSelectionOnRareHerald) {
+    const dd::fp theta              = 2 * std::asin(0.01); // heralding probability of 10^-4
+    auto         quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::RY, theta);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 0, 0);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 1, 1);
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+    ddsim.setPostSelection({{0, true}});
+
+    const auto m = ddsim.Simulate(1000);
+    ASSERT_EQ(m.size(), 1);
+    EXPECT_EQ(m.at("11"), 1000);
+    EXPECT_NEAR(ddsim.getPostSelectionProbability(), 1e-4, 1e-12);
+    EXPECT_EQ("1", ddsim.AdditionalStatistics().at("single_shots"));
+
+    // the probability only refers to the last simulation
+    ddsim.setPostSelection({{0, false}});
+    const auto complement = ddsim.Simulate(1000);
+    EXPECT_EQ(complement.at("00"), 1000);
+    EXPECT_NEAR(ddsim.getPostSelectionProbability(), 1. - 1e-4, 1e-12);
+}
+
+TEST(CircuitSimTest, PostSelectKernel) {
+    CircuitSimulator ddsim(std::make_unique<qc::QuantumComputation>(2), 1);
+    ddsim.root_edge = ddsim.dd->makeBasisState(2, {dd::BasisStates::plus, dd::BasisStates::plus});
+    ddsim.dd->incRef(ddsim.root_edge);
+
+    EXPECT_NEAR(ddsim.PostSelect({1}, {true}), 0.5, 1e-10);
+    const auto v = ddsim.getVector();
+    EXPECT_NEAR(v[2].r, dd::SQRT2_2, 1e-10);
+    EXPECT_NEAR(v[3].r, dd::SQRT2_2, 1e-10);
+
+    EXPECT_NEAR(ddsim.PostSelect({0, 1}, {false, true}), 0.5, 1e-10);
+    EXPECT_EQ(ddsim.MeasureAll(false), "10");
+    EXPECT_THROW(ddsim.PostSelect({0}, {true}), std::runtime_error);
+}
+
+TEST(CircuitSimTest, LightconePruning) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{2}, 3, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, 1, 0);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{2}, qc::Reset);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{1}, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, 2, 1);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::X);
+
+    // the gates on qubits 2 and 3 precede the reset and the final X on qubit 0 follows the last measurement
+    const std::vector<bool> expected{true, true, false, false, true, true, true, true, false};
+    EXPECT_EQ(LightconePass::analyze(*quantumComputation), expected);
+
+    CircuitSimulator ddsim(std::move(quantumComputation), 1);
+    EXPECT_EQ(ddsim.pruneToLightcone(), 3);
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("lightcone_removed_ops"));
+
+    const auto m = ddsim.Simulate(1000);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_GT(m.at("0000"), 0);
+    EXPECT_GT(m.at("0011"), 0);
+}
+
+TEST(CircuitSimTest, LightconeKeepsUnmeasuredCircuits) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 1, qc::H);
+    EXPECT_EQ(LightconePass::apply(*quantumComputation), 0);
+    EXPECT_EQ(quantumComputation->getNops(), 2);
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeIdleQubitCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(5);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{1}, 3, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 3, qc::T);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(5, std::vector<dd::Qubit>{0, 1, 2, 3, 4}, qc::Barrier);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, IdleQubitElimination) {
+    RegisterCompaction compaction(*makeIdleQubitCircuit());
+    EXPECT_EQ(compaction.getNactive(), 2);
+    EXPECT_EQ(compaction.getNidle(), 3);
+    EXPECT_EQ(compaction.original(1), 3);
+    EXPECT_EQ(compaction.compact(*makeIdleQubitCircuit())->getNqubits(), 2);
+
+    // resets only initialize qubits to |0>
+    auto withReset = makeIdleQubitCircuit();
+    withReset->emplace_back<qc::NonUnitaryOperation>(5, std::vector<dd::Qubit>{0, 4}, qc::Reset);
+    EXPECT_EQ(RegisterCompaction(*withReset).getNidle(), 3);
+
+    CircuitSimulator ddsim(makeIdleQubitCircuit(), 1);
+    ddsim.setIdleQubitElimination(true);
+    const auto m = ddsim.Simulate(1000);
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("idle_qubits"));
+
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_GT(m.at("00000"), 0);
+    EXPECT_GT(m.at("01010"), 0);
+    EXPECT_EQ(ddsim.getVector().size(), 32);
+
+    // with an intermediate measurement, the state is kept (and expanded) after the last shot only
+    auto withMeasurement = makeIdleQubitCircuit();
+    withMeasurement->emplace_back<qc::NonUnitaryOperation>(5, 1, 1);
+    withMeasurement->emplace_back<qc::StandardOperation>(5, 3, qc::H);
+    CircuitSimulator measured(std::move(withMeasurement), 1);
+    measured.setIdleQubitElimination(true);
+    measured.Simulate(10);
+    EXPECT_EQ("10", measured.AdditionalStatistics().at("single_shots"));
+    EXPECT_EQ(measured.getVector().size(), 32);
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeFactorizableCircuit(bool swap) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(5);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{0}, 2, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 1, qc::RY, 0.3);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{1, dd::Control::Type::neg}, 3, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 3, qc::T);
+    if (swap) {
+        quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Controls{}, 2, 3, qc::SWAP);
+    }
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, FactorizedSimulationTracksComponents) {
+    // the SWAP merges the components {0, 2} and {1, 3}
+    for (const bool swap: {false, true}) {
+        CircuitSimulator ddsim(makeFactorizableCircuit(swap), 1);
+        ddsim.setFactorization(true);
+        ddsim.Simulate(1);
+        EXPECT_EQ(swap ? "4" : "2", ddsim.AdditionalStatistics().at("largest_component"));
+    }
+}
+
+TEST(CircuitSimTest, FactorizedSimulationWithMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Controls{}, 0, 1, qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{0}, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0, 1, 2}, std::vector<std::size_t>{0, 1, 2});
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0}, qc::Reset);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::X);
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+    ddsim.setFactorization(true);
+
+    const auto m = ddsim.Simulate(100);
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_GT(m.at("000"), 0);
+    EXPECT_GT(m.at("101"), 0);
+    // the SWAP is built for the component layout once and reused by the other shots
+    EXPECT_EQ("99", ddsim.AdditionalStatistics().at("factorized_gate_cache_hits"));
+    // qubit 0 has been reset and qubit 1 flipped afterwards
+    const auto final = ddsim.MeasureAll(false);
+    EXPECT_EQ(final.substr(1), "10");
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeReorderableCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::RY, 0.7);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{0}, 3, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{1}, 2, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{3}, 0, qc::RX, 0.2);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::T);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, QubitReorderingKeepsResults) {
+    const auto levels = QubitOrdering::compute(*makeReorderableCircuit());
+    EXPECT_EQ(std::abs(levels.at(0) - levels.at(3)), 1);
+    EXPECT_EQ(std::abs(levels.at(1) - levels.at(2)), 1);
+    const auto weights = QubitOrdering::interactionWeights(*makeReorderableCircuit());
+    EXPECT_EQ(QubitOrdering::arrangementCost(weights, levels), 3);
+
+    CircuitSimulator ddsim(makeReorderableCircuit(), 1);
+    ddsim.setQubitReordering(true);
+    ddsim.Simulate(1);
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("arrangement_cost"));
+
+    // the collapsed outcome refers to the original qubits
+    const auto  m         = ddsim.MeasureAll(true);
+    const auto  v         = ddsim.getVector();
+    const auto& amplitude = v.at(std::stoul(m, nullptr, 2));
+    EXPECT_NEAR(amplitude.r * amplitude.r + amplitude.i * amplitude.i, 1., 1e-10);
+}
+
+/// entangles the outermost qubits, which is the worst case for the initial order
+static std::unique_ptr<qc::QuantumComputation> makeBadlyOrderedCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(6);
+    for (dd::Qubit q = 0; q < 3; ++q) {
+        quantumComputation->emplace_back<qc::StandardOperation>(6, q, qc::RY, 0.3 + q);
+        quantumComputation->emplace_back<qc::StandardOperation>(6, dd::Control{q}, static_cast<dd::Qubit>(5 - q), qc::X);
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(6, dd::Controls{}, 1, 3, qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(6, dd::Control{5}, 2, qc::RZ, 0.4);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, DynamicReorderingSiftsLevels) {
+    CircuitSimulator ddsim(makeBadlyOrderedCircuit(), 1);
+    ddsim.enableDynamicReordering(1.);
+    ddsim.Simulate(1);
+    EXPECT_NE("0", ddsim.AdditionalStatistics().at("sifting_runs"));
+
+    // swapping a level twice restores the state
+    CircuitSimulator reference(makeBadlyOrderedCircuit(), 1);
+    reference.Simulate(1);
+    auto swapped = DynamicReordering::swapLevels(reference.dd, DynamicReordering::swapLevels(reference.dd, reference.root_edge, 2), 2);
+    EXPECT_EQ(swapped.p, reference.root_edge.p);
+}
+
+TEST(CircuitSimTest, DynamicReorderingWithMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{0}, 3, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{1}, 2, qc::X);
+    // leaves the state unchanged, but is applied at the sifted levels
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Controls{}, 1, 2, qc::SWAP);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{0, 1}, std::vector<std::size_t>{0, 1});
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{3}, qc::Reset);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{2, 3}, std::vector<std::size_t>{2, 3});
+
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+    ddsim.enableDynamicReordering(1.);
+    const auto m = ddsim.Simulate(100);
+    for (const auto& [outcome, count]: m) {
+        // c3 is always 0 after the reset and c2 equals c1
+        EXPECT_EQ(outcome.at(0), '0');
+        EXPECT_EQ(outcome.at(1), outcome.at(2));
+    }
+    // the SWAP is built for the sifted levels once and reused by the other shots
+    EXPECT_NE("0", ddsim.AdditionalStatistics().at("sifted_gate_cache_hits"));
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeCliffordPrefixCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{0}, 2, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::SX);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::S);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{1}, 3, qc::Y);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{2}, 1, qc::Z);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Controls{}, 0, 3, qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::Sdag);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::V);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::Vdag);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::Y);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::RZ, dd::PI_2);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::Phase, -dd::PI_2);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{2}, 0, qc::Phase, dd::PI);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::RZ, 3 * dd::PI);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::T);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::H);
+    return quantumComputation;
+}
+
+/// layers of H, S and CX gates, in which H often acts on qubits whose flipped basis states are in the support
+static std::unique_ptr<qc::QuantumComputation> makeCliffordLayersCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(5);
+    for (dd::Qubit layer = 0; layer < 12; ++layer) {
+        for (dd::Qubit q = 0; q < 5; ++q) {
+            if ((q + layer) % 2 == 0) {
+                quantumComputation->emplace_back<qc::StandardOperation>(5, q, qc::H);
+            }
+            if ((q + layer) % 3 == 0) {
+                quantumComputation->emplace_back<qc::StandardOperation>(5, q, qc::S);
+            }
+        }
+        for (dd::Qubit q = 0; q < 4; ++q) {
+            const auto control = static_cast<dd::Qubit>(layer % 2 == 0 ? q : q + 1);
+            const auto target  = static_cast<dd::Qubit>(layer % 2 == 0 ? q + 1 : q);
+            quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{control}, target, qc::X);
+        }
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 0, qc::T);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, StabilizerPrefixStopsAtNonClifford) {
+    CircuitSimulator ddsim(makeCliffordPrefixCircuit(), 1);
+    ddsim.setStabilizerPrefix(true);
+    ddsim.Simulate(1);
+    EXPECT_EQ("16", ddsim.AdditionalStatistics().at("clifford_prefix_ops"));
+    EXPECT_FALSE(StabilizerTableau::isClifford(qc::StandardOperation(4, 0, qc::Phase, dd::PI_4)));
+    EXPECT_FALSE(StabilizerTableau::isClifford(qc::StandardOperation(4, dd::Control{1}, 0, qc::Phase, dd::PI_2)));
+}
+
+TEST(CircuitSimTest, StabilizerPrefixWithMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{1}, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0}, std::vector<std::size_t>{0});
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 1, qc::RZ, 0.3);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{1, 2}, std::vector<std::size_t>{1, 2});
+
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+    ddsim.setStabilizerPrefix(true);
+    const auto m = ddsim.Simulate(100);
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("clifford_prefix_ops"));
+    for (const auto& [outcome, count]: m) {
+        EXPECT_TRUE(outcome == "000" || outcome == "111");
+    }
+
+    // random outcomes follow the preferred value, deterministic ones the state
+    StabilizerTableau tableau(2);
+    tableau.h(0);
+    tableau.cx(0, 1);
+    EXPECT_TRUE(tableau.measure(0, true));
+    EXPECT_TRUE(tableau.measure(1, false));
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeDenseCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+    for (dd::Qubit q = 0; q < 4; ++q) {
+        quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::RY, 0.4 + q);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{q}, static_cast<dd::Qubit>((q + 1) % 4), qc::RZ, 0.7 * q);
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Controls{}, 0, 2, qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{3, dd::Control::Type::neg}, 1, qc::SX);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, DenseSwitchKeepsResults) {
+    CircuitSimulator reference(makeDenseCircuit(), 1);
+    reference.Simulate(1);
+    CircuitSimulator ddsim(makeDenseCircuit(), 1);
+    ddsim.setDenseSwitch(0.1);
+    ddsim.Simulate(1);
+    EXPECT_EQ("1", ddsim.AdditionalStatistics().at("dense_switches"));
+
+    // sampling works on the dense state as well
+    const auto expected = reference.getVectorComplex();
+    const auto m        = ddsim.MeasureAllNonCollapsing(100);
+    for (const auto& [outcome, count]: m) {
+        EXPECT_GT(std::norm(expected.at(std::stoul(outcome, nullptr, 2))), 0.);
+    }
+}
+
+TEST(CircuitSimTest, DenseSwitchWithMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{0}, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{1}, 2, qc::X);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{0}, std::vector<std::size_t>{0});
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{2}, qc::Reset);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(3, std::vector<dd::Qubit>{1, 2}, std::vector<std::size_t>{1, 2});
+
+    CircuitSimulator ddsim(std::move(quantumComputation), 42);
+    ddsim.setDenseSwitch(0.1);
+    const auto m = ddsim.Simulate(100);
+    EXPECT_EQ("100", ddsim.AdditionalStatistics().at("dense_switches"));
+    for (const auto& [outcome, count]: m) {
+        // c2 is always 0 after the reset and c1 equals c0
+        EXPECT_TRUE(outcome == "000" || outcome == "011");
+    }
+}
+
+/// 100 Trotter steps of a transverse-field Ising chain, followed by a shorter run that is too short to be exponentiated
+static std::unique_ptr<qc::QuantumComputation> makeTrotterCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    for (std::size_t step = 0; step < 100; ++step) {
+        for (dd::Qubit q = 0; q < 3; ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{q}, static_cast<dd::Qubit>(q + 1), qc::X);
+            quantumComputation->emplace_back<qc::StandardOperation>(4, static_cast<dd::Qubit>(q + 1), qc::RZ, 0.05);
+            quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{q}, static_cast<dd::Qubit>(q + 1), qc::X);
+        }
+        for (dd::Qubit q = 0; q < 4; ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::RX, 0.1);
+        }
+    }
+    for (std::size_t step = 0; step < 2; ++step) {
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::T);
+    }
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, BlockExponentiationSquaresRepeatedBlock) {
+    CircuitSimulator ddsim(makeTrotterCircuit(), 1);
+    ddsim.enableBlockExponentiation(16);
+    ddsim.Simulate(1);
+    const auto statistics = ddsim.AdditionalStatistics();
+    EXPECT_EQ("1", statistics.at("repeated_block_runs"));
+    EXPECT_EQ("6", statistics.at("block_squarings"));
+
+    // the block operator exceeds a budget of a single node, hence all gates are applied one by one
+    CircuitSimulator fallback(makeTrotterCircuit(), 1);
+    fallback.enableBlockExponentiation(16, 1);
+    fallback.Simulate(1);
+    EXPECT_EQ("0", fallback.AdditionalStatistics().at("repeated_block_runs"));
+}
+
+/// QFT and inverse QFT of the register {0, 1, 2} (separated by a barrier, which is not part of the plan)
+static std::unique_ptr<qc::QuantumComputation> makeQFTRoundTripCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::H);
+    for (dd::Qubit j = 2; j >= 0; --j) {
+        quantumComputation->emplace_back<qc::StandardOperation>(4, j, qc::H);
+        for (dd::Qubit k = static_cast<dd::Qubit>(j - 1); k >= 0; --k) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{k}, j, qc::Phase, dd::PI / static_cast<dd::fp>(1U << static_cast<unsigned>(j - k)));
+        }
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Controls{}, 0, 2, qc::SWAP);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(4, std::vector<dd::Qubit>{0, 1, 2, 3}, qc::Barrier);
+    quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Controls{}, 0, 2, qc::SWAP);
+    for (dd::Qubit j = 0; j <= 2; ++j) {
+        for (dd::Qubit k = 0; k < j; ++k) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{k}, j, qc::Phase, -dd::PI / static_cast<dd::fp>(1U << static_cast<unsigned>(j - k)));
+        }
+        quantumComputation->emplace_back<qc::StandardOperation>(4, j, qc::H);
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::X);
+    return quantumComputation;
+}
+
+/// replaces both transforms by their emulated counterparts
+static void emulateQFTRoundTrip(CircuitSimulator& ddsim) {
+    ddsim.addEmulation(2, 7, {EmulatedOperation::Kind::QFT, {0, 1, 2}});
+    ddsim.addEmulation(9, 8, {EmulatedOperation::Kind::InverseQFT, {0, 1, 2}});
+}
+
+TEST(CircuitSimTest, EmulatedOperationsReuseCachedQFT) {
+    CircuitSimulator ddsim(makeQFTRoundTripCircuit(), 1);
+    emulateQFTRoundTrip(ddsim);
+    ddsim.Simulate(1);
+    const auto statistics = ddsim.AdditionalStatistics();
+    EXPECT_EQ("2", statistics.at("emulated_operations"));
+    // the inverse is derived from the cached QFT
+    EXPECT_EQ("1", statistics.at("emulation_cache_hits"));
+
+    // annotations must lie within the circuit
+    CircuitSimulator invalid(makeQFTRoundTripCircuit(), 1);
+    invalid.addEmulation(17, 2, {EmulatedOperation::Kind::AddConstant, {0, 1}, {}, 1});
+    EXPECT_THROW(invalid.Simulate(1), std::runtime_error);
+}
+
+TEST(CircuitSimTest, EmulatedArithmeticPermutesBasisStates) {
+    auto               dd = std::make_unique<dd::Package>(5);
+    EmulatedOperations emulator(dd);
+
+    const auto image = [&](const EmulatedOperation& operation, std::size_t value) {
+        std::vector<bool> bits(5, false);
+        for (std::size_t q = 0; q < bits.size(); ++q) {
+            bits.at(q) = ((value >> q) & 1U) != 0;
+        }
+        auto state = dd->makeBasisState(5, bits);
+        dd->incRef(state);
+        emulator.apply(operation, state, 5);
+        std::size_t result = 32;
+        for (std::size_t i = 0; i < 32; ++i) {
+            if (dd->getValueByPath(state, i).approximatelyEquals({1., 0.})) {
+                result = i;
+            }
+        }
+        dd->decRef(state);
+        return result;
+    };
+
+    for (std::size_t x = 0; x < 8; ++x) {
+        EXPECT_EQ(image({EmulatedOperation::Kind::AddConstant, {0, 1, 2}, {}, 5}, x), (x + 5) % 8);
+        EXPECT_EQ(image({EmulatedOperation::Kind::MultiplyModulo, {0, 1, 2}, {}, 3, 7}, x), x < 7 ? (3 * x) % 7 : x);
+        EXPECT_EQ(image({EmulatedOperation::Kind::LessThan, {0, 1, 2}, {3}, 3}, x), x < 3 ? x | 8U : x);
+        // the control on qubit 4 is only satisfied for the second value
+        EXPECT_EQ(image({EmulatedOperation::Kind::AddConstant, {0, 1, 2}, {}, 1, 0, {dd::Control{4}}}, x), x);
+        EXPECT_EQ(image({EmulatedOperation::Kind::AddConstant, {0, 1, 2}, {}, 1, 0, {dd::Control{4}}}, x | 16U), ((x + 1) % 8) | 16U);
+    }
+    for (std::size_t x = 0; x < 4; ++x) {
+        for (std::size_t y = 0; y < 4; ++y) {
+            EXPECT_EQ(image({EmulatedOperation::Kind::AddRegister, {0, 1}, {2, 3}}, x | (y << 2U)), x | (((x + y) % 4) << 2U));
+        }
+    }
+
+    // the DDs are only built once
+    EXPECT_EQ(emulator.getCacheSize(), 5);
+
+    // multiplication by 2 is not invertible modulo 4
+    EXPECT_THROW(emulator.get(5, {EmulatedOperation::Kind::MultiplyModulo, {0, 1}, {}, 2, 4}), std::runtime_error);
+    EXPECT_THROW(emulator.get(5, {EmulatedOperation::Kind::AddRegister, {0, 1}, {1, 2}}), std::runtime_error);
+}
+
+TEST(CircuitSimTest, EmulatedArithmeticScalesToWideRegisters) {
+    // far too many register values for a table, but the carry chain only needs a few nodes per qubit
+    const dd::QubitCount   n  = 40;
+    auto                   dd = std::make_unique<dd::Package>(n);
+    EmulatedOperations     emulator(dd);
+    std::vector<dd::Qubit> qubits(n - 1);
+    std::iota(qubits.begin(), qubits.end(), 0);
+
+    const auto basisState = [&](const unsigned long long value) {
+        std::vector<bool> bits(n, false);
+        for (std::size_t q = 0; q < bits.size(); ++q) {
+            bits.at(q) = ((value >> q) & 1U) != 0;
+        }
+        return dd->makeBasisState(n, bits);
+    };
+    const auto expectImage = [&](const EmulatedOperation& operation, const unsigned long long value, const unsigned long long expected) {
+        EXPECT_LE(dd->size(emulator.get(n, operation)), 4U * n);
+        auto state = basisState(value);
+        dd->incRef(state);
+        emulator.apply(operation, state, n);
+        EXPECT_NEAR(dd->fidelity(state, basisState(expected)), 1., 1e-10);
+        dd->decRef(state);
+    };
+
+    const auto x    = 0x2F0F0F0F0FULL;
+    const auto mask = (1ULL << (n - 1)) - 1;
+    expectImage({EmulatedOperation::Kind::AddConstant, qubits, {}, 0x70F0F0F0F1ULL}, x, (x + 0x70F0F0F0F1ULL) & mask);
+    expectImage({EmulatedOperation::Kind::LessThan, qubits, {n - 1}, x + 1}, x, x | (1ULL << (n - 1)));
+    expectImage({EmulatedOperation::Kind::LessThan, qubits, {n - 1}, x}, x, x);
+}
+
+static std::unique_ptr<qc::QuantumComputation> makeReversibleSectionCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(5);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 0, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 2, qc::RY, 0.3);
+    // Toffoli, CNOT, Fredkin, negatively controlled NOT and NOT
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Controls{dd::Control{0}, dd::Control{1}}, 3, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{3}, 4, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Controls{dd::Control{0}}, 2, 4, qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, dd::Control{2, dd::Control::Type::neg}, 1, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 0, qc::X);
+    quantumComputation->emplace_back<qc::StandardOperation>(5, 4, qc::H);
+    return quantumComputation;
+}
+
+TEST(CircuitSimTest, PermutationEmulationRespectsSliceBudget) {
+    // the state has eight register values when the section starts, which exceeds a budget of two slices
+    for (const std::size_t max_slices: {PermutationEmulator::DEFAULT_MAX_SLICES, std::size_t{2}}) {
+        CircuitSimulator ddsim(makeReversibleSectionCircuit(), 1);
+        ddsim.setPermutationEmulation(2, max_slices);
+        ddsim.Simulate(1);
+        const bool rejected = max_slices == 2;
+        EXPECT_EQ(rejected ? "0" : "1", ddsim.AdditionalStatistics().at("reversible_sections"));
+        EXPECT_EQ(rejected ? "1" : "0", ddsim.AdditionalStatistics().at("rejected_reversible_sections"));
+    }
+}
+
+TEST(CircuitSimTest, PermutationEmulatorAppliesIndexFunction) {
+    auto dd    = std::make_unique<dd::Package>(4);
+    auto state = dd->makeZeroState(4);
+    for (dd::Qubit q = 0; q < 4; ++q) {
+        state = dd->multiply(dd->makeGateDD(dd::RYmat(0.4 + 0.3 * q), 4, q), state);
+    }
+    dd->incRef(state);
+    const auto before = dd->getVector(state);
+
+    // |x> -> |3x + 1 mod 8> on the (interleaved) register {0, 2, 3}
+    const std::vector<dd::Qubit> qubits{0, 2, 3};
+    PermutationEmulator          emulator(dd);
+    const auto                   after = dd->getVector(*emulator.apply(qubits, [](unsigned long long x) { return (3 * x + 1) % 8; }, state));
+
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        unsigned long long x = 0;
+        for (std::size_t b = 0; b < qubits.size(); ++b) {
+            x |= ((i >> static_cast<std::size_t>(qubits.at(b))) & 1U) << b;
+        }
+        const auto  y = (3 * x + 1) % 8;
+        std::size_t j = i;
+        for (std::size_t b = 0; b < qubits.size(); ++b) {
+            j = (j & ~(1ULL << static_cast<std::size_t>(qubits.at(b)))) | (((y >> b) & 1U) << static_cast<std::size_t>(qubits.at(b)));
+        }
+        EXPECT_NEAR(std::abs(after.at(j) - before.at(i)), 0., 1e-10);
+    }
+
+    EXPECT_THROW(emulator.apply(qubits, [](unsigned long long x) { return x / 2; }, state), std::runtime_error);
+
+    // the state has eight register values, hence a budget of four slices rejects the permutation
+    emulator.setMaxSlices(4);
+    EXPECT_FALSE(emulator.apply(qubits, [](unsigned long long x) { return (3 * x + 1) % 8; }, state).has_value());
+}
+
+/// a simulator option and a circuit on which it has to reproduce the state of the plain simulation
+struct OptionCase {
+    std::string                                              name;
+    std::function<std::unique_ptr<qc::QuantumComputation>()> makeCircuit;
+    std::function<void(CircuitSimulator&)>                   enable;
+    dd::fp                                                   tolerance = 1e-10;
+};
+
+static std::vector<OptionCase> optionCases() {
+    return {
+            {"IdleQubitElimination", makeIdleQubitCircuit, [](CircuitSimulator& ddsim) { ddsim.setIdleQubitElimination(true); }},
+            {"Factorization", [] { return makeFactorizableCircuit(false); }, [](CircuitSimulator& ddsim) { ddsim.setFactorization(true); }},
+            {"FactorizationWithSwap", [] { return makeFactorizableCircuit(true); }, [](CircuitSimulator& ddsim) { ddsim.setFactorization(true); }},
+            {"QubitReordering", makeReorderableCircuit, [](CircuitSimulator& ddsim) { ddsim.setQubitReordering(true); }},
+            {"DynamicReordering", makeBadlyOrderedCircuit, [](CircuitSimulator& ddsim) { ddsim.enableDynamicReordering(1.); }},
+            {"StabilizerPrefix", makeCliffordPrefixCircuit, [](CircuitSimulator& ddsim) { ddsim.setStabilizerPrefix(true); }},
+            {"StabilizerPrefixLayers", makeCliffordLayersCircuit, [](CircuitSimulator& ddsim) { ddsim.setStabilizerPrefix(true); }},
+            {"DenseSwitch", makeDenseCircuit, [](CircuitSimulator& ddsim) { ddsim.setDenseSwitch(0.1); }},
+            {"BlockExponentiation", makeTrotterCircuit, [](CircuitSimulator& ddsim) { ddsim.enableBlockExponentiation(16); }, 1e-8},
+            {"BlockExponentiationFallback", makeTrotterCircuit, [](CircuitSimulator& ddsim) { ddsim.enableBlockExponentiation(16, 1); }, 1e-8},
+            {"EmulatedQFT", makeQFTRoundTripCircuit, emulateQFTRoundTrip},
+            {"PermutationEmulation", makeReversibleSectionCircuit, [](CircuitSimulator& ddsim) { ddsim.setPermutationEmulation(2); }},
+            {"RejectedPermutationEmulation", makeReversibleSectionCircuit, [](CircuitSimulator& ddsim) { ddsim.setPermutationEmulation(2, 2); }},
+    };
+}
+
+class OptionKeepsStateTest: public testing::TestWithParam<OptionCase> {};
+
+TEST_P(OptionKeepsStateTest, MatchesPlainSimulation) {
+    const auto& option = GetParam();
+
+    CircuitSimulator reference(option.makeCircuit(), 1);
+    reference.Simulate(1);
+    CircuitSimulator ddsim(option.makeCircuit(), 1);
+    option.enable(ddsim);
+    ddsim.Simulate(1);
+    expectSameState(ddsim, reference, option.tolerance);
+}
+
+INSTANTIATE_TEST_SUITE_P(CircuitSimTest, OptionKeepsStateTest, testing::ValuesIn(optionCases()), [](const testing::TestParamInfo<OptionCase>& info) { return info.param.name; });
+
+TEST(CircuitSimTest, InitialStates) {
+    // X on qubit 0 followed by a CNOT, i.e., the basis state x is mapped to permute(x)
+    auto makeCircuit = []() {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{0}, 2, qc::X);
+        return quantumComputation;
+    };
+    const auto permute = [](std::size_t x) {
+        x ^= 1U;
+        return (x & 1U) != 0 ? x ^ 4U : x;
+    };
+
+    std::vector<std::complex<dd::fp>> amplitudes(8);
+    dd::fp                            norm = 0;
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        amplitudes[i] = {0.1 * static_cast<dd::fp>(i + 1), 0.05 * static_cast<dd::fp>(i)};
+        norm += std::norm(amplitudes[i]);
+    }
+
+    for (const bool reorder: {false, true}) {
+        CircuitSimulator dense(makeCircuit(), InitialState::fromAmplitudes(amplitudes), 1);
+        dense.setQubitReordering(reorder);
+        dense.Simulate(1);
+        const auto dense_result = dense.getVectorComplex();
+        for (std::size_t x = 0; x < amplitudes.size(); ++x) {
+            EXPECT_NEAR(std::abs(dense_result.at(permute(x)) - amplitudes[x] / std::sqrt(norm)), 0., 1e-10);
+        }
+
+        CircuitSimulator sparse(makeCircuit(), InitialState::fromSparseAmplitudes(3, {{0, 1}, {7, {0, 1}}}), 1);
+        sparse.setQubitReordering(reorder);
+        sparse.Simulate(1);
+        const auto sparse_result = sparse.getVectorComplex();
+        EXPECT_NEAR(std::abs(sparse_result.at(permute(0)) - dd::SQRT2_2), 0., 1e-10);
+        EXPECT_NEAR(std::abs(sparse_result.at(permute(7)) - std::complex<dd::fp>{0, dd::SQRT2_2}), 0., 1e-10);
+    }
+
+    // |1>|+>|0> (qubit 2 first), where the CNOT does not act on the superposition
+    CircuitSimulator basis(makeCircuit(), InitialState::fromBasisString("1+0"), 1);
+    basis.Simulate(1);
+    const auto basis_result = basis.getVectorComplex();
+    EXPECT_NEAR(std::abs(basis_result.at(permute(4)) - dd::SQRT2_2), 0., 1e-10);
+    EXPECT_NEAR(std::abs(basis_result.at(permute(6)) - dd::SQRT2_2), 0., 1e-10);
+
+    EXPECT_THROW(CircuitSimulator(makeCircuit(), InitialState::fromBasisString("01"), 1), std::runtime_error);
+    EXPECT_THROW(InitialState::fromBasisString("0x1"), std::runtime_error);
+    EXPECT_THROW(InitialState::fromAmplitudes({1, 0, 0}), std::runtime_error);
+}
+
+TEST(CircuitSimTest, PrefixCacheResumesSharedPrefix) {
+    auto makeCircuit = [](qc::OpType last) {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{0}, 1, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, dd::Control{1}, 2, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(3, 2, last);
+        return quantumComputation;
+    };
+    CircuitSimulator ddsim(makeCircuit(qc::X), 1);
+    ddsim.enablePrefixCache(1000, 1);
+    auto m = ddsim.Simulate(1000);
+    EXPECT_EQ("0", ddsim.AdditionalStatistics().at("prefix_cache_hits"));
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_GT(m["011"], 0);
+
+    ddsim.setCircuit(makeCircuit(qc::I));
+    m = ddsim.Simulate(1000);
+    EXPECT_EQ("1", ddsim.AdditionalStatistics().at("prefix_cache_hits"));
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("prefix_cache_reused_ops"));
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_GT(m["000"], 0);
+    EXPECT_GT(m["111"], 0);
+    ddsim.disablePrefixCache();
+}
+
+TEST(CircuitSimTest, PrefixCacheRespectsNodeBudget) {
+    auto                   dd = std::make_unique<dd::Package>(4);
+    qc::QuantumComputation quantumComputation(4);
+    quantumComputation.emplace_back<qc::StandardOperation>(4, 0, qc::X);
+    const ExecutionPlan plan(quantumComputation, dd, true);
+
+    const auto zero   = dd->makeZeroState(4);
+    const auto one    = dd->makeBasisState(4, {dd::BasisStates::one, dd::BasisStates::zero, dd::BasisStates::zero, dd::BasisStates::zero});
+    const auto budget = dd->size(zero);
+    {
+        PrefixCache cache(dd, budget, 1);
+        cache.insert(1, plan, 1, zero);
+        EXPECT_EQ(cache.size(), 1);
+        // only one of the two equally-sized states fits, so the least recently used one is evicted
+        cache.insert(2, plan, 1, one);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_FALSE(cache.lookup({1}, plan).has_value());
+        EXPECT_TRUE(cache.lookup({2}, plan).has_value());
+    }
+}
+
+TEST(CircuitSimTest, PrefixCacheComparesOperationsOnHashCollision) {
+    auto                   dd = std::make_unique<dd::Package>(2);
+    qc::QuantumComputation flip(2);
+    flip.emplace_back<qc::StandardOperation>(2, 0, qc::X);
+    qc::QuantumComputation rotate(2);
+    rotate.emplace_back<qc::StandardOperation>(2, 0, qc::RX, dd::PI);
+    const ExecutionPlan flip_plan(flip, dd, true);
+    const ExecutionPlan rotate_plan(rotate, dd, true);
+
+    PrefixCache cache(dd, 1000, 1);
+    cache.insert(7, flip_plan, 1, dd->makeBasisState(2, {true, false}));
+    // both prefixes are given the same hash, but only the one that produced the state may use it
+    EXPECT_FALSE(cache.lookup({7}, rotate_plan).has_value());
+    EXPECT_TRUE(cache.lookup({7}, flip_plan).has_value());
+    EXPECT_EQ(cache.getMisses(), 1);
+    EXPECT_EQ(cache.getHits(), 1);
+}
+
 TEST(CircuitSimTest, DestructiveMeasurementAll) {
     auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
     quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
@@ -153,6 +1050,54 @@ TEST(CircuitSimTest, DestructiveMeasurementOne) {
     }
 }
 
+TEST(CircuitSimTest, GarbageCollectionEveryK) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    for (int i = 0; i < 6; ++i) {
+        quantumComputation->emplace_back<qc::StandardOperation>(3, i % 3, qc::H);
+    }
+    CircuitSimulator ddsim(std::move(quantumComputation));
+    ddsim.setGarbageCollectionInfo(GarbageCollectionInfo(GarbageCollectionInfo::EveryK, 2, 0.));
+    ddsim.Simulate(1);
+
+    EXPECT_EQ("3", ddsim.AdditionalStatistics().at("gc_calls"));
+    EXPECT_EQ("000", ddsim.MeasureAll(false)); // collections must not affect the result
+}
+
+TEST(CircuitSimTest, GarbageCollectionOnlyAtMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 0, 0);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 1, qc::H);
+    CircuitSimulator ddsim(std::move(quantumComputation), 1337);
+    ddsim.setGarbageCollectionInfo(GarbageCollectionInfo(GarbageCollectionInfo::Measurements, 1, 0.));
+    ddsim.Simulate(5);
+
+    EXPECT_EQ("5", ddsim.AdditionalStatistics().at("gc_calls"));
+}
+
+TEST(CircuitSimTest, GarbageCollectionByMemoryRearms) {
+    auto dd    = std::make_unique<dd::Package>(4);
+    auto state = dd->makeZeroState(4);
+    dd->incRef(state);
+
+    // the live state alone exceeds the threshold, collecting it over and over would not free anything
+    GarbageCollectionPolicy policy(GarbageCollectionInfo(GarbageCollectionInfo::Memory, 1, 1e-6));
+    ASSERT_GT(GarbageCollectionPolicy::estimatedMemory(dd), 1e-6);
+    for (int i = 0; i < 10; ++i) {
+        policy.afterOperation(dd);
+    }
+    EXPECT_EQ(policy.getCalls(), 1);
+
+    dd->decRef(state);
+}
+
+TEST(CircuitSimTest, GarbageCollectionModeFromString) {
+    GarbageCollectionInfo::CollectWhen when{};
+    std::istringstream("dead_ratio") >> when;
+    EXPECT_EQ(when, GarbageCollectionInfo::DeadRatio);
+    EXPECT_THROW(std::istringstream("sometimes") >> when, std::runtime_error);
+}
+
 TEST(CircuitSimTest, ApproximateByFidelity) {
     auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
     quantumComputation->emplace_back<qc::StandardOperation>(3, 0, qc::H);
@@ -210,6 +1155,196 @@ TEST(CircuitSimTest, ApproximationByFidelityInSimulator) {
     ASSERT_LE(std::stod(ddsim.AdditionalStatistics()["final_fidelity"]), 0.75); // the least contributing path has .25
 }
 
+TEST(CircuitSimTest, DeadlineForcesApproximation) {
+    const auto makeCircuit = []() {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(10);
+        for (std::size_t layer = 0; layer < 8; ++layer) {
+            for (dd::Qubit q = 0; q < 10; ++q) {
+                quantumComputation->emplace_back<qc::StandardOperation>(10, q, qc::RY, 0.1 * static_cast<dd::fp>((q + 1) * (layer + 1)));
+            }
+            for (dd::Qubit q = 1; q < 10; ++q) {
+                quantumComputation->emplace_back<qc::StandardOperation>(10, dd::Control{static_cast<dd::Qubit>(q - 1)}, q, qc::X);
+            }
+        }
+        return quantumComputation;
+    };
+
+    CircuitSimulator relaxed(makeCircuit(), 1);
+    relaxed.setDeadline(1e6);
+    relaxed.Simulate(1);
+    auto statistics = relaxed.AdditionalStatistics();
+    EXPECT_EQ(statistics.at("deadline_forced_approximation"), "false");
+    EXPECT_EQ(std::stod(statistics.at("final_fidelity")), 1.);
+
+    // the deadline cannot be met, hence every check approximates the state
+    CircuitSimulator urgent(makeCircuit(), 1);
+    urgent.setDeadline(1e-9, 0.5);
+    urgent.Simulate(1);
+    statistics = urgent.AdditionalStatistics();
+    EXPECT_EQ(statistics.at("deadline_forced_approximation"), "true");
+    EXPECT_GT(std::stoul(statistics.at("deadline_approximations")), 0);
+    EXPECT_LT(std::stod(statistics.at("final_fidelity")), 1.);
+    EXPECT_GT(std::stod(statistics.at("final_fidelity")), 0.);
+
+    // with a mid-circuit reset every shot is approximated on its own, so the reported fidelity is the one of the worst
+    // shot instead of the product over all shots
+    auto withReset = makeCircuit();
+    withReset->emplace_back<qc::NonUnitaryOperation>(10, std::vector<dd::Qubit>{0}, qc::Reset);
+    CircuitSimulator shots(std::move(withReset), 1);
+    shots.setDeadline(1e-9, 0.5);
+    shots.Simulate(20);
+    statistics                = shots.AdditionalStatistics();
+    const auto worst          = std::stod(statistics.at("final_fidelity"));
+    const auto mean           = std::stod(statistics.at("deadline_mean_fidelity"));
+    const auto approximations = std::stoul(statistics.at("deadline_approximations"));
+    EXPECT_GT(approximations, 0);
+    EXPECT_GT(worst, 0.);
+    EXPECT_LE(worst, mean + 1e-6);
+    // a second simulation starts counting the approximations anew
+    shots.Simulate(1);
+    EXPECT_LT(std::stoul(shots.AdditionalStatistics().at("deadline_approximations")), approximations);
+
+    EXPECT_THROW(DeadlineController(0.), std::runtime_error);
+    EXPECT_THROW(DeadlineController(1., 1.), std::runtime_error);
+}
+
+static dd::fp referenceExpectation(const std::vector<std::complex<dd::fp>>& amplitudes, const std::vector<PauliTerm>& observable) {
+    dd::fp expectation = 0.;
+    for (const auto& [coefficient, pauli]: observable) {
+        // apply the Pauli string to each basis state
+        std::complex<dd::fp> value = 0.;
+        for (std::size_t j = 0; j < amplitudes.size(); ++j) {
+            std::size_t          k     = j;
+            std::complex<dd::fp> phase = 1.;
+            for (std::size_t q = 0; q < pauli.size(); ++q) {
+                const bool bit = (j >> q) & 1U;
+                switch (pauli.at(pauli.size() - 1 - q)) {
+                    case 'X': k ^= 1ULL << q; break;
+                    case 'Y':
+                        k ^= 1ULL << q;
+                        phase *= bit ? std::complex<dd::fp>{0., -1.} : std::complex<dd::fp>{0., 1.};
+                        break;
+                    case 'Z': phase *= bit ? -1. : 1.; break;
+                    default: break;
+                }
+            }
+            value += std::conj(amplitudes.at(k)) * phase * amplitudes.at(j);
+        }
+        expectation += coefficient * value.real();
+    }
+    return expectation;
+}
+
+TEST(CircuitSimTest, PauliExpectationValues) {
+    const auto makeCircuit = []() {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::RY, 0.7);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{0}, 2, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::RX, 1.3);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{1}, 3, qc::Y);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 2, qc::S);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{3}, 0, qc::RZ, 0.4);
+        return quantumComputation;
+    };
+    const std::vector<PauliTerm> observable{{0.5, "IIII"}, {1.5, "ZZII"}, {-0.7, "IXYZ"}, {0.3, "XIXI"}, {2., "YYII"}, {-1.1, "ZIIY"}, {0.9, "IIZZ"}};
+
+    CircuitSimulator ddsim(makeCircuit());
+    ddsim.Simulate(1);
+    const auto expected = referenceExpectation(ddsim.getVectorComplex(), observable);
+    EXPECT_NEAR(ddsim.expectationValue(observable), expected, 1e-9);
+    EXPECT_NEAR(ddsim.expectationValue(observable, 3), expected, 1e-9);
+    EXPECT_NEAR(ddsim.expectationValue({{1., "ZIII"}}), referenceExpectation(ddsim.getVectorComplex(), {{1., "ZIII"}}), 1e-9);
+
+    // the Pauli strings refer to qubits, not to levels
+    CircuitSimulator reordered(makeCircuit());
+    reordered.setQubitReordering(true);
+    reordered.Simulate(1);
+    EXPECT_NEAR(reordered.expectationValue(observable), expected, 1e-9);
+
+    CircuitSimulator dense(makeCircuit());
+    dense.setDenseSwitch(1e-9);
+    dense.Simulate(1);
+    EXPECT_NEAR(dense.expectationValue(observable, 2), expected, 1e-9);
+
+    EXPECT_THROW(static_cast<void>(ddsim.expectationValue({{1., "ZZ"}})), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(ddsim.expectationValue({{1., "ZZIA"}})), std::runtime_error);
+}
+
+TEST(CircuitSimTest, DiagonalCostExpectationAndCVaR) {
+    const auto makeCircuit = []() {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+        for (dd::Qubit q = 0; q < 4; ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::H);
+        }
+        for (dd::Qubit q = 1; q < 4; ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{static_cast<dd::Qubit>(q - 1)}, q, qc::RZ, 0.3 * q);
+        }
+        for (dd::Qubit q = 0; q < 4; ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::RX, 0.2 + 0.25 * q);
+        }
+        return quantumComputation;
+    };
+    // MaxCut on a ring as an Ising model and a QUBO with an extra diagonal term
+    const auto ising = DiagonalCost::fromIsing(4, {0.1, 0., -0.3, 0.}, {{{0, 1}, 1.}, {{1, 2}, 1.}, {{2, 3}, 1.}, {{3, 0}, 1.}}, -2.);
+    const auto qubo  = DiagonalCost::fromQubo(4, {{{0, 0}, -1.}, {{0, 2}, 2.}, {{3, 1}, -0.5}, {{1, 2}, 1.5}}, 0.25);
+    EXPECT_DOUBLE_EQ(ising.evaluate("0000"), 2.1 - 0.3);
+    EXPECT_DOUBLE_EQ(ising.evaluate("0101"), -2. - 4. - 0.1 + 0.3);
+    EXPECT_DOUBLE_EQ(qubo.evaluate("1111"), 0.25 - 1. + 2. - 0.5 + 1.5);
+
+    const auto reference = [](const std::vector<std::complex<dd::fp>>& amplitudes, const DiagonalCost& cost, const dd::fp alpha) {
+        std::vector<std::pair<dd::fp, dd::fp>> outcomes{};
+        dd::fp                                 expectation = 0.;
+        for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+            // toBinaryString starts with qubit 0
+            auto outcome = Simulator::toBinaryString(i, 4);
+            std::reverse(outcome.begin(), outcome.end());
+            const auto value = cost.evaluate(outcome);
+            expectation += std::norm(amplitudes.at(i)) * value;
+            outcomes.emplace_back(value, std::norm(amplitudes.at(i)));
+        }
+        std::sort(outcomes.begin(), outcomes.end());
+        dd::fp mass = 0.;
+        dd::fp sum  = 0.;
+        for (const auto& [value, p]: outcomes) {
+            const auto taken = std::min(p, alpha - mass);
+            mass += taken;
+            sum += taken * value;
+        }
+        return std::pair{expectation, sum / alpha};
+    };
+
+    CircuitSimulator ddsim(makeCircuit());
+    ddsim.Simulate(1);
+    CircuitSimulator reordered(makeCircuit());
+    reordered.setQubitReordering(true);
+    reordered.Simulate(1);
+    CircuitSimulator dense(makeCircuit());
+    dense.setDenseSwitch(1e-9);
+    dense.Simulate(1);
+
+    for (const auto* cost: {&ising, &qubo}) {
+        for (const auto alpha: {0.1, 0.5, 1.}) {
+            const auto [expectation, cvar] = reference(ddsim.getVectorComplex(), *cost, alpha);
+            for (const auto* sim: {&ddsim, &reordered, &dense}) {
+                EXPECT_NEAR(sim->expectationValue(*cost), expectation, 1e-9);
+                const auto result = sim->conditionalValueAtRisk(*cost, alpha);
+                EXPECT_NEAR(result.value, cvar, 1e-9);
+                EXPECT_NEAR(result.covered_probability, 1., 1e-9);
+            }
+        }
+    }
+
+    // only the most probable outcomes are enumerated
+    const auto partial = ddsim.conditionalValueAtRisk(ising, 0.5, 3);
+    EXPECT_EQ(partial.outcomes, 3);
+    EXPECT_LT(partial.covered_probability, 1.);
+
+    EXPECT_THROW(static_cast<void>(ddsim.conditionalValueAtRisk(ising, 0.)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(ddsim.expectationValue(DiagonalCost(3))), std::runtime_error);
+    EXPECT_THROW(DiagonalCost::fromQubo(2, {{{0, 2}, 1.}}), std::runtime_error);
+}
+
 TEST(CircuitSimTest, GRCS4x4Test) {
     {
         CircuitSimulator ddsim(std::make_unique<qc::QuantumComputation>("circuits/inst_4x4_10_0.txt"));
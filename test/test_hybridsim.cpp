@@ -1,4 +1,5 @@
 #include "HybridSchrodingerFeynmanSimulator.hpp"
+#include "test_utils.hpp"
 
 #include <gtest/gtest.h>
 #include <memory>
@@ -165,3 +166,39 @@ TEST(HybridSimTest, NonStandardOperation) {
     HybridSchrodingerFeynmanSimulator ddsim(std::move(quantumComputation));
     EXPECT_THROW(ddsim.Simulate(0), std::invalid_argument);
 }
+
+TEST(HybridSimTest, QubitReorderingAvoidsDecisions) {
+    auto quantumComputation = [] {
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0, qc::H);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 1, qc::H);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0_pc, 3, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 1_pc, 2, qc::X);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 3, qc::T);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, 0_pc, 3, qc::RY, 0.4);
+        return quantumComputation;
+    };
+
+    HybridSchrodingerFeynmanSimulator reference(quantumComputation(), HybridSchrodingerFeynmanSimulator::Mode::Amplitude);
+    reference.Simulate(0);
+    ASSERT_EQ(reference.getNDecisions(2), 3);
+
+    HybridSchrodingerFeynmanSimulator ddsim(quantumComputation(), HybridSchrodingerFeynmanSimulator::Mode::Amplitude);
+    ddsim.setQubitReordering(true);
+    ddsim.Simulate(0);
+    // qubits 0 and 3 as well as qubits 1 and 2 end up in the same slice
+    EXPECT_EQ(ddsim.getNDecisions(2), 0);
+
+    expectSameState(ddsim.getFinalAmplitudes(), reference.getFinalAmplitudes());
+}
+
+TEST(HybridSimTest, RejectsInitialState) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 1_pc, 0, qc::X);
+
+    HybridSchrodingerFeynmanSimulator ddsim(std::move(quantumComputation));
+    EXPECT_THROW(ddsim.setInitialState(InitialState::fromBasisString("10")), std::runtime_error);
+    // the default state is what the slices start from anyway
+    EXPECT_NO_THROW(ddsim.setInitialState(InitialState{}));
+}
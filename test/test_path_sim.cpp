@@ -188,3 +188,36 @@ TEST(TaskBasedSimTest, GroverCircuitPairwiseGrouping) {
         std::cout << state << ": " << count << std::endl;
     }
 }
+
+TEST(TaskBasedSimTest, LightconeSamplesMeasuredQubitsOnly) {
+    auto qc = std::make_unique<qc::QuantumComputation>(3);
+    qc->h(0U);
+    qc->x(1U, 0_pc);
+    qc->h(2U);
+    qc->measure(0U, 0U);
+    qc->measure(1U, 1U);
+
+    auto config      = PathSimulator::Configuration{};
+    config.lightcone = true;
+    PathSimulator tbs(std::move(qc), config);
+
+    auto counts = tbs.Simulate(1024);
+    EXPECT_EQ("1", tbs.AdditionalStatistics().at("lightcone_removed_ops"));
+
+    std::size_t total = 0;
+    for (const auto& [state, count]: counts) {
+        EXPECT_TRUE(state == "000" || state == "011") << state;
+        total += count;
+    }
+    EXPECT_EQ(total, 1024);
+}
+
+TEST(TaskBasedSimTest, RejectsInitialState) {
+    auto qc = std::make_unique<qc::QuantumComputation>(2);
+    qc->h(1U);
+    qc->x(0U, 1_pc);
+
+    PathSimulator tbs(std::move(qc), PathSimulator::Configuration());
+    EXPECT_THROW(tbs.setInitialState(InitialState::fromBasisString("+0")), std::runtime_error);
+    EXPECT_NO_THROW(tbs.setInitialState(InitialState{}));
+}
@@ -0,0 +1,94 @@
+#include "CircuitSimulator.hpp"
+#include "StateVectorSimulator.hpp"
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace dd::literals;
+
+static std::unique_ptr<qc::QuantumComputation> makeRandomLayers(dd::QubitCount n) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(n);
+    for (std::size_t layer = 0; layer < 3; ++layer) {
+        for (dd::Qubit q = 0; q < static_cast<dd::Qubit>(n); ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(n, q, qc::RX, 0.3 + q + layer);
+            quantumComputation->emplace_back<qc::StandardOperation>(n, q, qc::RZ, 1.1 * q + layer);
+        }
+        for (dd::Qubit q = 0; q < static_cast<dd::Qubit>(n); ++q) {
+            quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Control{q}, static_cast<dd::Qubit>((q + 1) % n), qc::X);
+        }
+    }
+    quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Controls{0_pc, 2_nc}, 1, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Controls{}, 0, static_cast<dd::Qubit>(n - 1), qc::SWAP);
+    quantumComputation->emplace_back<qc::StandardOperation>(n, dd::Controls{1_nc}, static_cast<dd::Qubit>(n - 1), 0, qc::Peres);
+    return quantumComputation;
+}
+
+TEST(StateVectorSimTest, MatchesDDSimulation) {
+    for (const dd::QubitCount n: {3, 7}) {
+        CircuitSimulator reference(makeRandomLayers(n), 1);
+        reference.Simulate(1);
+        StateVectorSimulator dense(makeRandomLayers(n), 1);
+        dense.Simulate(1);
+
+        expectSameState(dense, reference);
+    }
+}
+
+TEST(StateVectorSimTest, InitialStateMatchesDDSimulation) {
+    const dd::QubitCount              n = 5;
+    std::vector<std::complex<dd::fp>> amplitudes(1U << n);
+    for (std::size_t i = 0; i < amplitudes.size(); ++i) {
+        amplitudes[i] = {std::cos(0.7 * static_cast<dd::fp>(i)), std::sin(0.3 * static_cast<dd::fp>(i * i))};
+    }
+    for (const auto& initial_state: {InitialState::fromAmplitudes(amplitudes), InitialState::fromBasisString("1+-rl")}) {
+        CircuitSimulator reference(makeRandomLayers(n), initial_state, 1);
+        reference.Simulate(1);
+        StateVectorSimulator dense(makeRandomLayers(n), 1);
+        dense.setInitialState(initial_state);
+        dense.Simulate(1);
+
+        expectSameState(dense, reference);
+    }
+}
+
+TEST(StateVectorSimTest, ParallelMatchesSequential) {
+    // large enough to be distributed over the threads
+    const dd::QubitCount n = 15;
+    StateVectorSimulator sequential(makeRandomLayers(n), 1, 1);
+    sequential.Simulate(1);
+    StateVectorSimulator parallel(makeRandomLayers(n), 1, 4);
+    parallel.Simulate(1);
+    EXPECT_EQ("4", parallel.AdditionalStatistics().at("threads"));
+
+    expectSameState(parallel, sequential, 1e-12);
+}
+
+TEST(StateVectorSimTest, MeasurementsAndClassicControl) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(2);
+    quantumComputation->emplace_back<qc::StandardOperation>(2, 0, qc::H);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 0, 0);
+    std::unique_ptr<qc::Operation> op(new qc::StandardOperation(2, 1, qc::X));
+    quantumComputation->emplace_back<qc::ClassicControlledOperation>(op, std::pair<dd::Qubit, dd::QubitCount>{0, 1}, 1);
+    quantumComputation->emplace_back<qc::NonUnitaryOperation>(2, 1, 1);
+
+    StateVectorSimulator ddsim(std::move(quantumComputation), 42);
+    const auto           m = ddsim.Simulate(1000);
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_NEAR(m.at("00"), 500, 100);
+    EXPECT_NEAR(m.at("11"), 500, 100);
+    EXPECT_EQ("1000", ddsim.AdditionalStatistics().at("single_shots"));
+}
+
+TEST(StateVectorSimTest, SamplingWithoutMeasurements) {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(3);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2, qc::H);
+    quantumComputation->emplace_back<qc::StandardOperation>(3, 2_pc, 0, qc::X);
+
+    StateVectorSimulator ddsim(std::move(quantumComputation), 42);
+    const auto           m = ddsim.Simulate(1000);
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_NEAR(m.at("000"), 500, 100);
+    EXPECT_NEAR(m.at("101"), 500, 100);
+    EXPECT_EQ("1", ddsim.AdditionalStatistics().at("single_shots"));
+}
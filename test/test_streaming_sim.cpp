@@ -0,0 +1,89 @@
+#include "CircuitSimulator.hpp"
+#include "StreamingSimulator.hpp"
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+
+using namespace dd::literals;
+
+static std::unique_ptr<qc::QuantumComputation> makeCircuit() {
+    auto quantumComputation = std::make_unique<qc::QuantumComputation>(4);
+    for (dd::Qubit q = 0; q < 4; ++q) {
+        quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::H);
+    }
+    for (dd::Qubit q = 1; q < 4; ++q) {
+        quantumComputation->emplace_back<qc::StandardOperation>(4, dd::Control{static_cast<dd::Qubit>(q - 1)}, q, qc::RZ, 0.1 * q);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, std::vector<dd::Qubit>{static_cast<dd::Qubit>(q - 1), q}, qc::SWAP);
+        quantumComputation->emplace_back<qc::StandardOperation>(4, q, qc::RY, 0.2 * q);
+    }
+    return quantumComputation;
+}
+
+static const std::string qasm = "OPENQASM 2.0;\n"
+                                "include \"qelib1.inc\";\n"
+                                "// a comment; with a semicolon\n"
+                                "qreg q[3];\n"
+                                "creg c[3];\n"
+                                "gate bell a, b { h a; cx a, b; }\n"
+                                "x q[2];\n"
+                                "bell q[0], q[1];\n"
+                                "gate flip a { x a; }\n"
+                                "flip q[2]; flip q[1];\n"
+                                "barrier q;\n"
+                                "measure q[0] -> c[2];\n"
+                                "measure q[1] -> c[1];\n"
+                                "h q[2];\n";
+
+TEST(StreamingSimTest, RangeMatchesCircuitSimulation) {
+    auto                                        reference_circuit = makeCircuit();
+    std::vector<std::unique_ptr<qc::Operation>> ops{};
+    for (const auto& op: *reference_circuit) {
+        ops.push_back(op->clone());
+    }
+
+    StreamingSimulator streaming(OperationStream::fromRange(4, 4, ops.begin(), ops.end()), 1, 3);
+    streaming.Simulate(1);
+    EXPECT_EQ(streaming.getNumberOfOps(), reference_circuit->getNops());
+    EXPECT_EQ(streaming.AdditionalStatistics().at("chunks"), "5");
+
+    CircuitSimulator reference(std::move(reference_circuit), 1);
+    reference.Simulate(1);
+    expectSameState(streaming, reference);
+}
+
+TEST(StreamingSimTest, QasmMatchesParsedCircuit) {
+    for (const std::size_t chunk_size: {1U, 2U, 100U}) {
+        StreamingSimulator streaming(OperationStream::fromQasm(std::make_unique<std::istringstream>(qasm)), 1, chunk_size);
+        EXPECT_EQ(streaming.getNumberOfQubits(), 3);
+        const auto counts = streaming.Simulate(1000);
+
+        auto quantumComputation = std::make_unique<qc::QuantumComputation>();
+        quantumComputation->import(std::istringstream(qasm), qc::OpenQASM);
+        CircuitSimulator reference(std::move(quantumComputation), 1);
+        const auto       expected = reference.Simulate(1000);
+
+        ASSERT_EQ(counts.size(), expected.size());
+        for (const auto& [outcome, count]: counts) {
+            EXPECT_EQ(expected.count(outcome), 1);
+        }
+    }
+}
+
+TEST(StreamingSimTest, RejectsUnsupportedStreams) {
+    const auto simulate = [](const std::string& program) {
+        StreamingSimulator streaming(OperationStream::fromQasm(std::make_unique<std::istringstream>(program)), 1, 1);
+        streaming.Simulate(1);
+    };
+    EXPECT_THROW(simulate("OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[1];\nx q[0];\nqreg r[1];\n"), std::runtime_error);
+    EXPECT_THROW(simulate("OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[1];\ncreg c[1];\nmeasure q[0] -> c[0];\nx q[0];\n"), std::runtime_error);
+    EXPECT_THROW(simulate("OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[1];\nreset q[0];\n"), std::runtime_error);
+    EXPECT_THROW(simulate("OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[1];\nx q[0]"), std::runtime_error);
+    EXPECT_THROW(simulate("OPENQASM 2.0;\ninclude \"qelib1.inc\";\n// i 0 1\n// o 1 0\nqreg q[2];\nx q[0];\n"), std::runtime_error);
+
+    StreamingSimulator streaming(OperationStream::fromQasm(std::make_unique<std::istringstream>(qasm)), 1, 1);
+    streaming.Simulate(1);
+    EXPECT_THROW(streaming.Simulate(1), std::runtime_error);
+    EXPECT_THROW(StreamingSimulator(OperationStream::fromQasm(std::make_unique<std::istringstream>(qasm)), 1, 0), std::runtime_error);
+}
@@ -0,0 +1,24 @@
+#ifndef DDSIM_TEST_UTILS_HPP
+#define DDSIM_TEST_UTILS_HPP
+
+#include "Simulator.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+
+/// expects both state vectors to agree amplitude by amplitude
+inline void expectSameState(const std::vector<std::complex<dd::fp>>& actual, const std::vector<std::complex<dd::fp>>& expected, const dd::fp tolerance = 1e-10) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0., tolerance) << "amplitude " << i;
+    }
+}
+
+/// expects the final states of both simulators to agree amplitude by amplitude
+inline void expectSameState(const Simulator& actual, const Simulator& expected, const dd::fp tolerance = 1e-10) {
+    expectSameState(actual.getVectorComplex(), expected.getVectorComplex(), tolerance);
+}
+
+#endif //DDSIM_TEST_UTILS_HPP